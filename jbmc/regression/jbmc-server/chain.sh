@@ -0,0 +1,9 @@
+#!/bin/bash
+
+JBMC_PATH=$1
+shift
+
+# the requests file comes last, after any options for the server
+REQUESTS_FILE="${@: -1}"
+
+$JBMC_PATH --server "${@:1:$#-1}" < "$REQUESTS_FILE"
@@ -0,0 +1,10 @@
+import org.cprover.CProver;
+
+class NondetBoolean
+{
+  static void main()
+  {
+    boolean x = CProver.nondetBoolean();
+    assert x == false;
+  }
+}
@@ -0,0 +1,4 @@
+public class Holder {
+  public int read;
+  public int ignored;
+}
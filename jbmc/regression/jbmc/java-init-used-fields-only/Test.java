@@ -0,0 +1,9 @@
+public class Test {
+  public static int used(Holder holder) {
+    return 100 / (holder.read - 42);
+  }
+
+  public static int length(String s) {
+    return 100 / (s.length() - 3);
+  }
+}
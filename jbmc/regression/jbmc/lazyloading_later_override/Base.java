@@ -0,0 +1,6 @@
+public class Base {
+  public int get() {
+    Test.use(new Sub());
+    return 1;
+  }
+}
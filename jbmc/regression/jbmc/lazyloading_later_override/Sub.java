@@ -0,0 +1,5 @@
+public class Sub extends Base {
+  public int get() {
+    return 2;
+  }
+}
@@ -0,0 +1,9 @@
+public class Test {
+  public static void check() {
+    new Base().get();
+  }
+
+  public static int use(Base base) {
+    return base.get();
+  }
+}
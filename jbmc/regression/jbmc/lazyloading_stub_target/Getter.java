@@ -0,0 +1,3 @@
+public interface Getter {
+  int get();
+}
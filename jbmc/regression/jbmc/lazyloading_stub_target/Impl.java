@@ -0,0 +1,2 @@
+public class Impl extends Opaque implements Getter {
+}
@@ -0,0 +1,5 @@
+public class Opaque {
+  public int get() {
+    return 0;
+  }
+}
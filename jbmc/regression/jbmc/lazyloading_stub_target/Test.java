@@ -0,0 +1,8 @@
+public class Test {
+  public static int check(Impl impl) {
+    Getter getter = impl;
+    int x = getter.get();
+    new User().touch(impl);
+    return x;
+  }
+}
@@ -0,0 +1,5 @@
+public class User {
+  public int touch(Opaque opaque) {
+    return opaque.get();
+  }
+}
@@ -18,6 +18,9 @@ Author: Diffblue Ltd.
 
 #include <goto-programs/resolve_inherited_component.h>
 
+#include <algorithm>
+#include <chrono>
+
 /// Constructor for lazy-method loading
 /// \param symbol_table: the symbol table to use
 /// \param main_class: identifier of the entry point / main class
@@ -132,20 +135,38 @@ bool ci_lazy_methodst::operator()(
   std::unordered_set<class_method_descriptor_exprt, irep_hash>
     called_virtual_functions;
   bool class_initializer_seen = false;
+  // Number of instantiated classes when the targets of each virtual callsite
+  // were last added; as that set only grows, the targets are the same as long
+  // as its size is.  Callsites that could not be resolved to an
+  // implementation on some instantiated class have no entry, as converting
+  // further methods may add the stub they resolve to.
+  std::unordered_map<class_method_descriptor_exprt, std::size_t, irep_hash>
+    instantiated_classes_seen;
+  // Number of methods and classes in the symbol table when the targets were
+  // last added.  Converting methods may add stubs for methods of opaque
+  // classes, or stub classes, which a class may then resolve a method to
+  // rather than to the one that was recorded for it.
+  std::size_t methods_and_classes_seen = 0;
 
   messaget log{message_handler};
 
+  std::size_t round = 0;
   bool any_new_classes = true;
   while(any_new_classes)
   {
     bool any_new_methods = true;
     while(any_new_methods)
     {
+      const auto round_start = std::chrono::steady_clock::now();
+      std::size_t converted_methods = 0;
+      std::size_t updated_callsites = 0;
+
       any_new_methods = false;
       while(!methods_to_convert_later.empty())
       {
         std::unordered_set<irep_idt> methods_to_convert;
         std::swap(methods_to_convert, methods_to_convert_later);
+        converted_methods += methods_to_convert.size();
         for(const auto &mname : methods_to_convert)
         {
           const auto conversion_result = convert_and_analyze_method(
@@ -170,15 +191,49 @@ bool ci_lazy_methodst::operator()(
                   << called_virtual_functions.size() << " callsites)"
                   << messaget::eom;
 
+      const std::size_t methods_and_classes =
+        count_methods_and_classes(symbol_table);
+      if(methods_and_classes != methods_and_classes_seen)
+      {
+        resolved_methods.clear();
+        instantiated_classes_seen.clear();
+        methods_and_classes_seen = methods_and_classes;
+      }
+
       for(const class_method_descriptor_exprt &called_virtual_function :
           called_virtual_functions)
       {
-        get_virtual_method_targets(
-          called_virtual_function,
-          instantiated_classes,
-          methods_to_convert_later,
-          symbol_table);
+        const auto seen =
+          instantiated_classes_seen.find(called_virtual_function);
+        if(
+          seen != instantiated_classes_seen.end() &&
+          seen->second == instantiated_classes.size())
+        {
+          continue;
+        }
+        ++updated_callsites;
+
+        if(get_virtual_method_targets(
+             called_virtual_function,
+             instantiated_classes,
+             methods_to_convert_later,
+             symbol_table))
+        {
+          instantiated_classes_seen.erase(called_virtual_function);
+        }
+        else
+        {
+          instantiated_classes_seen[called_virtual_function] =
+            instantiated_classes.size();
+        }
       }
+
+      const std::chrono::duration<double> round_runtime =
+        std::chrono::steady_clock::now() - round_start;
+      log.statistics() << "CI lazy methods: round " << ++round << ": converted "
+                       << converted_methods << " methods, updated targets of "
+                       << updated_callsites << " callsites in "
+                       << round_runtime.count() << "s" << messaget::eom;
     }
 
     any_new_classes = handle_virtual_methods_with_no_callees(
@@ -477,7 +532,9 @@ void ci_lazy_methodst::gather_virtual_callsites(
 ///   taking `instantiated_classes` into account (virtual function overrides
 ///   defined on classes that are not 'needed' are ignored)
 /// \param symbol_table: global symbol table
-void ci_lazy_methodst::get_virtual_method_targets(
+/// \return true if the callee could not be resolved to an implementation on
+///   some instantiated class
+bool ci_lazy_methodst::get_virtual_method_targets(
   const class_method_descriptor_exprt &called_function,
   const std::unordered_set<irep_idt> &instantiated_classes,
   std::unordered_set<irep_idt> &callable_methods,
@@ -486,17 +543,21 @@ void ci_lazy_methodst::get_virtual_method_targets(
   const auto &call_class = called_function.class_id();
   const auto &method_name = called_function.mangled_method_name();
 
-  class_hierarchyt::idst self_and_child_classes =
-    class_hierarchy.get_children_trans(call_class);
-  self_and_child_classes.push_back(call_class);
-
-  for(const irep_idt &class_name : self_and_child_classes)
+  bool unresolved = false;
+  for(const irep_idt &class_name : self_and_child_classes(call_class))
   {
     const irep_idt method_id = get_virtual_method_target(
       instantiated_classes, method_name, class_name, symbol_table);
     if(!method_id.empty())
       callable_methods.insert(method_id);
+    if(
+      instantiated_classes.count(class_name) &&
+      (method_id.empty() || is_abstract_method(method_id, symbol_table)))
+    {
+      unresolved = true;
+    }
   }
+  return unresolved;
 }
 
 /// See output
@@ -552,11 +613,60 @@ irep_idt ci_lazy_methodst::get_virtual_method_target(
   if(!instantiated_classes.count(classname))
     return irep_idt();
 
+  auto &class_methods = resolved_methods[classname];
+  const auto resolved_method = class_methods.find(call_basename);
+  if(resolved_method != class_methods.end())
+    return resolved_method->second;
+
   auto resolved_call =
     get_inherited_method_implementation(call_basename, classname, symbol_table);
-
-  if(resolved_call)
-    return resolved_call->get_full_component_identifier();
-  else
+  if(!resolved_call)
     return irep_idt();
+
+  const irep_idt method_id = resolved_call->get_full_component_identifier();
+
+  // Only resolutions to implementations are recorded: converting further
+  // methods may yet add stubs for methods of opaque classes, which take
+  // precedence over abstract methods of interfaces.
+  if(!is_abstract_method(method_id, symbol_table))
+    class_methods.emplace(call_basename, method_id);
+  return method_id;
+}
+
+/// \return the number of methods and classes in \p symbol_table
+std::size_t
+ci_lazy_methodst::count_methods_and_classes(const symbol_tablet &symbol_table)
+{
+  return std::count_if(
+    symbol_table.symbols.begin(),
+    symbol_table.symbols.end(),
+    [](const symbol_tablet::symbolst::value_type &entry) {
+      return entry.second.is_type || entry.second.type.id() == ID_code;
+    });
+}
+
+/// \return true if \p method_id is an abstract method, which a class that
+///   does not implement it resolves to only for want of a better target
+bool ci_lazy_methodst::is_abstract_method(
+  const irep_idt &method_id,
+  const symbol_tablet &symbol_table)
+{
+  const symbolt *const method_symbol = symbol_table.lookup(method_id);
+  return method_symbol && method_symbol->type.get_bool(ID_C_abstract);
+}
+
+/// \param class_id: a class that a virtual method is called on
+/// \return \p class_id and its transitive children, which are computed once
+///   for each class
+const class_hierarchyt::idst &
+ci_lazy_methodst::self_and_child_classes(const irep_idt &class_id)
+{
+  auto entry = self_and_child_classes_cache.emplace(
+    class_id, class_hierarchyt::idst{});
+  if(entry.second)
+  {
+    entry.first->second = class_hierarchy.get_children_trans(class_id);
+    entry.first->second.push_back(class_id);
+  }
+  return entry.first->second;
 }
@@ -20,6 +20,7 @@ Author: Diffblue Ltd.
 
 #include <map>
 #include <functional>
+#include <unordered_map>
 
 #include <util/irep.h>
 #include <util/symbol_table.h>
@@ -124,7 +125,7 @@ private:
     const exprt &e,
     std::unordered_set<class_method_descriptor_exprt, irep_hash> &result);
 
-  void get_virtual_method_targets(
+  bool get_virtual_method_targets(
     const class_method_descriptor_exprt &called_function,
     const std::unordered_set<irep_idt> &instantiated_classes,
     std::unordered_set<irep_idt> &callable_methods,
@@ -141,11 +142,32 @@ private:
     const irep_idt &classname,
     const symbol_tablet &symbol_table);
 
+  static bool is_abstract_method(
+    const irep_idt &method_id,
+    const symbol_tablet &symbol_table);
+
+  static std::size_t
+  count_methods_and_classes(const symbol_tablet &symbol_table);
+
   static irep_idt build_virtual_method_name(
     const irep_idt &class_name,
     const irep_idt &component_method_name);
 
+  const class_hierarchyt::idst &
+  self_and_child_classes(const irep_idt &class_id);
+
   class_hierarchyt class_hierarchy;
+  /// Index of the classes a virtual call may dispatch on and the methods it
+  /// then resolves to, so that these are not recomputed in each round of
+  /// adding virtual method targets:
+  /// each called class mapped to itself and its transitive children, ...
+  std::unordered_map<irep_idt, class_hierarchyt::idst>
+    self_and_child_classes_cache;
+  /// ... and each class mapped to the implementations of method names that
+  /// have been resolved on it since methods or classes were last added to the
+  /// symbol table
+  std::unordered_map<irep_idt, std::unordered_map<irep_idt, irep_idt>>
+    resolved_methods;
   irep_idt main_class;
   std::vector<irep_idt> main_jar_classes;
   const std::vector<load_extra_methodst> &lazy_methods_extra_entry_points;
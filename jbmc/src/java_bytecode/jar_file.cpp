@@ -74,6 +74,22 @@ optionalt<std::string> jar_filet::get_entry(const std::string &name)
   }
 }
 
+optionalt<std::uint32_t> jar_filet::get_entry_crc32(const std::string &name)
+{
+  const auto entry = m_name_to_index.find(name);
+  if(entry == m_name_to_index.end())
+    return {};
+
+  try
+  {
+    return m_zip_archive.get_crc32(entry->second);
+  }
+  catch(const std::runtime_error &)
+  {
+    return {};
+  }
+}
+
 /// Wrapper for `std::isspace` from `cctype`
 /// \param ch: the character to check
 /// \return true if the parameter is considered to be a space in the current
@@ -9,6 +9,7 @@ Author: Diffblue Ltd
 #ifndef CPROVER_JAVA_BYTECODE_JAR_FILE_H
 #define CPROVER_JAVA_BYTECODE_JAR_FILE_H
 
+#include <cstdint>
 #include <unordered_map>
 #include <memory>
 #include <string>
@@ -45,6 +46,11 @@ public:
   /// \param filename: Name of the file in the archive
   optionalt<std::string> get_entry(const std::string &filename);
 
+  /// Get the CRC-32 of a file in the jar archive without extracting it.
+  /// Returns nullopt if file doesn't exist.
+  /// \param filename: Name of the file in the archive
+  optionalt<std::uint32_t> get_entry_crc32(const std::string &filename);
+
   /// Get contents of the Manifest file in the jar archive as a key-value map
   /// (both as strings)
   std::unordered_map<std::string, std::string> get_manifest();
@@ -104,6 +104,15 @@ void parse_java_language_options(const cmdlinet &cmd, optionst &options)
     options.set_option(
       "java-cp-include-files", cmd.get_value("java-cp-include-files"));
   }
+  if(cmd.isset("java-class-cache"))
+  {
+    options.set_option("java-class-cache", cmd.get_value("java-class-cache"));
+  }
+  if(cmd.isset("java-load-threads"))
+  {
+    options.set_option(
+      "java-load-threads", cmd.get_value("java-load-threads"));
+  }
   if(cmd.isset("static-values"))
   {
     options.set_option("static-values", cmd.get_value("static-values"));
@@ -225,6 +234,24 @@ java_bytecode_language_optionst::java_bytecode_language_optionst(
   else
     java_cp_include_files=".*";
 
+  if(options.is_set("java-class-cache"))
+    class_cache_directory = options.get_option("java-class-cache");
+  class_cache_in_memory = options.get_bool_option("java-class-cache-in-memory");
+  if(options.is_set("java-load-threads"))
+  {
+    class_loading_threads =
+      options.get_unsigned_int_option("java-load-threads");
+#if !IREP_THREAD_SAFE
+    if(class_loading_threads != 1)
+    {
+      log.warning() << "--java-load-threads requires building with "
+                    << "IREP_THREAD_SAFE, loading classes on a single thread"
+                    << messaget::eom;
+      class_loading_threads = 1;
+    }
+#endif
+  }
+
   nondet_static = options.get_bool_option("nondet-static");
   if(options.is_set("static-values"))
   {
@@ -305,6 +332,15 @@ void java_bytecode_languaget::initialize_class_loader()
   java_class_loader.set_java_cp_include_files(
     language_options->java_cp_include_files);
   java_class_loader.add_load_classes(language_options->java_load_classes);
+  java_class_loader.set_max_threads(language_options->class_loading_threads);
+  if(
+    language_options->class_cache_directory.has_value() ||
+    language_options->class_cache_in_memory)
+  {
+    java_class_loader.set_class_cache(java_class_cachet(
+      language_options->class_cache_directory,
+      language_options->class_cache_in_memory));
+  }
   if(language_options->string_refinement_enabled)
   {
     string_preprocess.initialize_known_type_table();
@@ -1082,6 +1118,25 @@ bool java_bytecode_languaget::generate_support_functions(
       "--context-include or --context-exclude options");
   }
 
+  java_object_factory_parameterst entry_point_parameters =
+    object_factory_parameters;
+  if(entry_point_parameters.init_used_fields_only)
+  {
+    if(
+      language_options->lazy_methods_mode == LAZY_METHODS_MODE_EXTERNAL_DRIVER)
+    {
+      // the methods to be loaded are not known yet
+      warning() << "--java-init-used-fields-only has no effect with "
+                << "--symex-driven-lazy-loading" << eom;
+    }
+    else
+    {
+      entry_point_parameters.used_fields =
+        std::make_shared<const std::unordered_set<irep_idt>>(
+          java_used_field_names(symbol_table));
+    }
+  }
+
   // generate the test harness in __CPROVER__start and a call the entry point
   return java_entry_point(
     symbol_table_builder,
@@ -1089,7 +1144,7 @@ bool java_bytecode_languaget::generate_support_functions(
     get_message_handler(),
     language_options->assume_inputs_non_null,
     language_options->assert_uncaught_exceptions,
-    object_factory_parameters,
+    entry_point_parameters,
     get_pointer_type_selector(),
     language_options->string_refinement_enabled,
     [&](const symbolt &function, symbol_table_baset &symbol_table) {
@@ -1097,7 +1152,7 @@ bool java_bytecode_languaget::generate_support_functions(
         function,
         symbol_table,
         language_options->assume_inputs_non_null,
-        object_factory_parameters,
+        entry_point_parameters,
         get_pointer_type_selector(),
         get_message_handler());
     });
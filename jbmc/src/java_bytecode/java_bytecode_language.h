@@ -37,11 +37,14 @@ Author: Daniel Kroening, kroening@kroening.com
   "(java-assume-inputs-non-null)" \
   "(java-assume-inputs-interval):" \
   "(java-assume-inputs-integral)" \
+  "(java-init-used-fields-only)" \
   "(throw-runtime-exceptions)" \
   "(max-nondet-array-length):" \
   "(max-nondet-tree-depth):" \
   "(java-max-vla-length):" \
   "(java-cp-include-files):" \
+  "(java-class-cache):" \
+  "(java-load-threads):" \
   "(ignore-manifest-main-class)" \
   "(context-include):" \
   "(context-exclude):" \
@@ -77,9 +80,18 @@ Author: Daniel Kroening, kroening@kroening.com
   " --java-assume-inputs-integral\n" \
   "                              force float and double inputs to have integer values;\n" /* NOLINT(*) */ \
   "                              does not work for arrays;\n" /* NOLINT(*) */ \
+  " --java-init-used-fields-only\n" \
+  "                              only nondet-initialize the fields of inputs\n" /* NOLINT(*) */ \
+  "                              that the loaded methods refer to; others are\n" /* NOLINT(*) */ \
+  "                              zero or null\n" \
   " --java-max-vla-length N      limit the length of user-code-created arrays\n" /* NOLINT(*) */ \
   " --java-cp-include-files r    regexp or JSON list of files to load\n" \
   "                              (with '@' prefix)\n" \
+  " --java-class-cache dir       keep the parsed classes in dir and reuse them\n" /* NOLINT(*) */ \
+  "                              in later runs\n" \
+  " --java-load-threads n        inflate and parse classes on n threads\n" \
+  "                              (0 for the number of hardware threads),\n" \
+  "                              only in builds with IREP_THREAD_SAFE\n" \
   " --ignore-manifest-main-class ignore Main-Class entries in JAR manifest files.\n" /* NOLINT(*) */ \
   "                              If this option is specified and the options\n" /* NOLINT(*) */ \
   "                              --function and --main-class are not, we can be\n" /* NOLINT(*) */ \
@@ -241,6 +253,15 @@ struct java_bytecode_language_optionst
   /// list of classes to force load even without reference from the entry point
   std::vector<irep_idt> java_load_classes;
   std::string java_cp_include_files;
+  /// Directory to cache the parse trees of classes from JAR files in, from
+  /// the --java-class-cache command-line option
+  optionalt<std::string> class_cache_directory;
+  /// Whether to keep the parse trees of classes from JAR files in memory for
+  /// later runs in the same process, set by `jbmc --server`
+  bool class_cache_in_memory = false;
+  /// Number of threads to load classes on, see
+  /// \ref java_class_loadert::set_max_threads
+  std::size_t class_loading_threads = 1;
   /// JSON which contains initial values of static fields (right
   /// after the static initializer of the class was run). This is read from the
   /// file specified by the --static-values command-line option.
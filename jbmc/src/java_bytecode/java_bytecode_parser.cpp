@@ -43,7 +43,12 @@ public:
     u2 ref2 = 0;
     irep_idt s;
     u8 number = 0;
+    /// The constant as an expression, built on first use by `constant`, as
+    /// many entries, e.g. those of methods that are not loaded, are not used
     exprt expr;
+    /// For descriptors, the type they denote, parsed on first use by
+    /// `type_entry` so that entries referring to the same descriptor share it
+    typet type;
   };
 
   java_bytecode_parse_treet parse_tree;
@@ -78,16 +83,24 @@ private:
 
   exprt &constant(u2 index)
   {
-    return pool_entry(index).expr;
+    pool_entryt &entry = pool_entry(index);
+    // all constants are converted to expressions with a non-empty id
+    if(entry.expr.id().empty())
+      convert_constant(entry);
+    return entry.expr;
   }
 
-  const typet type_entry(u2 index)
+  const typet &type_entry(u2 index)
   {
-    return *java_type_from_string(id2string(pool_entry(index).s));
+    pool_entryt &entry = pool_entry(index);
+    if(entry.type.id().empty())
+      entry.type = *java_type_from_string(id2string(entry.s));
+    return entry.type;
   }
 
   void rClassFile();
   void rconstant_pool();
+  void convert_constant(pool_entryt &entry);
   void rinterfaces();
   void rfields();
   void rmethods();
@@ -493,17 +506,16 @@ void java_bytecode_parsert::rClassFile()
 /// Get the class references for the benefit of a dependency analysis.
 void java_bytecode_parsert::get_class_refs()
 {
-  for(const auto &c : constant_pool)
+  for(u2 index = 1; index < constant_pool.size(); ++index)
   {
-    switch(c.tag)
+    switch(constant_pool[index].tag)
     {
     case CONSTANT_Class:
-      get_class_refs_rec(c.expr.type());
+      get_class_refs_rec(constant(index).type());
       break;
 
     case CONSTANT_NameAndType:
-      get_class_refs_rec(
-        *java_type_from_string(id2string(pool_entry(c.ref2).s)));
+      get_class_refs_rec(type_entry(constant_pool[index].ref2));
       break;
 
     default: {}
@@ -714,119 +726,117 @@ void java_bytecode_parsert::rconstant_pool()
       throw 0;
     }
   }
+}
 
-  // we do a bit of post-processing after we have them all
-  std::for_each(
-    std::next(constant_pool.begin()),
-    constant_pool.end(),
-    [&](constant_poolt::value_type &entry) {
-      switch(entry.tag)
-      {
-      case CONSTANT_Class:
-      {
-        const std::string &s = id2string(pool_entry(entry.ref1).s);
-        entry.expr = type_exprt(java_classname(s));
-      }
-      break;
+/// Convert the constant pool entry \p entry to an expression
+void java_bytecode_parsert::convert_constant(pool_entryt &entry)
+{
+  switch(entry.tag)
+  {
+  case CONSTANT_Class:
+  {
+    const std::string &s = id2string(pool_entry(entry.ref1).s);
+    entry.expr = type_exprt(java_classname(s));
+  }
+  break;
 
-      case CONSTANT_Fieldref:
-      {
-        const pool_entryt &nameandtype_entry = pool_entry(entry.ref2);
-        const pool_entryt &name_entry=pool_entry(nameandtype_entry.ref1);
-        const pool_entryt &class_entry = pool_entry(entry.ref1);
-        const pool_entryt &class_name_entry=pool_entry(class_entry.ref1);
-        typet type=type_entry(nameandtype_entry.ref2);
+  case CONSTANT_Fieldref:
+  {
+    const pool_entryt &nameandtype_entry = pool_entry(entry.ref2);
+    const pool_entryt &name_entry=pool_entry(nameandtype_entry.ref1);
+    const pool_entryt &class_entry = pool_entry(entry.ref1);
+    const pool_entryt &class_name_entry=pool_entry(class_entry.ref1);
+    typet type=type_entry(nameandtype_entry.ref2);
 
-        auto class_tag = java_classname(id2string(class_name_entry.s));
+    auto class_tag = java_classname(id2string(class_name_entry.s));
 
-        fieldref_exprt fieldref(type, name_entry.s, class_tag.get_identifier());
+    fieldref_exprt fieldref(type, name_entry.s, class_tag.get_identifier());
 
-        entry.expr = fieldref;
-      }
-      break;
+    entry.expr = fieldref;
+  }
+  break;
 
-      case CONSTANT_Methodref:
-      case CONSTANT_InterfaceMethodref:
-      {
-        const pool_entryt &nameandtype_entry = pool_entry(entry.ref2);
-        const pool_entryt &name_entry=pool_entry(nameandtype_entry.ref1);
-        const pool_entryt &class_entry = pool_entry(entry.ref1);
-        const pool_entryt &class_name_entry=pool_entry(class_entry.ref1);
-        typet type=type_entry(nameandtype_entry.ref2);
+  case CONSTANT_Methodref:
+  case CONSTANT_InterfaceMethodref:
+  {
+    const pool_entryt &nameandtype_entry = pool_entry(entry.ref2);
+    const pool_entryt &name_entry=pool_entry(nameandtype_entry.ref1);
+    const pool_entryt &class_entry = pool_entry(entry.ref1);
+    const pool_entryt &class_name_entry=pool_entry(class_entry.ref1);
+    typet type=type_entry(nameandtype_entry.ref2);
 
-        auto class_tag = java_classname(id2string(class_name_entry.s));
+    auto class_tag = java_classname(id2string(class_name_entry.s));
 
-        irep_idt mangled_method_name =
-          id2string(name_entry.s) + ":" +
-          id2string(pool_entry(nameandtype_entry.ref2).s);
+    irep_idt mangled_method_name =
+      id2string(name_entry.s) + ":" +
+      id2string(pool_entry(nameandtype_entry.ref2).s);
 
-        irep_idt class_id = class_tag.get_identifier();
+    irep_idt class_id = class_tag.get_identifier();
 
-        entry.expr = class_method_descriptor_exprt{
-          type, mangled_method_name, class_id, name_entry.s};
-      }
-      break;
+    entry.expr = class_method_descriptor_exprt{
+      type, mangled_method_name, class_id, name_entry.s};
+  }
+  break;
 
-      case CONSTANT_String:
-      {
-        // ldc turns these into references to java.lang.String
-        entry.expr = java_string_literal_exprt{pool_entry(entry.ref1).s};
-      }
-      break;
+  case CONSTANT_String:
+  {
+    // ldc turns these into references to java.lang.String
+    entry.expr = java_string_literal_exprt{pool_entry(entry.ref1).s};
+  }
+  break;
 
-      case CONSTANT_Integer:
-        entry.expr = from_integer(entry.number, java_int_type());
-        break;
+  case CONSTANT_Integer:
+    entry.expr = from_integer(entry.number, java_int_type());
+    break;
 
-      case CONSTANT_Float:
-      {
-        ieee_floatt value(ieee_float_spect::single_precision());
-        value.unpack(entry.number);
-        entry.expr = value.to_expr();
-      }
-      break;
+  case CONSTANT_Float:
+  {
+    ieee_floatt value(ieee_float_spect::single_precision());
+    value.unpack(entry.number);
+    entry.expr = value.to_expr();
+  }
+  break;
 
-      case CONSTANT_Long:
-        entry.expr = from_integer(entry.number, java_long_type());
-        break;
+  case CONSTANT_Long:
+    entry.expr = from_integer(entry.number, java_long_type());
+    break;
 
-      case CONSTANT_Double:
-      {
-        ieee_floatt value(ieee_float_spect::double_precision());
-        value.unpack(entry.number);
-        entry.expr = value.to_expr();
-      }
-      break;
+  case CONSTANT_Double:
+  {
+    ieee_floatt value(ieee_float_spect::double_precision());
+    value.unpack(entry.number);
+    entry.expr = value.to_expr();
+  }
+  break;
 
-      case CONSTANT_NameAndType:
-      {
-        entry.expr.id("nameandtype");
-      }
-      break;
+  case CONSTANT_NameAndType:
+  {
+    entry.expr.id("nameandtype");
+  }
+  break;
 
-      case CONSTANT_MethodHandle:
-      {
-        entry.expr.id("methodhandle");
-      }
-      break;
+  case CONSTANT_MethodHandle:
+  {
+    entry.expr.id("methodhandle");
+  }
+  break;
 
-      case CONSTANT_MethodType:
-      {
-        entry.expr.id("methodtype");
-      }
-      break;
+  case CONSTANT_MethodType:
+  {
+    entry.expr.id("methodtype");
+  }
+  break;
 
-      case CONSTANT_InvokeDynamic:
-      {
-        entry.expr.id("invokedynamic");
-        const pool_entryt &nameandtype_entry = pool_entry(entry.ref2);
-        typet type=type_entry(nameandtype_entry.ref2);
-        type.set(ID_java_lambda_method_handle_index, entry.ref1);
-        entry.expr.type() = type;
-      }
-      break;
-      }
-    });
+  case CONSTANT_InvokeDynamic:
+  {
+    entry.expr.id("invokedynamic");
+    const pool_entryt &nameandtype_entry = pool_entry(entry.ref2);
+    typet type=type_entry(nameandtype_entry.ref2);
+    type.set(ID_java_lambda_method_handle_index, entry.ref1);
+    entry.expr.type() = type;
+  }
+  break;
+  }
 }
 
 void java_bytecode_parsert::rinterfaces()
@@ -1190,7 +1200,7 @@ void java_bytecode_parsert::rmethod_attribute(methodt &method)
         method.exception_table[e].handler_pc = handler_pc;
         if(catch_type != 0)
           method.exception_table[e].catch_type =
-            to_struct_tag_type(pool_entry(catch_type).expr.type());
+            to_struct_tag_type(constant(catch_type).type());
       }
     }
 
@@ -0,0 +1,606 @@
+/*******************************************************************\
+
+Module: Persistent Cache of Java Class Parse Trees
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Persistent cache of the parse trees of classes loaded from JAR files and
+/// directories
+
+#include "java_class_cache.h"
+
+#include <util/exception_utils.h>
+#include <util/file_util.h>
+#include <util/invariant.h>
+#include <util/irep_serialization.h>
+
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+
+/// Written at the start of each cache file, to be increased whenever
+/// \ref java_bytecode_parse_treet or its encoding below changes
+static const char *const cache_format = "JBMC-CLASS-CACHE 1";
+
+typedef java_bytecode_parse_treet::annotationt annotationt;
+typedef java_bytecode_parse_treet::annotationst annotationst;
+typedef java_bytecode_parse_treet::membert membert;
+typedef java_bytecode_parse_treet::methodt methodt;
+typedef java_bytecode_parse_treet::fieldt fieldt;
+typedef java_bytecode_parse_treet::classt classt;
+typedef methodt::verification_type_infot verification_type_infot;
+typedef methodt::stack_map_table_entryt stack_map_table_entryt;
+
+// The parse tree is stored as a single irept, which irep_serializationt then
+// writes with sharing.
+
+static void
+set_optional(irept &irep, const irep_idt &name, const optionalt<std::string> &s)
+{
+  if(s.has_value())
+    irep.set(name, irep_idt(*s));
+}
+
+static optionalt<std::string>
+get_optional(const irept &irep, const irep_idt &name)
+{
+  const irept &value = irep.find(name);
+  if(value.is_nil())
+    return {};
+  return id2string(value.id());
+}
+
+template <typename containert>
+static irept ids_to_irep(const containert &ids)
+{
+  irept result;
+  for(const irep_idt &id : ids)
+    result.get_sub().emplace_back(id);
+  return result;
+}
+
+static irept annotations_to_irep(const annotationst &annotations)
+{
+  irept result;
+  for(const auto &annotation : annotations)
+  {
+    irept a;
+    a.set(ID_type, annotation.type);
+    irept &pairs = a.add("element_value_pairs");
+    for(const auto &pair : annotation.element_value_pairs)
+    {
+      irept p(pair.element_name);
+      p.set(ID_value, pair.value);
+      pairs.get_sub().push_back(std::move(p));
+    }
+    result.get_sub().push_back(std::move(a));
+  }
+  return result;
+}
+
+static annotationst annotations_from_irep(const irept &irep)
+{
+  annotationst annotations;
+  for(const auto &a : irep.get_sub())
+  {
+    annotationt annotation;
+    annotation.type = static_cast<const typet &>(a.find(ID_type));
+    for(const auto &p : a.find("element_value_pairs").get_sub())
+    {
+      annotation.element_value_pairs.push_back(
+        {p.id(), static_cast<const exprt &>(p.find(ID_value))});
+    }
+    annotations.push_back(std::move(annotation));
+  }
+  return annotations;
+}
+
+static void member_to_irep(const membert &member, irept &irep)
+{
+  irep.set("descriptor", irep_idt(member.descriptor));
+  set_optional(irep, "signature", member.signature);
+  irep.set(ID_name, member.name);
+  irep.set(ID_public, member.is_public);
+  irep.set(ID_protected, member.is_protected);
+  irep.set(ID_private, member.is_private);
+  irep.set(ID_static, member.is_static);
+  irep.set(ID_final, member.is_final);
+  irep.set("annotations", annotations_to_irep(member.annotations));
+}
+
+static void member_from_irep(const irept &irep, membert &member)
+{
+  member.descriptor = irep.get_string("descriptor");
+  member.signature = get_optional(irep, "signature");
+  member.name = irep.get(ID_name);
+  member.is_public = irep.get_bool(ID_public);
+  member.is_protected = irep.get_bool(ID_protected);
+  member.is_private = irep.get_bool(ID_private);
+  member.is_static = irep.get_bool(ID_static);
+  member.is_final = irep.get_bool(ID_final);
+  member.annotations = annotations_from_irep(irep.find("annotations"));
+}
+
+static irept verification_types_to_irep(
+  const std::vector<verification_type_infot> &verification_types)
+{
+  irept result;
+  for(const auto &v : verification_types)
+  {
+    irept i;
+    i.set(ID_type, v.type);
+    i.set("tag", v.tag);
+    i.set("cpool_index", v.cpool_index);
+    i.set("offset", v.offset);
+    result.get_sub().push_back(std::move(i));
+  }
+  return result;
+}
+
+static std::vector<verification_type_infot>
+verification_types_from_irep(const irept &irep)
+{
+  std::vector<verification_type_infot> result;
+  for(const auto &i : irep.get_sub())
+  {
+    verification_type_infot v;
+    v.type = static_cast<verification_type_infot::verification_type_info_type>(
+      i.get_long_long(ID_type));
+    v.tag = static_cast<u1>(i.get_size_t("tag"));
+    v.cpool_index = static_cast<u2>(i.get_size_t("cpool_index"));
+    v.offset = static_cast<u2>(i.get_size_t("offset"));
+    result.push_back(v);
+  }
+  return result;
+}
+
+static irept method_to_irep(const methodt &method)
+{
+  irept result;
+  member_to_irep(method, result);
+  result.set(ID_base_name, method.base_name);
+  result.set("native", method.is_native);
+  result.set(ID_abstract, method.is_abstract);
+  result.set("synchronized", method.is_synchronized);
+  result.set("bridge", method.is_bridge);
+  result.set("varargs", method.is_varargs);
+  result.set("synthetic", method.is_synthetic);
+  result.set(ID_C_source_location, method.source_location);
+
+  irept &instructions = result.add("instructions");
+  for(const auto &instruction : method.instructions)
+  {
+    irept i;
+    i.set(ID_C_source_location, instruction.source_location);
+    i.set("address", instruction.address);
+    i.set("bytecode", instruction.bytecode);
+    irept &args = i.add(ID_arguments);
+    for(const auto &arg : instruction.args)
+      args.get_sub().push_back(arg);
+    instructions.get_sub().push_back(std::move(i));
+  }
+
+  irept &parameter_annotations = result.add("parameter_annotations");
+  for(const auto &annotations : method.parameter_annotations)
+    parameter_annotations.get_sub().push_back(annotations_to_irep(annotations));
+
+  irept &exception_table = result.add("exception_table");
+  for(const auto &entry : method.exception_table)
+  {
+    irept e;
+    e.set("start_pc", entry.start_pc);
+    e.set("end_pc", entry.end_pc);
+    e.set("handler_pc", entry.handler_pc);
+    e.set("catch_type", entry.catch_type);
+    exception_table.get_sub().push_back(std::move(e));
+  }
+
+  result.set(
+    "throws_exception_table", ids_to_irep(method.throws_exception_table));
+
+  irept &local_variable_table = result.add("local_variable_table");
+  for(const auto &variable : method.local_variable_table)
+  {
+    irept v;
+    v.set(ID_name, variable.name);
+    v.set("descriptor", irep_idt(variable.descriptor));
+    set_optional(v, "signature", variable.signature);
+    v.set(ID_index, variable.index);
+    v.set("start_pc", variable.start_pc);
+    v.set("length", variable.length);
+    local_variable_table.get_sub().push_back(std::move(v));
+  }
+
+  irept &stack_map_table = result.add("stack_map_table");
+  for(const auto &entry : method.stack_map_table)
+  {
+    irept e;
+    e.set(ID_type, entry.type);
+    e.set("offset_delta", entry.offset_delta);
+    e.set("chops", entry.chops);
+    e.set("appends", entry.appends);
+    e.set("locals", verification_types_to_irep(entry.locals));
+    e.set("stack", verification_types_to_irep(entry.stack));
+    stack_map_table.get_sub().push_back(std::move(e));
+  }
+
+  return result;
+}
+
+static void method_from_irep(const irept &irep, methodt &method)
+{
+  member_from_irep(irep, method);
+  method.base_name = irep.get(ID_base_name);
+  method.is_native = irep.get_bool("native");
+  method.is_abstract = irep.get_bool(ID_abstract);
+  method.is_synchronized = irep.get_bool("synchronized");
+  method.is_bridge = irep.get_bool("bridge");
+  method.is_varargs = irep.get_bool("varargs");
+  method.is_synthetic = irep.get_bool("synthetic");
+  method.source_location =
+    static_cast<const source_locationt &>(irep.find(ID_C_source_location));
+
+  for(const auto &i : irep.find("instructions").get_sub())
+  {
+    auto &instruction = method.add_instruction();
+    instruction.source_location =
+      static_cast<const source_locationt &>(i.find(ID_C_source_location));
+    instruction.address = static_cast<unsigned>(i.get_size_t("address"));
+    instruction.bytecode = static_cast<u8>(i.get_size_t("bytecode"));
+    for(const auto &arg : i.find(ID_arguments).get_sub())
+      instruction.args.push_back(static_cast<const exprt &>(arg));
+  }
+
+  for(const auto &annotations : irep.find("parameter_annotations").get_sub())
+    method.parameter_annotations.push_back(annotations_from_irep(annotations));
+
+  for(const auto &e : irep.find("exception_table").get_sub())
+  {
+    methodt::exceptiont entry;
+    entry.start_pc = e.get_size_t("start_pc");
+    entry.end_pc = e.get_size_t("end_pc");
+    entry.handler_pc = e.get_size_t("handler_pc");
+    entry.catch_type =
+      static_cast<const struct_tag_typet &>(e.find("catch_type"));
+    method.exception_table.push_back(entry);
+  }
+
+  for(const auto &id : irep.find("throws_exception_table").get_sub())
+    method.throws_exception_table.push_back(id.id());
+
+  for(const auto &v : irep.find("local_variable_table").get_sub())
+  {
+    methodt::local_variablet variable;
+    variable.name = v.get(ID_name);
+    variable.descriptor = v.get_string("descriptor");
+    variable.signature = get_optional(v, "signature");
+    variable.index = v.get_size_t(ID_index);
+    variable.start_pc = v.get_size_t("start_pc");
+    variable.length = v.get_size_t("length");
+    method.local_variable_table.push_back(std::move(variable));
+  }
+
+  for(const auto &e : irep.find("stack_map_table").get_sub())
+  {
+    stack_map_table_entryt entry;
+    entry.type = static_cast<stack_map_table_entryt::stack_frame_type>(
+      e.get_long_long(ID_type));
+    entry.offset_delta = e.get_size_t("offset_delta");
+    entry.chops = e.get_size_t("chops");
+    entry.appends = e.get_size_t("appends");
+    entry.locals = verification_types_from_irep(e.find("locals"));
+    entry.stack = verification_types_from_irep(e.find("stack"));
+    method.stack_map_table.push_back(std::move(entry));
+  }
+}
+
+static irept class_to_irep(const classt &parsed_class)
+{
+  irept result;
+  result.set(ID_name, parsed_class.name);
+  result.set("super_class", parsed_class.super_class);
+  result.set("inner_name", parsed_class.inner_name);
+  result.set(ID_abstract, parsed_class.is_abstract);
+  result.set("enum", parsed_class.is_enum);
+  result.set(ID_public, parsed_class.is_public);
+  result.set(ID_protected, parsed_class.is_protected);
+  result.set(ID_private, parsed_class.is_private);
+  result.set(ID_final, parsed_class.is_final);
+  result.set(ID_interface, parsed_class.is_interface);
+  result.set("synthetic", parsed_class.is_synthetic);
+  result.set("annotation", parsed_class.is_annotation);
+  result.set("inner_class", parsed_class.is_inner_class);
+  result.set("static_class", parsed_class.is_static_class);
+  result.set("anonymous_class", parsed_class.is_anonymous_class);
+  result.set(
+    "bootstrapmethods_read", parsed_class.attribute_bootstrapmethods_read);
+  result.set("outer_class", parsed_class.outer_class);
+  result.set("enum_elements", parsed_class.enum_elements);
+
+  irept &method_handles = result.add("method_handles");
+  for(const auto &entry : parsed_class.lambda_method_handle_map)
+  {
+    irept h(entry.first.first);
+    h.set(ID_index, entry.first.second);
+    h.set("kind", static_cast<long long>(entry.second.handle_type));
+    if(entry.second.method_descriptor.has_value())
+      h.set("method_descriptor", *entry.second.method_descriptor);
+    method_handles.get_sub().push_back(std::move(h));
+  }
+
+  result.set("implements", ids_to_irep(parsed_class.implements));
+  set_optional(result, "signature", parsed_class.signature);
+
+  irept &fields = result.add("fields");
+  for(const auto &field : parsed_class.fields)
+  {
+    irept f;
+    member_to_irep(field, f);
+    f.set("enum", field.is_enum);
+    fields.get_sub().push_back(std::move(f));
+  }
+
+  irept &methods = result.add("methods");
+  for(const auto &method : parsed_class.methods)
+    methods.get_sub().push_back(method_to_irep(method));
+
+  result.set("annotations", annotations_to_irep(parsed_class.annotations));
+
+  return result;
+}
+
+static void class_from_irep(const irept &irep, classt &parsed_class)
+{
+  parsed_class.name = irep.get(ID_name);
+  parsed_class.super_class = irep.get("super_class");
+  parsed_class.inner_name = irep.get("inner_name");
+  parsed_class.is_abstract = irep.get_bool(ID_abstract);
+  parsed_class.is_enum = irep.get_bool("enum");
+  parsed_class.is_public = irep.get_bool(ID_public);
+  parsed_class.is_protected = irep.get_bool(ID_protected);
+  parsed_class.is_private = irep.get_bool(ID_private);
+  parsed_class.is_final = irep.get_bool(ID_final);
+  parsed_class.is_interface = irep.get_bool(ID_interface);
+  parsed_class.is_synthetic = irep.get_bool("synthetic");
+  parsed_class.is_annotation = irep.get_bool("annotation");
+  parsed_class.is_inner_class = irep.get_bool("inner_class");
+  parsed_class.is_static_class = irep.get_bool("static_class");
+  parsed_class.is_anonymous_class = irep.get_bool("anonymous_class");
+  parsed_class.attribute_bootstrapmethods_read =
+    irep.get_bool("bootstrapmethods_read");
+  parsed_class.outer_class = irep.get("outer_class");
+  parsed_class.enum_elements = irep.get_size_t("enum_elements");
+
+  for(const auto &h : irep.find("method_handles").get_sub())
+  {
+    classt::lambda_method_handlet handle;
+    handle.handle_type = static_cast<java_class_typet::method_handle_kindt>(
+      h.get_long_long("kind"));
+    const irept &method_descriptor = h.find("method_descriptor");
+    if(method_descriptor.is_not_nil())
+    {
+      handle.method_descriptor =
+        static_cast<const class_method_descriptor_exprt &>(method_descriptor);
+    }
+    parsed_class.lambda_method_handle_map.emplace(
+      std::make_pair(h.id(), h.get_size_t(ID_index)), handle);
+  }
+
+  for(const auto &id : irep.find("implements").get_sub())
+    parsed_class.implements.push_back(id.id());
+  parsed_class.signature = get_optional(irep, "signature");
+
+  for(const auto &f : irep.find("fields").get_sub())
+  {
+    fieldt &field = parsed_class.add_field();
+    member_from_irep(f, field);
+    field.is_enum = f.get_bool("enum");
+  }
+
+  for(const auto &m : irep.find("methods").get_sub())
+    method_from_irep(m, parsed_class.add_method());
+
+  parsed_class.annotations = annotations_from_irep(irep.find("annotations"));
+}
+
+static irept parse_tree_to_irep(const java_bytecode_parse_treet &parse_tree)
+{
+  irept irep;
+  irep.set(ID_class, class_to_irep(parse_tree.parsed_class));
+  irep.set("class_refs", ids_to_irep(parse_tree.class_refs));
+  return irep;
+}
+
+static java_bytecode_parse_treet parse_tree_from_irep(const irept &irep)
+{
+  java_bytecode_parse_treet parse_tree;
+  class_from_irep(irep.find(ID_class), parse_tree.parsed_class);
+  for(const auto &id : irep.find("class_refs").get_sub())
+    parse_tree.class_refs.insert(id.id());
+  parse_tree.loading_successful = true;
+  return parse_tree;
+}
+
+/// The parse trees kept in memory by all caches of this process, by
+/// \ref java_class_cachet::key
+static std::unordered_map<std::string, irept> &memory_store()
+{
+  static std::unordered_map<std::string, irept> store;
+  return store;
+}
+
+/// Guards \ref memory_store, as classes may be loaded by several threads
+static std::mutex memory_store_mutex;
+
+/// The number of parse trees \ref memory_store holds at most
+static const std::size_t max_memory_store_size = 1 << 16;
+
+/// Keep \p irep in \ref memory_store under \p key, dropping an arbitrary
+/// other parse tree when the store is full: a changed JAR file gets new
+/// keys, so a long-running server would otherwise keep the parse trees of
+/// every version of every class it has loaded.
+static void remember(const std::string &key, const irept &irep)
+{
+  std::lock_guard<std::mutex> lock(memory_store_mutex);
+  auto &store = memory_store();
+  if(store.size() >= max_memory_store_size && store.find(key) == store.end())
+    store.erase(store.begin());
+  store[key] = irep;
+}
+
+java_class_cachet::java_class_cachet(
+  optionalt<std::string> _directory,
+  bool _in_memory)
+  : directory(std::move(_directory)), in_memory(_in_memory)
+{
+  PRECONDITION(directory.has_value() || in_memory);
+
+  if(directory.has_value() && !is_directory(*directory))
+    create_directory(*directory);
+}
+
+std::string java_class_cachet::key(
+  const std::string &jar_path,
+  const std::string &entry_name,
+  std::uint32_t crc)
+{
+  return jar_path + '\0' + entry_name + '\0' + std::to_string(crc);
+}
+
+std::string java_class_cachet::file_name(
+  const std::string &jar_path,
+  const std::string &entry_name,
+  std::uint32_t crc) const
+{
+  // FNV-1a, as std::hash may differ between builds sharing the cache
+  std::uint64_t hash = 14695981039346656037ull;
+  for(const std::string &s : {jar_path, std::string(1, '\0'), entry_name})
+  {
+    for(const char c : s)
+    {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ull;
+    }
+  }
+
+  std::ostringstream name;
+  name << std::hex << std::setfill('0') << std::setw(16) << hash << '-'
+       << std::setw(8) << crc << ".jpt";
+  return concat_dir_file(*directory, name.str());
+}
+
+optionalt<java_bytecode_parse_treet> java_class_cachet::lookup(
+  const std::string &jar_path,
+  const std::string &entry_name,
+  std::uint32_t crc) const
+{
+  if(in_memory)
+  {
+    optionalt<irept> irep;
+    {
+      std::lock_guard<std::mutex> lock(memory_store_mutex);
+      const auto entry = memory_store().find(key(jar_path, entry_name, crc));
+      if(entry != memory_store().end())
+        irep = entry->second;
+    }
+    if(irep.has_value())
+      return parse_tree_from_irep(*irep);
+  }
+
+  if(!directory.has_value())
+    return {};
+
+  std::ifstream in(file_name(jar_path, entry_name, crc), std::ios::binary);
+  if(!in)
+    return {};
+
+  try
+  {
+    irep_serializationt::ireps_containert ireps_container;
+    irep_serializationt irep_serialization(ireps_container);
+
+    // the key is stored as well, as file names are only a hash of it
+    if(
+      irep_serialization.read_gb_string(in) != cache_format ||
+      irep_serialization.read_gb_string(in) != jar_path ||
+      irep_serialization.read_gb_string(in) != entry_name ||
+      irep_serialization.read_gb_word(in) != crc)
+    {
+      return {};
+    }
+
+    const irept &irep = irep_serialization.reference_convert(in);
+    if(!in)
+      return {};
+
+    if(in_memory)
+      remember(key(jar_path, entry_name, crc), irep);
+
+    return parse_tree_from_irep(irep);
+  }
+  catch(const deserialization_exceptiont &)
+  {
+    return {};
+  }
+}
+
+bool java_class_cachet::store(
+  const std::string &jar_path,
+  const std::string &entry_name,
+  std::uint32_t crc,
+  const java_bytecode_parse_treet &parse_tree) const
+{
+  PRECONDITION(parse_tree.loading_successful);
+
+  const irept irep = parse_tree_to_irep(parse_tree);
+
+  if(in_memory)
+    remember(key(jar_path, entry_name, crc), irep);
+
+  if(!directory.has_value())
+    return false;
+
+  const std::string cache_file = file_name(jar_path, entry_name, crc);
+  const std::string temporary_file =
+    cache_file + "." + std::to_string(std::random_device()()) + ".tmp";
+
+  {
+    std::ofstream out(temporary_file, std::ios::binary);
+    if(!out)
+      return true;
+
+    irep_serializationt::ireps_containert ireps_container;
+    irep_serializationt irep_serialization(ireps_container);
+
+    write_gb_string(out, cache_format);
+    write_gb_string(out, jar_path);
+    write_gb_string(out, entry_name);
+    write_gb_word(out, crc);
+    irep_serialization.reference_convert(irep, out);
+
+    if(!out)
+    {
+      out.close();
+      file_remove(temporary_file);
+      return true;
+    }
+  }
+
+  try
+  {
+    file_rename(temporary_file, cache_file);
+  }
+  catch(const system_exceptiont &)
+  {
+    file_remove(temporary_file);
+    return true;
+  }
+
+  return false;
+}
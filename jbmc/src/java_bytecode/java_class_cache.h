@@ -0,0 +1,84 @@
+/*******************************************************************\
+
+Module: Persistent Cache of Java Class Parse Trees
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Persistent cache of the parse trees of classes loaded from JAR files and
+/// directories
+
+#ifndef CPROVER_JAVA_BYTECODE_JAVA_CLASS_CACHE_H
+#define CPROVER_JAVA_BYTECODE_JAVA_CLASS_CACHE_H
+
+#include <util/optional.h>
+
+#include "java_bytecode_parse_tree.h"
+
+#include <cstdint>
+#include <string>
+
+/// A directory of parse trees of classes from JAR files and directories, so
+/// that runs that load the same classes, e.g. those of the Java models
+/// library, do not need to inflate and parse them again.
+///
+/// Each parse tree is stored in a file of its own, keyed by the path of the
+/// JAR file, the name of the entry in it and the CRC-32 of the entry as
+/// recorded in the JAR's central directory.  Classes from directories are
+/// keyed the same way, by the directory, the class file in it and the CRC-32
+/// of its contents.  A changed JAR or class file therefore gets new cache
+/// entries rather than stale parse trees.  Files are written
+/// to a temporary name first and then renamed, so concurrent runs may share
+/// a cache directory.
+///
+/// Parse trees can also be kept in memory, in a store shared by all caches of
+/// the process that do so.  This keeps them across the runs of a process that
+/// answers many verification requests, see `jbmc --server`, where restoring
+/// the shared irept is much cheaper than inflating and parsing the class.
+/// The store holds at most 65536 parse trees; beyond that, storing a parse
+/// tree drops an arbitrary other one, which is then loaded from the JAR or
+/// class file (or the cache directory) again when needed.
+class java_class_cachet
+{
+public:
+  /// \param directory: the directory the parse trees are stored in, which is
+  ///   created if it does not exist, or an empty optional to not store them
+  ///   in files
+  /// \param in_memory: whether to also keep the parse trees in memory
+  java_class_cachet(optionalt<std::string> directory, bool in_memory);
+
+  /// \return the parse tree stored for \p entry_name of \p jar_path with
+  ///   CRC-32 \p crc, or an empty optional if there is none or it cannot be
+  ///   read
+  optionalt<java_bytecode_parse_treet> lookup(
+    const std::string &jar_path,
+    const std::string &entry_name,
+    std::uint32_t crc) const;
+
+  /// Store the successfully loaded \p parse_tree of \p entry_name of
+  /// \p jar_path with CRC-32 \p crc
+  /// \return true if the cache entry could not be written
+  bool store(
+    const std::string &jar_path,
+    const std::string &entry_name,
+    std::uint32_t crc,
+    const java_bytecode_parse_treet &parse_tree) const;
+
+protected:
+  optionalt<std::string> directory;
+  bool in_memory;
+
+  static std::string key(
+    const std::string &jar_path,
+    const std::string &entry_name,
+    std::uint32_t crc);
+
+  std::string file_name(
+    const std::string &jar_path,
+    const std::string &entry_name,
+    std::uint32_t crc) const;
+};
+
+#endif // CPROVER_JAVA_BYTECODE_JAVA_CLASS_CACHE_H
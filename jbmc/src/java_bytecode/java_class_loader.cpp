@@ -8,8 +8,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "java_class_loader.h"
 
+#include <algorithm>
+#include <atomic>
 #include <stack>
 #include <fstream>
+#include <thread>
 
 #include <util/suffix.h>
 #include <util/prefix.h>
@@ -29,25 +32,37 @@ operator()(const irep_idt &class_name, message_handlert &message_handler)
   log.debug() << messaget::eom;
 
   std::stack<irep_idt> queue;
+  // classes queued since classes were last loaded ahead of their turn
+  std::vector<irep_idt> discovered;
+  auto push = [&queue, &discovered](const irep_idt &id) {
+    queue.push(id);
+    discovered.push_back(id);
+  };
+
   // Always require java.lang.Object, as it is the base of
   // internal classes such as array types.
-  queue.push("java.lang.Object");
+  push("java.lang.Object");
   // java.lang.String
-  queue.push("java.lang.String");
+  push("java.lang.String");
   // add java.lang.Class
-  queue.push("java.lang.Class");
+  push("java.lang.Class");
   // Require java.lang.Throwable as the catch-type used for
   // universal exception handlers:
-  queue.push("java.lang.Throwable");
-  queue.push(class_name);
+  push("java.lang.Throwable");
+  push(class_name);
 
   // Require user provided classes to be loaded even without explicit reference
   for(const auto &id : java_load_classes)
-    queue.push(id);
+    push(id);
 
   java_class_loader_limitt class_loader_limit(
     message_handler, java_cp_include_files);
 
+  // the JAR files opened by each thread that loads classes ahead of their
+  // turn, kept until all classes are loaded as jar_filet is not safe for
+  // concurrent use
+  std::vector<jar_poolt> worker_jars(load_ahead_threads());
+
   while(!queue.empty())
   {
     irep_idt c=queue.top();
@@ -56,6 +71,12 @@ operator()(const irep_idt &class_name, message_handlert &message_handler)
     if(class_map.count(c) != 0)
       continue;
 
+    if(worker_jars.size() > 1 && loaded_ahead.count(c) == 0)
+    {
+      load_ahead(class_loader_limit, discovered, worker_jars);
+      discovered.clear();
+    }
+
     log.debug() << "Reading class " << c << messaget::eom;
 
     parse_tree_with_overlayst &parse_trees =
@@ -64,19 +85,145 @@ operator()(const irep_idt &class_name, message_handlert &message_handler)
     // Add any dependencies to queue
     for(const java_bytecode_parse_treet &parse_tree : parse_trees)
       for(const irep_idt &class_ref : parse_tree.class_refs)
-        queue.push(class_ref);
+        push(class_ref);
 
     // Add any extra dependencies provided by our caller:
     if(get_extra_class_refs)
     {
       for(const irep_idt &id : get_extra_class_refs(c))
-        queue.push(id);
+        push(id);
     }
   }
 
+  loaded_ahead.clear();
+
   return class_map.at(class_name);
 }
 
+/// Records the messages of loading a class ahead of its turn, to be printed
+/// when it has its turn
+class message_buffert : public message_handlert
+{
+public:
+  explicit message_buffert(
+    std::vector<std::pair<unsigned, std::string>> &_messages)
+    : messages(_messages)
+  {
+  }
+
+  void print(unsigned level, const std::string &message) override
+  {
+    message_handlert::print(level, message);
+    messages.emplace_back(level, message);
+  }
+
+  void print(unsigned, const xmlt &) override
+  {
+  }
+
+  void print(unsigned, const jsont &) override
+  {
+  }
+
+  void flush(unsigned) override
+  {
+  }
+
+protected:
+  std::vector<std::pair<unsigned, std::string>> &messages;
+};
+
+/// Number of threads that \ref load_ahead uses
+std::size_t java_class_loadert::load_ahead_threads() const
+{
+#if IREP_THREAD_SAFE
+  if(max_threads == 0)
+    return std::max(1u, std::thread::hardware_concurrency());
+
+  return max_threads;
+#else
+  return 1;
+#endif
+}
+
+/// Load those of \p classes that are neither loaded nor refused by
+/// \p class_loader_limit ahead of their turn, on one thread for each of the
+/// pools of JAR files in \p worker_jars
+void java_class_loadert::load_ahead(
+  java_class_loader_limitt &class_loader_limit,
+  const std::vector<irep_idt> &classes,
+  std::vector<jar_poolt> &worker_jars)
+{
+  PRECONDITION(worker_jars.size() > 1);
+
+  std::vector<irep_idt> to_load;
+  for(const irep_idt &class_name : classes)
+  {
+    if(class_map.count(class_name) != 0 || loaded_ahead.count(class_name) != 0)
+      continue;
+
+    loaded_classt &loaded = loaded_ahead[class_name];
+    loaded.allowed =
+      class_loader_limit.load_class_file(class_name_to_jar_file(class_name));
+    if(loaded.allowed)
+      to_load.push_back(class_name);
+  }
+
+  std::vector<loaded_classt> loaded(to_load.size());
+  std::atomic<std::size_t> next(0);
+
+  auto worker = [this, &to_load, &loaded, &next](jar_poolt &jars) {
+    for(std::size_t i = next++; i < to_load.size(); i = next++)
+      loaded[i] = load_ahead(to_load[i], jars);
+  };
+
+  // the calling thread is one of the workers
+  std::vector<std::thread> workers;
+  const std::size_t threads = std::min(worker_jars.size(), to_load.size());
+  for(std::size_t i = 1; i < threads; ++i)
+    workers.emplace_back(worker, std::ref(worker_jars[i]));
+
+  worker(worker_jars.front());
+
+  for(auto &thread : workers)
+    thread.join();
+
+  for(std::size_t i = 0; i < to_load.size(); ++i)
+    loaded_ahead[to_load[i]] = std::move(loaded[i]);
+}
+
+/// Load \p class_name from each classpath entry, opening JAR files with
+/// \p jars.  This is called on several threads at once, and therefore only
+/// reads the state of the class loader.
+java_class_loadert::loaded_classt
+java_class_loadert::load_ahead(const irep_idt &class_name, jar_poolt &jars)
+{
+  loaded_classt result;
+  message_buffert message_buffer(result.messages);
+
+  try
+  {
+    for(const auto &cp_entry : classpath_entries)
+    {
+      // JAR files that cannot be opened here, e.g. those added from memory
+      // to jar_pool, are left to loading the class in its turn
+      if(cp_entry.kind == classpath_entryt::JAR)
+        jars(cp_entry.path);
+
+      auto parse_tree = load_class(class_name, cp_entry, jars, message_buffer);
+      if(parse_tree.has_value())
+        result.parse_trees.push_back(std::move(*parse_tree));
+    }
+  }
+  catch(...)
+  {
+    // exceptions are raised again when loading the class in its turn
+    result.complete = false;
+  }
+
+  return result;
+}
+
 /// Check if class is an overlay class by searching for `ID_overlay_class` in
 /// its list of annotations.
 ///
@@ -142,8 +289,20 @@ java_class_loadert::get_parse_tree(
 
   messaget log(message_handler);
 
+  optionalt<loaded_classt> loaded;
+  const auto loaded_it = loaded_ahead.find(class_name);
+  if(loaded_it != loaded_ahead.end())
+  {
+    loaded = std::move(loaded_it->second);
+    loaded_ahead.erase(loaded_it);
+  }
+
   // do we refuse to load?
-  if(!class_loader_limit.load_class_file(class_name_to_jar_file(class_name)))
+  if(
+    loaded.has_value()
+      ? !loaded->allowed
+      : !class_loader_limit.load_class_file(
+          class_name_to_jar_file(class_name)))
   {
     log.debug() << "not loading " << class_name << " because of limit"
                 << messaget::eom;
@@ -151,12 +310,21 @@ java_class_loadert::get_parse_tree(
     return parse_trees;
   }
 
-  // Rummage through the class path
-  for(const auto &cp_entry : classpath_entries)
+  if(loaded.has_value() && loaded->complete)
   {
-    auto parse_tree = load_class(class_name, cp_entry, message_handler);
-    if(parse_tree.has_value())
-      parse_trees.emplace_back(std::move(*parse_tree));
+    for(const auto &message : loaded->messages)
+      message_handler.print(message.first, message.second);
+    parse_trees = std::move(loaded->parse_trees);
+  }
+  else
+  {
+    // Rummage through the class path
+    for(const auto &cp_entry : classpath_entries)
+    {
+      auto parse_tree = load_class(class_name, cp_entry, message_handler);
+      if(parse_tree.has_value())
+        parse_trees.emplace_back(std::move(*parse_tree));
+    }
   }
 
   auto parse_tree_it = parse_trees.begin();
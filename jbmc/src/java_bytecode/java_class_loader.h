@@ -13,6 +13,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <map>
 #include <regex>
 #include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <util/fixed_keys_map_wrapper.h>
 
@@ -79,6 +82,17 @@ public:
   std::vector<irep_idt>
   load_entire_jar(const std::string &jar_path, message_handlert &);
 
+  /// Inflate and parse the classes referenced by a class on up to
+  /// \p threads threads (the number of hardware threads if zero), ahead of
+  /// their turn.  The parse trees and messages are used in the same order as
+  /// when loading on a single thread, the default.  Classes are only loaded
+  /// concurrently if ireps are built with `IREP_THREAD_SAFE`; otherwise
+  /// classes are loaded in their turn, as without this option.
+  void set_max_threads(std::size_t threads)
+  {
+    max_threads = threads;
+  }
+
   /// Map from class names to the bytecode parse trees
   fixed_keys_map_wrappert<parse_tree_with_overridest_mapt>
   get_class_with_overlays_map()
@@ -106,6 +120,35 @@ private:
   /// Map from class names to the bytecode parse trees
   parse_tree_with_overridest_mapt class_map;
 
+  std::size_t max_threads = 1;
+
+  /// The parse trees of a class loaded ahead of its turn, and the messages
+  /// printed while loading it
+  struct loaded_classt
+  {
+    /// Whether the class loader limit allows loading the class
+    bool allowed = true;
+    /// False if loading failed for reasons other than the class not being
+    /// found, e.g. as a JAR file could not be opened; the class is then
+    /// loaded again in its turn
+    bool complete = true;
+    /// The parse trees of the class from each classpath entry with one
+    parse_tree_with_overlayst parse_trees;
+    std::vector<std::pair<unsigned, std::string>> messages;
+  };
+
+  /// Classes loaded by \ref load_ahead that have not had their turn yet
+  std::unordered_map<irep_idt, loaded_classt> loaded_ahead;
+
+  std::size_t load_ahead_threads() const;
+
+  void load_ahead(
+    java_class_loader_limitt &class_loader_limit,
+    const std::vector<irep_idt> &classes,
+    std::vector<jar_poolt> &worker_jars);
+
+  loaded_classt load_ahead(const irep_idt &class_name, jar_poolt &jars);
+
   optionalt<std::vector<irep_idt>>
   read_jar_file(const std::string &jar_path, message_handlert &);
 };
@@ -17,6 +17,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/suffix.h>
 
 #include <fstream>
+#include <sstream>
+
+#include <miniz/miniz.h>
 
 void java_class_loader_baset::add_classpath_entry(
   const std::string &path,
@@ -135,11 +138,20 @@ optionalt<java_bytecode_parse_treet> java_class_loader_baset::load_class(
   const irep_idt &class_name,
   const classpath_entryt &cp_entry,
   message_handlert &message_handler)
+{
+  return load_class(class_name, cp_entry, jar_pool, message_handler);
+}
+
+optionalt<java_bytecode_parse_treet> java_class_loader_baset::load_class(
+  const irep_idt &class_name,
+  const classpath_entryt &cp_entry,
+  jar_poolt &jars,
+  message_handlert &message_handler)
 {
   switch(cp_entry.kind)
   {
   case classpath_entryt::JAR:
-    return get_class_from_jar(class_name, cp_entry.path, message_handler);
+    return get_class_from_jar(class_name, cp_entry.path, jars, message_handler);
 
   case classpath_entryt::DIRECTORY:
     return get_class_from_directory(class_name, cp_entry.path, message_handler);
@@ -151,20 +163,41 @@ optionalt<java_bytecode_parse_treet> java_class_loader_baset::load_class(
 /// Load class from jar file.
 /// \param class_name: name of class to load in Java source format
 /// \param jar_file: path of the jar file
+/// \param jars: the pool to open the jar file with
 /// \param message_handler: message handler
 /// \return optional value of parse tree, empty if class cannot be loaded
 optionalt<java_bytecode_parse_treet>
 java_class_loader_baset::get_class_from_jar(
   const irep_idt &class_name,
   const std::string &jar_file,
+  jar_poolt &jars,
   message_handlert &message_handler)
 {
   messaget log(message_handler);
 
   try
   {
-    auto &jar = jar_pool(jar_file);
-    auto data = jar.get_entry(class_name_to_jar_file(class_name));
+    auto &jar = jars(jar_file);
+    const std::string entry_name = class_name_to_jar_file(class_name);
+
+    optionalt<std::uint32_t> crc;
+    if(class_cache.has_value())
+    {
+      crc = jar.get_entry_crc32(entry_name);
+      if(!crc.has_value())
+        return {};
+
+      auto cached = class_cache->lookup(jar_file, entry_name, *crc);
+      if(cached.has_value())
+      {
+        log.debug() << "Getting class '" << class_name
+                    << "' from the class cache for JAR " << jar_file
+                    << messaget::eom;
+        return cached;
+      }
+    }
+
+    auto data = jar.get_entry(entry_name);
 
     if(!data.has_value())
       return {};
@@ -173,7 +206,18 @@ java_class_loader_baset::get_class_from_jar(
                 << messaget::eom;
 
     std::istringstream istream(*data);
-    return java_bytecode_parse(istream, class_name, message_handler);
+    auto parse_tree = java_bytecode_parse(istream, class_name, message_handler);
+
+    if(
+      crc.has_value() && parse_tree.has_value() &&
+      parse_tree->loading_successful &&
+      class_cache->store(jar_file, entry_name, *crc, *parse_tree))
+    {
+      log.warning() << "failed to store class '" << class_name
+                    << "' in the class cache" << messaget::eom;
+    }
+
+    return parse_tree;
   }
   catch(const std::runtime_error &)
   {
@@ -198,13 +242,52 @@ java_class_loader_baset::get_class_from_directory(
   const std::string class_file = class_name_to_os_file(class_name);
   const std::string full_path = concat_dir_file(path, class_file);
 
-  if(std::ifstream(full_path))
+  std::ifstream in(full_path, std::ios::binary);
+  if(!in)
+    return {};
+
+  messaget log(message_handler);
+
+  if(!class_cache.has_value())
   {
-    messaget log(message_handler);
     log.debug() << "Getting class '" << class_name << "' from file "
                 << full_path << messaget::eom;
     return java_bytecode_parse(full_path, class_name, message_handler);
   }
-  else
-    return {};
+
+  // Class files in directories are cached like JAR entries, keyed by the
+  // directory, the file and the CRC-32 of its contents, so that a changed
+  // class file gets a new cache entry.
+  std::ostringstream contents;
+  contents << in.rdbuf();
+  const std::string data = contents.str();
+  const std::uint32_t crc = static_cast<std::uint32_t>(mz_crc32(
+    MZ_CRC32_INIT,
+    reinterpret_cast<const unsigned char *>(data.data()),
+    data.size()));
+
+  auto cached = class_cache->lookup(path, class_file, crc);
+  if(cached.has_value())
+  {
+    log.debug() << "Getting class '" << class_name
+                << "' from the class cache for file " << full_path
+                << messaget::eom;
+    return cached;
+  }
+
+  log.debug() << "Getting class '" << class_name << "' from file "
+              << full_path << messaget::eom;
+
+  std::istringstream istream(data);
+  auto parse_tree = java_bytecode_parse(istream, class_name, message_handler);
+
+  if(
+    parse_tree.has_value() && parse_tree->loading_successful &&
+    class_cache->store(path, class_file, crc, *parse_tree))
+  {
+    log.warning() << "failed to store class '" << class_name
+                  << "' in the class cache" << messaget::eom;
+  }
+
+  return parse_tree;
 }
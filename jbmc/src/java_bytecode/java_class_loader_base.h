@@ -11,6 +11,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "jar_pool.h"
 #include "java_bytecode_parse_tree.h"
+#include "java_class_cache.h"
 
 class message_handlert;
 
@@ -37,6 +38,14 @@ public:
   /// a cache for jar_filet, by path name
   jar_poolt jar_pool;
 
+  /// Keep the parse trees of classes loaded from JAR files and directories in
+  /// \p cache, and reuse those stored there by earlier runs, see
+  /// \ref java_class_cachet
+  void set_class_cache(java_class_cachet cache)
+  {
+    class_cache = std::move(cache);
+  }
+
 protected:
   /// An entry in the classpath
   struct classpath_entryt
@@ -54,16 +63,28 @@ protected:
   /// List of entries in the classpath
   std::list<classpath_entryt> classpath_entries;
 
+  /// Parse trees of classes stored by earlier runs or requests
+  optionalt<java_class_cachet> class_cache;
+
   /// attempt to load a class from a classpath_entry
   optionalt<java_bytecode_parse_treet> load_class(
     const irep_idt &class_name,
     const classpath_entryt &,
     message_handlert &);
 
+  /// attempt to load a class from a classpath_entry, opening JAR files with
+  /// \p jars, e.g. a pool of the calling thread, rather than \ref jar_pool
+  optionalt<java_bytecode_parse_treet> load_class(
+    const irep_idt &class_name,
+    const classpath_entryt &,
+    jar_poolt &jars,
+    message_handlert &);
+
   /// attempt to load a class from a given jar file
   optionalt<java_bytecode_parse_treet> get_class_from_jar(
     const irep_idt &class_name,
     const std::string &jar_file,
+    jar_poolt &jars,
     message_handlert &);
 
   /// attempt to load a class from a given directory
@@ -877,6 +877,19 @@ void java_object_factoryt::gen_nondet_struct_init(
 
       bool _is_sub=name[0]=='@';
 
+      // Fields that no method refers to keep the zero of the initial write,
+      // rather than getting nondet object trees that nothing can observe.
+      // Not so for string types, whose fields the string models read, or for
+      // objects that are updated in place, which have no such write.
+      if(
+        !_is_sub && object_factory_parameters.used_fields &&
+        object_factory_parameters.used_fields->count(name) == 0 &&
+        !is_java_string_type(struct_type) &&
+        update_in_place != update_in_placet::MUST_UPDATE_IN_PLACE)
+      {
+        continue;
+      }
+
       // MUST_UPDATE_IN_PLACE only applies to this object.
       // If this is a pointer to another object, offer the chance
       // to leave it alone by setting MAY_UPDATE_IN_PLACE instead.
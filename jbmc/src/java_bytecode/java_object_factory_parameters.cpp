@@ -12,6 +12,8 @@ Author: Daniel Poetzl
 
 #include <util/cmdline.h>
 #include <util/options.h>
+#include <util/std_expr.h>
+#include <util/symbol_table_base.h>
 #include <util/validate.h>
 
 void java_object_factory_parameterst::set(const optionst &options)
@@ -39,6 +41,27 @@ void java_object_factory_parameterst::set(const optionst &options)
     assume_inputs_interval = *interval;
   }
   assume_inputs_integral = options.is_set("java-assume-inputs-integral");
+  init_used_fields_only = options.is_set("java-init-used-fields-only");
+}
+
+std::unordered_set<irep_idt>
+java_used_field_names(const symbol_table_baset &symbol_table)
+{
+  std::unordered_set<irep_idt> used_fields;
+
+  for(const auto &symbol : symbol_table.symbols)
+  {
+    if(symbol.second.type.id() != ID_code || symbol.second.value.is_nil())
+      continue;
+
+    // reads and writes alike, as telling them apart is not worth it
+    symbol.second.value.visit_pre([&used_fields](const exprt &expr) {
+      if(expr.id() == ID_member)
+        used_fields.insert(to_member_expr(expr).get_component_name());
+    });
+  }
+
+  return used_fields;
 }
 
 void parse_java_object_factory_options(
@@ -57,4 +80,8 @@ void parse_java_object_factory_options(
   {
     options.set_option("java-assume-inputs-integral", true);
   }
+  if(cmdline.isset("java-init-used-fields-only"))
+  {
+    options.set_option("java-init-used-fields-only", true);
+  }
 }
@@ -12,6 +12,11 @@ Author: Daniel Poetzl
 #include <util/interval_union.h>
 #include <util/object_factory_parameters.h>
 
+#include <memory>
+#include <unordered_set>
+
+class symbol_table_baset;
+
 struct java_object_factory_parameterst final : public object_factory_parameterst
 {
   java_object_factory_parameterst()
@@ -29,10 +34,26 @@ struct java_object_factory_parameterst final : public object_factory_parameterst
   /// Force double and float inputs to be integral
   bool assume_inputs_integral;
 
+  /// Only nondet-initialize the fields of entry-point arguments that are in
+  /// \ref used_fields, once it has been computed
+  bool init_used_fields_only = false;
+
+  /// Names of the fields that the loaded methods refer to; fields with other
+  /// names are left zero by the object factory, except in string types, which
+  /// the string models read.  Not set unless \ref init_used_fields_only is,
+  /// see \ref java_used_field_names.
+  std::shared_ptr<const std::unordered_set<irep_idt>> used_fields;
+
   /// Assigns the parameters from given options
   void set(const optionst &);
 };
 
+/// \return the names of the fields that the code of the methods in
+///   \p symbol_table refers to, that is, the fields whose values can be
+///   observed by running the methods
+std::unordered_set<irep_idt>
+java_used_field_names(const symbol_table_baset &symbol_table);
+
 /// Parse the java object factory parameters from a given command line
 /// \param cmdline: Command line
 /// \param [out] options: The options object that will be updated
@@ -21,6 +21,7 @@ Author: Chris Smowton, chris.smowton@diffblue.com
 
 #include <iomanip>
 #include <sstream>
+#include <unordered_map>
 
 /// Convert UCS-2 or UTF-16 to an array expression.
 /// \par parameters: `in`: wide string to convert
@@ -30,8 +31,18 @@ static array_exprt utf16_to_array(const std::wstring &in)
   const auto jchar=java_char_type();
   array_exprt ret(
     {}, array_typet(jchar, from_integer(in.length(), java_int_type())));
+  ret.operands().reserve(in.length());
+  // Elements that are the same character share a single constant, so that a
+  // long literal takes one expression per distinct character, not per
+  // character.
+  std::unordered_map<wchar_t, exprt> characters;
   for(const auto c : in)
-    ret.copy_to_operands(from_integer(c, jchar));
+  {
+    auto entry = characters.emplace(c, nil_exprt());
+    if(entry.second)
+      entry.first->second = from_integer(c, jchar);
+    ret.copy_to_operands(entry.first->second);
+  }
   return ret;
 }
 
@@ -104,6 +104,15 @@ std::string mz_zip_archivet::extract(const size_t index)
   throw std::runtime_error("Could not extract the file");
 }
 
+std::uint32_t mz_zip_archivet::get_crc32(const size_t index)
+{
+  const auto id = static_cast<mz_uint>(index);
+  mz_zip_archive_file_stat file_stat = {};
+  if(mz_zip_reader_file_stat(m_state.get(), id, &file_stat) != MZ_TRUE)
+    throw std::runtime_error("Could not read the file information");
+  return file_stat.m_crc32;
+}
+
 void mz_zip_archivet::extract_to_file(
   const size_t index,
   const std::string &path)
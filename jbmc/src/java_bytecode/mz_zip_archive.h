@@ -9,6 +9,7 @@ Author: Diffblue Ltd
 #ifndef CPROVER_JAVA_BYTECODE_MZ_ZIP_ARCHIVE_H
 #define CPROVER_JAVA_BYTECODE_MZ_ZIP_ARCHIVE_H
 
+#include <cstdint>
 #include <string>
 #include <memory>
 
@@ -51,6 +52,12 @@ public:
   /// \throw Throws std::runtime_error if file cannot be extracted
   /// \return Contents of the file in the archive
   std::string extract(size_t index);
+  /// Get the CRC-32 of the contents of nth file in the archive, as recorded
+  /// in the archive's central directory, i.e., without extracting the file
+  /// \param index: id of the file in the archive
+  /// \throw Throws std::runtime_error if the file information cannot be read
+  /// \return CRC-32 of the contents of the file
+  std::uint32_t get_crc32(size_t index);
   /// Write contents of nth file in the archive to a file
   /// \param index: id of the file in the archive
   /// \param path:  path to which to write the contents of the file
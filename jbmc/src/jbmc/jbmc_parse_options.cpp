@@ -11,15 +11,33 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "jbmc_parse_options.h"
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <cstdlib> // exit()
 #include <iostream>
+#include <list>
+#include <map>
 #include <memory>
+#include <set>
+#include <sstream>
+
+#ifndef _WIN32
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <signal.h>
+#  include <sys/time.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
 
 #include <util/config.h>
 #include <util/exit_codes.h>
 #include <util/invariant.h>
 #include <util/make_unique.h>
+#include <util/string2int.h>
+#include <util/string_utils.h>
+#include <util/tempfile.h>
 #include <util/unicode.h>
 #include <util/version.h>
 #include <util/xml.h>
@@ -28,6 +46,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <ansi-c/ansi_c_language.h>
 
+#include <json/json_parser.h>
+
 #include <goto-checker/all_properties_verifier.h>
 #include <goto-checker/all_properties_verifier_with_fault_localization.h>
 #include <goto-checker/all_properties_verifier_with_trace_storage.h>
@@ -67,6 +87,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <java_bytecode/java_multi_path_symex_only_checker.h>
 #include <java_bytecode/java_single_path_symex_checker.h>
 #include <java_bytecode/java_single_path_symex_only_checker.h>
+#include <java_bytecode/java_utils.h>
 #include <java_bytecode/lazy_goto_model.h>
 #include <java_bytecode/remove_exceptions.h>
 #include <java_bytecode/remove_instanceof.h>
@@ -79,7 +100,8 @@ jbmc_parse_optionst::jbmc_parse_optionst(int argc, const char **argv)
       JBMC_OPTIONS,
       argc,
       argv,
-      std::string("JBMC ") + CBMC_VERSION)
+      std::string("JBMC ") + CBMC_VERSION),
+    optstring(JBMC_OPTIONS)
 {
   json_interface(cmdline, ui_message_handler);
   xml_interface(cmdline, ui_message_handler);
@@ -93,7 +115,8 @@ jbmc_parse_optionst::jbmc_parse_optionst(int argc, const char **argv)
       JBMC_OPTIONS + extra_options,
       argc,
       argv,
-      std::string("JBMC ") + CBMC_VERSION)
+      std::string("JBMC ") + CBMC_VERSION),
+    optstring(JBMC_OPTIONS + extra_options)
 {
   json_interface(cmdline, ui_message_handler);
   xml_interface(cmdline, ui_message_handler);
@@ -135,6 +158,9 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
   parse_java_language_options(cmdline, options);
   parse_java_object_factory_options(cmdline, options);
 
+  if(serving)
+    options.set_option("java-class-cache-in-memory", true);
+
   if(cmdline.isset("max-field-sensitivity-array-size"))
   {
     options.set_option(
@@ -468,6 +494,12 @@ int jbmc_parse_optionst::doit()
     return CPROVER_EXIT_SUCCESS;
   }
 
+  if(cmdline.isset("server"))
+    return serve();
+
+  if(cmdline.isset("functions-from-file"))
+    return verify_functions_from_file();
+
   messaget::eval_verbosity(
     cmdline.get_value("verbosity"), messaget::M_STATISTICS, ui_message_handler);
 
@@ -684,6 +716,438 @@ int jbmc_parse_optionst::doit()
   return result_to_exit_code(result);
 }
 
+/// Write \p json to the standard output on a single line
+static void output_json_line(const jsont &json)
+{
+  std::ostringstream out;
+  out << json;
+  std::string line = out.str();
+  line.erase(std::remove(line.begin(), line.end(), '\n'), line.end());
+  std::cout << line << std::endl;
+}
+
+int jbmc_parse_optionst::serve()
+{
+  serving = true;
+
+  std::string request_line;
+  while(std::getline(std::cin, request_line))
+  {
+    if(request_line.empty())
+      continue;
+
+    jsont id;
+    const int exit_code = answer_request(request_line, id);
+
+    // the response is written after all messages of the request
+    output_json_line(
+      json_objectt{{"id", id},
+                   {"exit-code", json_numbert(std::to_string(exit_code))}});
+  }
+
+  return CPROVER_EXIT_SUCCESS;
+}
+
+/// Run jbmc with the command-line arguments of the request on
+/// \p request_line, a JSON object such as
+/// `{"id": 1, "arguments": ["--function", "A.f", "--classpath", "a.jar"]}`
+/// \param request_line: the request
+/// \param [out] id: the "id" of the request, to be copied to its response
+/// \return the exit code jbmc would have returned for these arguments
+int jbmc_parse_optionst::answer_request(
+  const std::string &request_line,
+  jsont &id)
+{
+  std::istringstream request_stream(request_line);
+  jsont request;
+  if(
+    parse_json(request_stream, "request", ui_message_handler, request) ||
+    !request.is_object())
+  {
+    log.error() << "request is not a JSON object" << messaget::eom;
+    return CPROVER_EXIT_USAGE_ERROR;
+  }
+
+  id = request["id"];
+
+  const jsont &arguments = request["arguments"];
+  if(!arguments.is_array())
+  {
+    log.error() << "request has no array of arguments" << messaget::eom;
+    return CPROVER_EXIT_USAGE_ERROR;
+  }
+
+  std::vector<std::string> argument_strings{"jbmc"};
+  for(const auto &argument : to_json_array(arguments))
+  {
+    if(!argument.is_string())
+    {
+      log.error() << "request arguments must be strings" << messaget::eom;
+      return CPROVER_EXIT_USAGE_ERROR;
+    }
+    argument_strings.push_back(argument.value);
+  }
+
+  std::vector<const char *> argv;
+  for(const auto &argument : argument_strings)
+    argv.push_back(argument.c_str());
+
+  if(cmdline.parse(
+       static_cast<int>(argv.size()), argv.data(), optstring.c_str()))
+  {
+    log.error() << "unknown option in request: " << cmdline.unknown_arg
+                << messaget::eom;
+    return CPROVER_EXIT_USAGE_ERROR;
+  }
+
+  if(cmdline.isset("server"))
+  {
+    log.error() << "--server cannot be given in a request" << messaget::eom;
+    return CPROVER_EXIT_USAGE_ERROR;
+  }
+
+  // start from the defaults rather than the state left by the previous
+  // request, e.g., its classpath or its --max-nondet-array-length
+  config = configt();
+  object_factory_params = java_object_factory_parameterst();
+  stub_objects_are_not_null = false;
+  method_context.reset();
+  class_hierarchy.reset();
+
+  return main();
+}
+
+#ifndef _WIN32
+static void interrupt_wait(int)
+{
+}
+#endif
+
+/// Each method is verified by running jbmc with --function set to it in a
+/// child process, writing its output to a temporary file.  Once the child has
+/// terminated, its output is copied to the standard output, followed by a line
+/// `{"function": name, "result": r, "exit-code": n, "time": seconds}`, where r
+/// is one of "SUCCESS", "FAILURE", "ERROR" or "TIMEOUT".
+/// \return CPROVER_EXIT_SUCCESS if all methods were verified successfully, and
+///   otherwise the exit code of the first listed method that was not
+int jbmc_parse_optionst::verify_functions_from_file()
+{
+#ifdef _WIN32
+  log.error() << "--functions-from-file is not supported on Windows"
+              << messaget::eom;
+  return CPROVER_EXIT_USAGE_ERROR;
+#else
+  messaget::eval_verbosity(
+    cmdline.get_value("verbosity"), messaget::M_STATISTICS, ui_message_handler);
+
+  if(cmdline.isset("function"))
+  {
+    log.error() << "--function and --functions-from-file must not be given "
+                << "together" << messaget::eom;
+    return CPROVER_EXIT_USAGE_ERROR;
+  }
+
+  const std::string file_name = cmdline.get_value("functions-from-file");
+  std::ifstream functions_file(file_name);
+  if(!functions_file)
+  {
+    log.error() << "failed to open " << file_name << messaget::eom;
+    return CPROVER_EXIT_USAGE_ERROR;
+  }
+
+  std::vector<std::string> functions;
+  std::string line;
+  while(std::getline(functions_file, line))
+  {
+    line = strip_string(line);
+    if(!line.empty())
+      functions.push_back(line);
+  }
+
+  std::size_t jobs = 1;
+  if(cmdline.isset("jobs"))
+  {
+    const auto value = string2optional_size_t(cmdline.get_value("jobs"));
+    if(!value.has_value() || *value == 0)
+    {
+      log.error() << "--jobs expects a positive number" << messaget::eom;
+      return CPROVER_EXIT_USAGE_ERROR;
+    }
+    jobs = *value;
+  }
+
+  optionalt<std::chrono::seconds> timeout;
+  if(cmdline.isset("function-timeout"))
+  {
+    const auto value =
+      string2optional_size_t(cmdline.get_value("function-timeout"));
+    if(!value.has_value() || *value == 0)
+    {
+      log.error() << "--function-timeout expects a positive number of seconds"
+                  << messaget::eom;
+      return CPROVER_EXIT_USAGE_ERROR;
+    }
+    timeout = std::chrono::seconds(*value);
+  }
+
+  serving = true;
+  load_classes_of(functions);
+
+  struct runt
+  {
+    std::string function;
+    pid_t pid;
+    temporary_filet output;
+    std::chrono::steady_clock::time_point start;
+  };
+  std::list<runt> running;
+
+  auto start = [this](const std::string &function) -> runt {
+    temporary_filet output("jbmc_function_", ".out");
+
+    // not to output buffered text in the child process as well
+    std::cout << std::flush;
+    std::cerr << std::flush;
+
+    const pid_t pid = fork();
+    if(pid == 0)
+    {
+      const int output_fd = open(output().c_str(), O_WRONLY | O_TRUNC);
+      if(output_fd != -1)
+      {
+        dup2(output_fd, STDOUT_FILENO);
+        dup2(output_fd, STDERR_FILENO);
+        close(output_fd);
+      }
+
+      config = configt();
+      cmdline.set("functions-from-file", false);
+      cmdline.set("function", function);
+      // the class of the method is the main class
+      if(!cmdline.isset("jar") && !cmdline.isset("gb"))
+      {
+        cmdline.args.clear();
+        const auto class_name = class_name_from_method_name(function);
+        if(class_name.has_value())
+          cmdline.args.push_back(*class_name);
+      }
+
+      const int exit_code = main();
+      std::cout << std::flush;
+      std::cerr << std::flush;
+      // without running the destructors of the objects of the parent process
+      _exit(exit_code);
+    }
+
+    return runt{
+      function, pid, std::move(output), std::chrono::steady_clock::now()};
+  };
+
+  std::map<std::string, int> exit_codes;
+
+  auto finish = [&](const runt &run, int status, bool timed_out) {
+    std::ifstream output(run.output());
+    if(output.peek() != std::ifstream::traits_type::eof())
+      std::cout << output.rdbuf();
+
+    int exit_code;
+    std::string result;
+    if(timed_out)
+    {
+      exit_code = CPROVER_EXIT_VERIFICATION_INCONCLUSIVE;
+      result = "TIMEOUT";
+    }
+    else if(WIFEXITED(status))
+    {
+      exit_code = WEXITSTATUS(status);
+      result = exit_code == CPROVER_EXIT_VERIFICATION_SAFE ? "SUCCESS"
+               : exit_code == CPROVER_EXIT_VERIFICATION_UNSAFE ? "FAILURE"
+                                                               : "ERROR";
+    }
+    else
+    {
+      exit_code = CPROVER_EXIT_INTERNAL_ERROR;
+      result = "ERROR";
+    }
+    exit_codes.emplace(run.function, exit_code);
+
+    const std::chrono::duration<double> runtime =
+      std::chrono::steady_clock::now() - run.start;
+    output_json_line(json_objectt{
+      {"function", json_stringt(run.function)},
+      {"result", json_stringt(result)},
+      {"exit-code", json_numbert(std::to_string(exit_code))},
+      {"time", json_numbert(std::to_string(runtime.count()))}});
+  };
+
+  // stop the processes still running when giving up
+  auto stop_all = [&running]() {
+    for(const auto &run : running)
+    {
+      kill(run.pid, SIGKILL);
+      waitpid(run.pid, nullptr, 0);
+    }
+    running.clear();
+  };
+
+  // The wait for the next process to terminate is interrupted by SIGALRM
+  // when the first running process is due to time out.  The timer repeats,
+  // in case it expires before the wait has started.
+  struct sigaction alarm_action;
+  alarm_action.sa_handler = interrupt_wait;
+  sigemptyset(&alarm_action.sa_mask);
+  alarm_action.sa_flags = 0;
+  struct sigaction previous_alarm_action;
+  sigaction(SIGALRM, &alarm_action, &previous_alarm_action);
+
+  auto set_timer = [](std::chrono::microseconds delay) {
+    itimerval timer;
+    timer.it_value.tv_sec = delay.count() / 1000000;
+    timer.it_value.tv_usec = delay.count() % 1000000;
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = delay.count() == 0 ? 0 : 100000;
+    setitimer(ITIMER_REAL, &timer, nullptr);
+  };
+
+  int result = CPROVER_EXIT_SUCCESS;
+
+  auto next_function = functions.begin();
+  while(next_function != functions.end() || !running.empty())
+  {
+    while(running.size() < jobs && next_function != functions.end())
+    {
+      running.push_back(start(*next_function));
+      if(running.back().pid == -1)
+      {
+        running.pop_back();
+        log.error() << "failed to start a process for " << *next_function
+                    << messaget::eom;
+        result = CPROVER_EXIT_INTERNAL_ERROR;
+        break;
+      }
+      ++next_function;
+    }
+
+    if(result != CPROVER_EXIT_SUCCESS)
+      break;
+
+    if(timeout.has_value())
+    {
+      auto first_start = running.front().start;
+      for(const auto &run : running)
+        first_start = std::min(first_start, run.start);
+
+      const auto delay =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+          first_start + *timeout - std::chrono::steady_clock::now());
+      // a zero delay would disarm the timer
+      set_timer(std::max(delay, std::chrono::microseconds(1)));
+    }
+
+    int status;
+    const pid_t pid = waitpid(-1, &status, 0);
+    const int wait_errno = errno;
+
+    if(timeout.has_value())
+      set_timer(std::chrono::microseconds(0));
+
+    if(pid > 0)
+    {
+      const auto run = std::find_if(
+        running.begin(), running.end(), [pid](const runt &r) {
+          return r.pid == pid;
+        });
+      if(run != running.end())
+      {
+        finish(*run, status, false);
+        running.erase(run);
+      }
+    }
+    else if(wait_errno != EINTR)
+    {
+      log.error() << "failed to wait for the verification processes"
+                  << messaget::eom;
+      result = CPROVER_EXIT_INTERNAL_ERROR;
+      break;
+    }
+
+    if(timeout.has_value())
+    {
+      for(auto run = running.begin(); run != running.end();)
+      {
+        if(std::chrono::steady_clock::now() - run->start < *timeout)
+        {
+          ++run;
+          continue;
+        }
+
+        kill(run->pid, SIGKILL);
+        waitpid(run->pid, &status, 0);
+        finish(*run, status, true);
+        run = running.erase(run);
+      }
+    }
+  }
+
+  stop_all();
+  sigaction(SIGALRM, &previous_alarm_action, nullptr);
+
+  if(result != CPROVER_EXIT_SUCCESS)
+    return result;
+
+  for(const auto &function : functions)
+  {
+    const int exit_code = exit_codes.at(function);
+    if(exit_code != CPROVER_EXIT_SUCCESS)
+      return exit_code;
+  }
+
+  return CPROVER_EXIT_SUCCESS;
+#endif
+}
+
+/// Load the classes of \p functions, and those they refer to, so that their
+/// parse trees are kept in memory for the processes that verify the
+/// functions.  Classes that cannot be loaded are left to the
+/// verification of their functions to report.
+void jbmc_parse_optionst::load_classes_of(
+  const std::vector<std::string> &functions)
+{
+  optionst options;
+  get_command_line_options(options);
+
+  std::set<std::string> class_names;
+  for(const auto &function : functions)
+  {
+    const auto class_name = class_name_from_method_name(function);
+    if(class_name.has_value())
+      class_names.insert(*class_name);
+  }
+
+  if(cmdline.isset("jar"))
+    config.java.classpath.push_back(cmdline.get_value("jar"));
+
+  std::unique_ptr<languaget> language = new_java_bytecode_language();
+  language->set_language_options(options);
+  language->set_message_handler(ui_message_handler);
+
+  log.status() << "Loading the classes of " << functions.size()
+               << " functions" << messaget::eom;
+
+  for(const auto &class_name : class_names)
+  {
+    config.java.main_class = class_name;
+    try
+    {
+      static_cast<java_bytecode_languaget &>(*language).parse();
+    }
+    catch(const invalid_source_file_exceptiont &e)
+    {
+      log.warning() << e.what() << messaget::eom;
+    }
+  }
+}
+
 int jbmc_parse_optionst::get_goto_program(
   std::unique_ptr<abstract_goto_modelt> &goto_model_ptr,
   const optionst &options)
@@ -1062,9 +1526,23 @@ void jbmc_parse_optionst::help()
     HELP_JAVA_JAR
     " jbmc\n"
     HELP_JAVA_GOTO_BINARY
+    " jbmc --server                answer verification requests read from\n"
+    "                              standard input, one JSON object per line\n"
+    "                              with the command-line arguments of the\n"
+    "                              request as \"arguments\" and an optional\n"
+    "                              \"id\"; each is answered with a line\n"
+    "                              {\"id\": id, \"exit-code\": n}\n"
+    " jbmc --functions-from-file f verify each method listed in f, one per\n"
+    "                              line, in a process of its own, loading\n"
+    "                              their classes only once; the result of\n"
+    "                              each is given as a line of JSON\n"
     "\n"
     HELP_JAVA_CLASSPATH
     HELP_FUNCTIONS
+    " --jobs n                     verify n methods of --functions-from-file\n"
+    "                              at a time (default: 1)\n"
+    " --function-timeout s         stop verifying a method of\n"
+    "                              --functions-from-file after s seconds\n"
     "\n"
     "Analysis options:\n"
     HELP_SHOW_PROPERTIES
@@ -89,7 +89,9 @@ class optionst;
   "(java-threading)" \
   OPT_GOTO_TRACE \
   OPT_VALIDATE \
-  "(symex-driven-lazy-loading)"
+  "(symex-driven-lazy-loading)" \
+  "(server)" \
+  "(functions-from-file):(jobs):(function-timeout):"
 // clang-format on
 
 class jbmc_parse_optionst : public parse_options_baset
@@ -125,11 +127,30 @@ public:
     bool body_available);
 
 protected:
+  /// The options accepted on the command line and in server requests
+  const std::string optstring;
+  /// Whether verification requests are being answered, see \ref serve, or
+  /// the methods of --functions-from-file verified, keeping the parse trees
+  /// of classes loaded from JAR files in memory
+  bool serving = false;
+
   java_object_factory_parameterst object_factory_params;
   bool stub_objects_are_not_null;
 
   std::unique_ptr<class_hierarchyt> class_hierarchy;
 
+  /// Answer verification requests read from the standard input, one JSON
+  /// object per line, keeping the parse trees of classes loaded from JAR
+  /// files in memory for later requests
+  int serve();
+  int answer_request(const std::string &request_line, jsont &id);
+
+  /// Verify each of the methods listed in the file given with
+  /// --functions-from-file in a process of its own, forked once the classes
+  /// of the methods have been loaded
+  int verify_functions_from_file();
+  void load_classes_of(const std::vector<std::string> &functions);
+
   void get_command_line_options(optionst &);
   int get_goto_program(
     std::unique_ptr<abstract_goto_modelt> &goto_model,
@@ -0,0 +1,160 @@
+/*******************************************************************\
+
+Module: Unit tests for java_class_cachet
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <java_bytecode/java_bytecode_parser.h>
+#include <java_bytecode/java_class_cache.h>
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+#include <util/tempdir.h>
+
+typedef java_bytecode_parse_treet::annotationst annotationst;
+
+static void
+require_same(const annotationst &annotations, const annotationst &expected)
+{
+  REQUIRE(annotations.size() == expected.size());
+  for(std::size_t i = 0; i < annotations.size(); ++i)
+  {
+    REQUIRE(annotations[i].type == expected[i].type);
+    REQUIRE(
+      annotations[i].element_value_pairs.size() ==
+      expected[i].element_value_pairs.size());
+  }
+}
+
+static void require_same(
+  const java_bytecode_parse_treet &parse_tree,
+  const java_bytecode_parse_treet &expected)
+{
+  const auto &parsed_class = parse_tree.parsed_class;
+  const auto &expected_class = expected.parsed_class;
+
+  REQUIRE(parsed_class.name == expected_class.name);
+  REQUIRE(parsed_class.super_class == expected_class.super_class);
+  REQUIRE(parsed_class.implements == expected_class.implements);
+  REQUIRE(
+    parsed_class.attribute_bootstrapmethods_read ==
+    expected_class.attribute_bootstrapmethods_read);
+  REQUIRE(
+    parsed_class.lambda_method_handle_map.size() ==
+    expected_class.lambda_method_handle_map.size());
+  require_same(parsed_class.annotations, expected_class.annotations);
+  REQUIRE(parse_tree.class_refs == expected.class_refs);
+
+  REQUIRE(parsed_class.fields.size() == expected_class.fields.size());
+  auto expected_field = expected_class.fields.begin();
+  for(const auto &field : parsed_class.fields)
+  {
+    REQUIRE(field.name == expected_field->name);
+    REQUIRE(field.descriptor == expected_field->descriptor);
+    require_same(field.annotations, expected_field->annotations);
+    ++expected_field;
+  }
+
+  REQUIRE(parsed_class.methods.size() == expected_class.methods.size());
+  auto expected_method = expected_class.methods.begin();
+  for(const auto &method : parsed_class.methods)
+  {
+    REQUIRE(method.name == expected_method->name);
+    REQUIRE(method.descriptor == expected_method->descriptor);
+    REQUIRE(method.signature == expected_method->signature);
+    require_same(method.annotations, expected_method->annotations);
+    REQUIRE(
+      method.local_variable_table.size() ==
+      expected_method->local_variable_table.size());
+    REQUIRE(
+      method.stack_map_table.size() ==
+      expected_method->stack_map_table.size());
+
+    REQUIRE(
+      method.instructions.size() == expected_method->instructions.size());
+    for(std::size_t i = 0; i < method.instructions.size(); ++i)
+    {
+      const auto &instruction = method.instructions[i];
+      const auto &expected_instruction = expected_method->instructions[i];
+      REQUIRE(instruction.address == expected_instruction.address);
+      REQUIRE(instruction.bytecode == expected_instruction.bytecode);
+      REQUIRE(instruction.args == expected_instruction.args);
+    }
+    ++expected_method;
+  }
+}
+
+SCENARIO(
+  "java_class_cachet stores and restores parse trees",
+  "[core][java_bytecode][java_class_cache]")
+{
+  temp_dirt cache_directory("java_class_cache_XXXXXX");
+  const java_class_cachet cache(cache_directory.path, false);
+
+  const std::vector<std::pair<std::string, std::string>> classes = {
+    {"AnnotationsEverywhere",
+     "./java_bytecode/java_bytecode_parser/AnnotationsEverywhere.class"},
+    {"StaticLambdas",
+     "./java_bytecode/java_bytecode_parse_lambdas/lambda_examples/"
+     "openjdk_8_classes/StaticLambdas.class"}};
+
+  for(const auto &class_entry : classes)
+  {
+    GIVEN("The parse tree of " + class_entry.first)
+    {
+      const auto parse_tree = java_bytecode_parse(
+        class_entry.second, class_entry.first, null_message_handler);
+      REQUIRE(parse_tree.has_value());
+      REQUIRE(parse_tree->loading_successful);
+
+      const std::string entry = class_entry.first + ".class";
+      REQUIRE_FALSE(cache.lookup("classes.jar", entry, 42).has_value());
+      REQUIRE_FALSE(cache.store("classes.jar", entry, 42, *parse_tree));
+
+      THEN("The cached parse tree is the same")
+      {
+        const auto cached = cache.lookup("classes.jar", entry, 42);
+        REQUIRE(cached.has_value());
+        REQUIRE(cached->loading_successful);
+        require_same(*cached, *parse_tree);
+      }
+
+      THEN("It is not found for a different JAR or CRC")
+      {
+        REQUIRE_FALSE(cache.lookup("other.jar", entry, 42).has_value());
+        REQUIRE_FALSE(cache.lookup("classes.jar", entry, 43).has_value());
+      }
+    }
+  }
+}
+
+SCENARIO(
+  "java_class_cachet shares parse trees kept in memory",
+  "[core][java_bytecode][java_class_cache]")
+{
+  GIVEN("The parse tree of AnnotationsEverywhere stored in a memory cache")
+  {
+    const auto parse_tree = java_bytecode_parse(
+      "./java_bytecode/java_bytecode_parser/AnnotationsEverywhere.class",
+      "AnnotationsEverywhere",
+      null_message_handler);
+    REQUIRE(parse_tree.has_value());
+
+    const java_class_cachet cache({}, true);
+    REQUIRE_FALSE(
+      cache.store("memory.jar", "AnnotationsEverywhere.class", 7, *parse_tree));
+
+    THEN("Another memory cache of the process finds it")
+    {
+      const java_class_cachet other_cache({}, true);
+      const auto cached =
+        other_cache.lookup("memory.jar", "AnnotationsEverywhere.class", 7);
+      REQUIRE(cached.has_value());
+      require_same(*cached, *parse_tree);
+      REQUIRE_FALSE(
+        other_cache.lookup("memory.jar", "AnnotationsEverywhere.class", 8)
+          .has_value());
+    }
+  }
+}
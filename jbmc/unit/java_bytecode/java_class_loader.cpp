@@ -0,0 +1,87 @@
+/*******************************************************************\
+
+Module: Unit tests for java_class_loadert
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <java_bytecode/java_class_loader.h>
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+/// Load \p class_name and the classes it references with \p threads threads,
+/// keeping their parse trees in memory if \p in_memory is set
+/// \return the names of the loaded classes and the number of methods of each
+static std::map<irep_idt, std::size_t> load(
+  const irep_idt &class_name,
+  std::size_t threads,
+  bool in_memory = false)
+{
+  java_class_loadert java_class_loader;
+  java_class_loader.set_java_cp_include_files(".*");
+  java_class_loader.set_max_threads(threads);
+  if(in_memory)
+    java_class_loader.set_class_cache(java_class_cachet({}, true));
+  java_class_loader.add_classpath_entry(
+    "./java_bytecode/java_bytecode_parse_lambdas/lambda_examples/"
+    "openjdk_8_classes",
+    null_message_handler);
+  java_class_loader.add_classpath_entry(
+    "./pointer-analysis/CustomVSATest.jar", null_message_handler);
+
+  java_class_loader(class_name, null_message_handler);
+
+  std::map<irep_idt, std::size_t> loaded;
+  for(const auto &entry : java_class_loader.get_class_with_overlays_map())
+  {
+    std::size_t methods = 0;
+    for(const auto &parse_tree : entry.second)
+    {
+      if(parse_tree.loading_successful)
+        methods += parse_tree.parsed_class.methods.size();
+    }
+    loaded.emplace(entry.first, methods);
+  }
+  return loaded;
+}
+
+SCENARIO(
+  "java_class_loadert loads the same classes on several threads",
+  "[core][java_bytecode][java_class_loader]")
+{
+  for(const irep_idt class_name : {"LocalLambdas", "CustomVSATest"})
+  {
+    GIVEN("The classes referenced by " + id2string(class_name))
+    {
+      const auto loaded = load(class_name, 1);
+      REQUIRE(loaded.at(class_name) > 0);
+
+      THEN("Loading them on several threads gives the same parse trees")
+      {
+        REQUIRE(load(class_name, 4) == loaded);
+        REQUIRE(load(class_name, 0) == loaded);
+      }
+    }
+  }
+}
+
+SCENARIO(
+  "java_class_loadert keeps the parse trees of classes in memory",
+  "[core][java_bytecode][java_class_loader]")
+{
+  // LocalLambdas is loaded from a directory, CustomVSATest from a JAR file
+  for(const irep_idt class_name : {"LocalLambdas", "CustomVSATest"})
+  {
+    GIVEN("The classes referenced by " + id2string(class_name))
+    {
+      const auto loaded = load(class_name, 1);
+
+      THEN("Loading them again from memory gives the same parse trees")
+      {
+        REQUIRE(load(class_name, 1, true) == loaded);
+        REQUIRE(load(class_name, 1, true) == loaded);
+      }
+    }
+  }
+}
@@ -92,11 +92,12 @@ static bool uses_raw_struct_types(const exprt &expr)
   });
 }
 
-code_blockt
-initialise_nondet_object_of_type(const typet &type, symbol_tablet &symbol_table)
+code_blockt initialise_nondet_object_of_type(
+  const typet &type,
+  symbol_tablet &symbol_table,
+  const java_object_factory_parameterst &parameters = {})
 {
   code_blockt created_code;
-  java_object_factory_parameterst parameters;
   select_pointer_typet pointer_selector;
 
   object_factory(
@@ -146,6 +147,30 @@ SCENARIO(
       }
     }
 
+    WHEN("Creating a nondet 'A' object when only its field 'b' is used")
+    {
+      struct_tag_typet A_type("java::A");
+      struct_tag_typet B_type("java::B");
+      struct_tag_typet C_type("java::C");
+
+      java_object_factory_parameterst parameters;
+      parameters.init_used_fields_only = true;
+      parameters.used_fields =
+        std::make_shared<const std::unordered_set<irep_idt>>(
+          std::unordered_set<irep_idt>{"b"});
+
+      const auto a_pointer = java_reference_type(A_type);
+      code_blockt created_code =
+        initialise_nondet_object_of_type(a_pointer, symbol_table, parameters);
+
+      THEN("An A and a B object should be allocated, but no C object")
+      {
+        REQUIRE(contains_decl_of_type(created_code, A_type));
+        REQUIRE(contains_decl_of_type(created_code, B_type));
+        REQUIRE_FALSE(contains_decl_of_type(created_code, C_type));
+      }
+    }
+
     WHEN("Creating a nondet 'HasArray' object")
     {
       struct_tag_typet HasArray_type("java::HasArray");
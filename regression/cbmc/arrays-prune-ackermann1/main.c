@@ -0,0 +1,26 @@
+#include <assert.h>
+
+int main()
+{
+  unsigned n, i, j, k;
+  __CPROVER_assume(n > 0 && i < n && j < n && k < n);
+
+  int a[n];
+  int b[n];
+  _Bool c;
+
+  a[k] = 42;
+  b[j] = a[i];
+  int x = c ? a[j] : b[j];
+
+  if(i == k)
+    assert(a[i] == 42);
+  if(i == j)
+    assert(a[i] == a[j]);
+  if(c && i == j)
+    assert(x == a[i]);
+  if(!c)
+    assert(x == a[i]);
+
+  return 0;
+}
@@ -0,0 +1,14 @@
+int main()
+{
+  int a[10];
+  int i;
+  __CPROVER_assume(i >= 0 && i < 10);
+  a[i] = 1;
+
+  int x = 1;
+  int *p = &x;
+  *p = 20;
+  __CPROVER_assert(x <= 1, "x is written through a pointer");
+
+  return 0;
+}
@@ -0,0 +1,15 @@
+int main()
+{
+  int x;
+  __CPROVER_assume(x >= 0 && x <= 1000);
+
+  // x == 256 passes this test, as the conversion truncates
+  if((unsigned char)x < 10)
+    __CPROVER_assert(x < 10, "narrowing conversion bounds its operand");
+
+  // widening conversions preserve the value
+  if((long long)x < 10)
+    __CPROVER_assert(x < 10, "widening conversion bounds its operand");
+
+  return 0;
+}
@@ -0,0 +1,12 @@
+void f(int *p);
+
+int main()
+{
+  int x = 0;
+  int y = 0;
+  f(&x);
+  __CPROVER_assert(x <= 0, "x may be written by f");
+  __CPROVER_assert(y <= 0, "y is not passed to f");
+
+  return 0;
+}
@@ -0,0 +1,20 @@
+#include <assert.h>
+
+int g;
+
+void f(int a)
+{
+  int b = a + 1;
+  int c = b + 1;
+  g = c;
+}
+
+int main(void)
+{
+  int x = 0;
+  f(x);
+  int y = g;
+  int z = y + 1;
+  assert(z == 3);
+  return 0;
+}
@@ -0,0 +1,26 @@
+#include <assert.h>
+
+int g;
+int r;
+
+void copy(void)
+{
+  r = g;
+}
+
+int main(void)
+{
+  g = 1;
+  copy();
+  assert(r == 1);
+
+  g = 2;
+  copy();
+  assert(r == 2);
+
+  g = 1;
+  copy();
+  assert(r == 1);
+
+  return 0;
+}
@@ -0,0 +1,17 @@
+#include <assert.h>
+
+int inc(int a)
+{
+  int b = a + 1;
+  return b;
+}
+
+int main(void)
+{
+  int x = 1;
+  int y = inc(x);
+  int unused = 5;
+  assert(y == 2);
+  assert(x == 1);
+  return 0;
+}
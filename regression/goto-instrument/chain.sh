@@ -30,7 +30,7 @@ else
   $goto_cc -o "${name}.gb" "${name}.c"
 fi
 
-rm -f "${name}-mod.gb"
+rm -f "${name}-mod.gb" "${name}-mod.gb".*
 $goto_instrument ${args} "${name}.gb" "${name}-mod.gb"
 if [ ! -e "${name}-mod.gb" ] ; then
   cp "$name.gb" "${name}-mod.gb"
@@ -50,5 +50,13 @@ elif echo $args | grep -q -- "--dump-c" ; then
 
   rm "${name}-mod.c"
 fi
+if echo $args | grep -q -- "--property-slices" ; then
+  for slice in "${name}-mod.gb".[0-9]* ; do
+    echo "Slice ${slice}:"
+    $goto_instrument --show-goto-functions "${slice}"
+  done
+  echo "End of slices"
+  cat "${name}-mod.gb.slices"
+fi
 $goto_instrument --show-goto-functions "${name}-mod.gb"
 $cbmc "${name}-mod.gb"
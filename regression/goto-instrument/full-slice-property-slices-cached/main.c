@@ -0,0 +1,8 @@
+int main()
+{
+  int x, y;
+  x = 1;
+  y = 2;
+  __CPROVER_assert(x == 1, "x");
+  __CPROVER_assert(y == 2, "y");
+}
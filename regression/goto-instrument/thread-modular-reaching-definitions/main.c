@@ -0,0 +1,17 @@
+int x;
+int y;
+
+void writer()
+{
+  x = 1;
+}
+
+int main()
+{
+__CPROVER_ASYNC_1:
+  writer();
+
+  y = x;
+
+  return 0;
+}
@@ -10,7 +10,10 @@ Author: Daniel Kroening, kroening@kroening.com
 /// Abstract Interpretation
 
 #include "ai.h"
+#include "weak_topological_order.h"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <type_traits>
@@ -204,14 +207,59 @@ void ai_baset::finalize()
   // Nothing to do per default
 }
 
+bool ai_baset::working_set_ordert::
+operator()(const trace_ptrt &a, const trace_ptrt &b) const
+{
+  if(positions != nullptr)
+  {
+    // Locations without a position go last
+    const auto a_it = positions->find(a->current_location());
+    const auto b_it = positions->find(b->current_location());
+    const std::size_t a_position = a_it == positions->end()
+                                     ? std::numeric_limits<std::size_t>::max()
+                                     : a_it->second;
+    const std::size_t b_position = b_it == positions->end()
+                                     ? std::numeric_limits<std::size_t>::max()
+                                     : b_it->second;
+    if(a_position != b_position)
+      return a_position < b_position;
+  }
+
+  return ai_history_baset::compare_historyt()(a, b);
+}
+
+ai_baset::working_sett
+ai_baset::make_working_set(const goto_programt &goto_program)
+{
+  if(
+    worklist_order == worklist_ordert::HISTORY ||
+    goto_program.instructions.empty())
+  {
+    return working_sett();
+  }
+
+  // The order is computed once per function
+  if(worklist_positions.count(goto_program.instructions.begin()) == 0)
+  {
+    const weak_topological_ordert order(goto_program);
+    for(const auto &l : order.get_order())
+    {
+      worklist_positions.emplace(l, order.position(l));
+      if(order.is_head(l))
+        widening_points.insert(l);
+    }
+  }
+
+  return working_sett(working_set_ordert(&worklist_positions));
+}
+
 ai_baset::trace_ptrt ai_baset::get_next(working_sett &working_set)
 {
   PRECONDITION(!working_set.empty());
 
   static_assert(
-    std::is_same<
-      working_sett,
-      std::set<trace_ptrt, ai_history_baset::compare_historyt>>::value,
+    std::is_same<working_sett, std::set<trace_ptrt, working_set_ordert>>::
+      value,
     "begin must return the minimal entry");
   auto first = working_set.begin();
 
@@ -231,7 +279,7 @@ bool ai_baset::fixedpoint(
 {
   PRECONDITION(start_trace != nullptr);
 
-  working_sett working_set;
+  working_sett working_set = make_working_set(goto_program);
   put_in_working_set(working_set, start_trace);
 
   bool new_data=false;
@@ -271,6 +319,21 @@ bool ai_baset::visit(
   bool new_data=false;
   locationt l = p->current_location();
 
+  if(state_retention == state_retentiont::JOIN_POINTS)
+  {
+    // The state has been discarded since the last visit and nothing has
+    // reached it since, so this is stale
+    const auto transient_state = transient_states.find(p);
+    if(
+      transient_state != transient_states.end() &&
+      transient_state->second.discarded)
+    {
+      return false;
+    }
+
+    compute_transient_locations(goto_program);
+  }
+
   // Function call and end are special cases
   if(l->is_function_call())
   {
@@ -314,6 +377,9 @@ bool ai_baset::visit(
     }
   }
 
+  if(state_retention == state_retentiont::JOIN_POINTS)
+    discard_transient_state(p, ns);
+
   return new_data;
 }
 
@@ -340,8 +406,12 @@ bool ai_baset::visit_edge(
   statet &new_values = *tmp_state;
 
   // Apply transformer
+  ++statistics.transformers;
   new_values.transform(function_id, p, to_function_id, to_p, *this, ns);
 
+  if(state_retention == state_retentiont::JOIN_POINTS)
+    record_transient_edge(p, function_id, to_p, new_values);
+
   // Expanding a domain means that it has to be analysed again
   // Likewise if the history insists that it is a new trace
   // (assuming it is actually reachable).
@@ -357,6 +427,168 @@ bool ai_baset::visit_edge(
   return false;
 }
 
+void ai_baset::compute_transient_locations(const goto_programt &goto_program)
+{
+  if(
+    goto_program.instructions.empty() ||
+    !transient_functions.insert(goto_program.instructions.begin()).second)
+  {
+    return;
+  }
+
+  std::unordered_map<
+    locationt,
+    std::vector<locationt>,
+    const_target_hash,
+    pointee_address_equalt>
+    predecessors;
+  forall_goto_program_instructions(it, goto_program)
+  {
+    for(const auto &successor : goto_program.get_successors(it))
+      predecessors[successor].push_back(it);
+  }
+
+  for(const auto &entry : predecessors)
+  {
+    const locationt l = entry.first;
+    const locationt predecessor = entry.second.front();
+
+    // The states at function entries and at the end of functions are used by
+    // the interprocedural analysis, and those after calls are not computed
+    // from a local predecessor
+    if(
+      entry.second.size() == 1 && l != goto_program.instructions.begin() &&
+      !l->is_end_function() && !predecessor->is_function_call() &&
+      predecessor != l)
+    {
+      transient_locations.emplace(l, predecessor);
+    }
+  }
+}
+
+void ai_baset::record_transient_edge(
+  trace_ptrt from,
+  const irep_idt &function_id,
+  trace_ptrt to,
+  const statet &new_values)
+{
+  const auto transient_location =
+    transient_locations.find(to->current_location());
+  if(
+    transient_location == transient_locations.end() ||
+    transient_location->second != from->current_location())
+  {
+    return;
+  }
+
+  const auto inserted =
+    transient_states.emplace(to, transient_statet{from, function_id, false});
+  if(inserted.second)
+    return;
+
+  transient_statet &transient_state = inserted.first->second;
+  const ai_history_baset::compare_historyt less;
+  const bool same_predecessor =
+    transient_state.predecessor != nullptr &&
+    !less(transient_state.predecessor, from) &&
+    !less(from, transient_state.predecessor);
+
+  if(transient_state.discarded)
+  {
+    // States only grow, so a new state from the same predecessor includes the
+    // discarded one and merging it recomputes it
+    if(same_predecessor && new_values.is_bottom())
+      return;
+
+    if(!same_predecessor)
+    {
+      cstate_ptrt restored = recompute_state(to);
+      domain_factory->merge(get_state(to), *restored, to, to);
+    }
+
+    transient_state.discarded = false;
+  }
+
+  if(!same_predecessor)
+    transient_state.predecessor = nullptr;
+}
+
+void ai_baset::discard_transient_state(trace_ptrt p, const namespacet &ns)
+{
+  const auto transient_state = transient_states.find(p);
+  if(
+    transient_state == transient_states.end() ||
+    transient_state->second.predecessor == nullptr ||
+    transient_state->second.discarded || !storage->discard(p))
+  {
+    return;
+  }
+
+  transient_state->second.discarded = true;
+  if(transient_ns == nullptr)
+    transient_ns = util_make_unique<namespacet>(ns);
+}
+
+ai_baset::cstate_ptrt ai_baset::recompute_state(trace_ptrt p) const
+{
+  // Walk back to the closest history whose state is stored
+  std::vector<std::pair<trace_ptrt, const transient_statet *>> discarded;
+  for(auto transient_state = transient_states.find(p);
+      transient_state != transient_states.end() &&
+      transient_state->second.discarded;
+      transient_state = transient_states.find(p))
+  {
+    discarded.emplace_back(p, &transient_state->second);
+    p = transient_state->second.predecessor;
+  }
+
+  cstate_ptrt stored = storage->abstract_state_before(p, *domain_factory);
+  if(discarded.empty())
+    return stored;
+
+  std::unique_ptr<statet> state = domain_factory->copy(*stored);
+  for(auto it = discarded.rbegin(); it != discarded.rend(); ++it)
+  {
+    if(state->is_bottom())
+      break;
+
+    // The transformers do not modify the analysis, see state_retentiont
+    state->transform(
+      it->second->function_id,
+      p,
+      it->second->function_id,
+      it->first,
+      const_cast<ai_baset &>(*this),
+      *transient_ns);
+    p = it->first;
+  }
+
+  return std::move(state);
+}
+
+ai_baset::cstate_ptrt ai_baset::recompute_state_before(locationt l) const
+{
+  const auto traces = storage->abstract_traces_before(l);
+
+  const bool any_discarded =
+    std::any_of(traces->begin(), traces->end(), [this](const trace_ptrt &p) {
+      const auto transient_state = transient_states.find(p);
+      return transient_state != transient_states.end() &&
+             transient_state->second.discarded;
+    });
+  if(!any_discarded)
+    return storage->abstract_state_before(l, *domain_factory);
+
+  if(traces->size() == 1)
+    return recompute_state(*traces->begin());
+
+  std::unique_ptr<statet> state = domain_factory->make(l);
+  for(const auto &p : *traces)
+    domain_factory->merge(*state, *recompute_state(p), p, p);
+
+  return std::move(state);
+}
+
 bool ai_baset::visit_edge_function_call(
   const irep_idt &calling_function_id,
   trace_ptrt p_call,
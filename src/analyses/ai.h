@@ -48,6 +48,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <util/deprecate.h>
 #include <util/expr.h>
@@ -99,7 +103,8 @@ Author: Daniel Kroening, kroening@kroening.com
 ///
 /// C. To change the way that the fixed point is computed
 ///    \ref ait#fixedpoint()
-///    concurrency_aware_ait does this to compute a fixed point over threads.
+///    concurrency_aware_ait does this to compute a fixed point over threads,
+///    either by iterating over all threads or thread-modularly.
 ///
 /// D. For pre-analysis initialization
 ///    \ref ait#initialize(const irep_idt&, const goto_programt&),
@@ -221,7 +226,10 @@ public:
   ///   including merging abstract states, etc.
   virtual cstate_ptrt abstract_state_before(locationt l) const
   {
-    return storage->abstract_state_before(l, *domain_factory);
+    if(transient_states.empty())
+      return storage->abstract_state_before(l, *domain_factory);
+
+    return recompute_state_before(l);
   }
 
   /// Get a copy of the abstract state after the given instruction, without
@@ -243,7 +251,7 @@ public:
   /// The same interfaces but with histories
   virtual cstate_ptrt abstract_state_before(const trace_ptrt &p) const
   {
-    return storage->abstract_state_before(p, *domain_factory);
+    return recompute_state(p);
   }
 
   virtual cstate_ptrt abstract_state_after(const trace_ptrt &p) const
@@ -259,13 +267,78 @@ public:
       ai_history_baset::no_caller_history);
     // Caller history not needed as this is a local step
 
-    return storage->abstract_state_before(step_return.second, *domain_factory);
+    return recompute_state(step_return.second);
   }
 
   /// Reset the abstract state
   virtual void clear()
   {
     storage->clear();
+    worklist_positions.clear();
+    widening_points.clear();
+    transient_locations.clear();
+    transient_functions.clear();
+    transient_states.clear();
+    transient_ns.reset();
+    statistics = statisticst();
+  }
+
+  /// The order in which the work queue is processed
+  enum class worklist_ordert
+  {
+    /// The ordering of the histories, which roughly follows location numbers
+    HISTORY,
+    /// A weak topological order of the instructions of each function, so that
+    /// inner loops are stabilised before the instructions after them are
+    /// visited again; ties are broken by the ordering of the histories
+    WEAK_TOPOLOGICAL
+  };
+
+  void set_worklist_order(worklist_ordert order)
+  {
+    worklist_order = order;
+  }
+
+  /// True if \p l is the head of a component of the weak topological order
+  /// of its function, i.e. a point at which domains of infinite height should
+  /// widen.  Only known for functions analysed with the
+  /// worklist_ordert::WEAK_TOPOLOGICAL order.
+  bool is_widening_point(locationt l) const
+  {
+    return widening_points.count(l) != 0;
+  }
+
+  /// Which abstract states are kept once they have been propagated
+  enum class state_retentiont
+  {
+    /// All of them
+    ALL,
+    /// Only those at the entry of functions, at instructions with more than
+    /// one predecessor (which includes all loop heads, i.e. the widening
+    /// points) and around function calls.  The others are discarded once they
+    /// have been propagated and are recomputed from their predecessor when
+    /// they are needed again.  This requires transformers that do not modify
+    /// the abstract interpreter, and symbol tables that outlive it.
+    JOIN_POINTS
+  };
+
+  void set_state_retention(state_retentiont retention)
+  {
+    state_retention = retention;
+  }
+
+  /// Counts of the work done by the analysis
+  struct statisticst
+  {
+    /// Number of applications of abstract transformers
+    std::size_t transformers = 0;
+    /// Number of merges into the stored abstract states
+    std::size_t merges = 0;
+  };
+
+  const statisticst &get_statistics() const
+  {
+    return statistics;
   }
 
   /// Output the abstract states for a single function
@@ -411,8 +484,35 @@ protected:
     const irep_idt &function_id,
     const goto_programt &goto_program) const;
 
-  /// The work queue, sorted using the history's ordering operator
-  typedef trace_sett working_sett;
+  /// Orders the work queue by the positions of the locations, if given, and
+  /// then by the history's ordering operator
+  class working_set_ordert
+  {
+  public:
+    typedef std::unordered_map<
+      locationt,
+      std::size_t,
+      const_target_hash,
+      pointee_address_equalt>
+      positionst;
+
+    explicit working_set_ordert(const positionst *positions = nullptr)
+      : positions(positions)
+    {
+    }
+
+    bool operator()(const trace_ptrt &a, const trace_ptrt &b) const;
+
+  protected:
+    const positionst *positions;
+  };
+
+  /// The work queue
+  typedef std::set<trace_ptrt, working_set_ordert> working_sett;
+
+  /// An empty work queue for the instructions of \p goto_program, ordered as
+  /// selected by \ref set_worklist_order
+  working_sett make_working_set(const goto_programt &goto_program);
 
   /// Get the next location from the work queue
   trace_ptrt get_next(working_sett &working_set);
@@ -498,6 +598,7 @@ protected:
   /// tracet \p to, into the state currently stored for tracet \p to.
   virtual bool merge(const statet &src, trace_ptrt from, trace_ptrt to)
   {
+    ++statistics.merges;
     statet &dest = get_state(to);
     return domain_factory->merge(dest, src, from, to);
   }
@@ -511,6 +612,73 @@ protected:
   // Domain and history storage
   std::unique_ptr<ai_storage_baset> storage;
 
+  worklist_ordert worklist_order = worklist_ordert::HISTORY;
+
+  /// The positions of the instructions of the functions analysed so far in
+  /// their weak topological order
+  working_set_ordert::positionst worklist_positions;
+
+  /// The heads of the components of those weak topological orders
+  std::unordered_set<locationt, const_target_hash, pointee_address_equalt>
+    widening_points;
+
+  statisticst statistics;
+
+  state_retentiont state_retention = state_retentiont::ALL;
+
+  typedef std::unordered_map<
+    locationt,
+    locationt,
+    const_target_hash,
+    pointee_address_equalt>
+    transient_locationst;
+  /// The instructions whose states need not be kept, each with its only
+  /// predecessor, for the functions in \ref transient_functions
+  transient_locationst transient_locations;
+  /// The first instructions of the functions analysed so far
+  std::unordered_set<locationt, const_target_hash, pointee_address_equalt>
+    transient_functions;
+
+  /// How the state of a history at a transient location is computed
+  struct transient_statet
+  {
+    /// The only history whose state flows into this one, or nullptr if there
+    /// are several, in which case the state is never discarded
+    trace_ptrt predecessor;
+    irep_idt function_id;
+    /// True if the storage has discarded the state
+    bool discarded;
+  };
+  typedef std::
+    map<trace_ptrt, transient_statet, ai_history_baset::compare_historyt>
+      transient_statest;
+  transient_statest transient_states;
+
+  /// The namespace used for recomputing discarded states
+  std::unique_ptr<const namespacet> transient_ns;
+
+  /// Compute \ref transient_locations for \p goto_program
+  void compute_transient_locations(const goto_programt &goto_program);
+
+  /// Record that the state of \p to is computed from that of \p from, which
+  /// has been transformed to \p new_values, restoring the state of \p to if
+  /// it has been discarded and will not be recomputed by merging new_values
+  void record_transient_edge(
+    trace_ptrt from,
+    const irep_idt &function_id,
+    trace_ptrt to,
+    const statet &new_values);
+
+  /// Discard the state of \p p if it is transient
+  void discard_transient_state(trace_ptrt p, const namespacet &ns);
+
+  /// The state of \p p, recomputing it if it has been discarded
+  cstate_ptrt recompute_state(trace_ptrt p) const;
+
+  /// The join of the states of the histories before \p l, recomputing them
+  /// if they have been discarded
+  cstate_ptrt recompute_state_before(locationt l) const;
+
   /// Get the state for the given history, creating it with the factory if it
   /// doesn't exist
   virtual statet &get_state(trace_ptrt p)
@@ -638,6 +806,14 @@ private:
 /// has this property, numerical domains such as constants and intervals do not
 /// and using this kind of concurrent analysis for these domains may miss
 /// significant behaviours.
+///
+/// In \ref concurrency_modet::THREAD_MODULAR mode, the shared state is instead
+/// kept as one interference summary per thread, i.e., per function that has
+/// threaded instructions: the result of `merge_shared` on the state at the end
+/// of the function.  Each summary is merged into the threaded instructions of
+/// all threads, and a thread is only analysed again when a summary it has not
+/// seen yet has changed; only the instructions whose state changes are visited
+/// again.
 template<typename domainT>
 class concurrency_aware_ait:public ait<domainT>
 {
@@ -665,9 +841,59 @@ public:
       static_cast<const domainT &>(src), from, to, ns);
   }
 
+  /// How the fixed point over threads is computed
+  enum class concurrency_modet
+  {
+    /// Analyse all threaded instructions again until the shared state of all
+    /// threads stabilises
+    ITERATE_ALL,
+    /// Keep an interference summary per thread and only analyse the threads
+    /// that are affected by a changed summary again
+    THREAD_MODULAR
+  };
+
+  void set_concurrency_mode(concurrency_modet mode)
+  {
+    concurrency_mode = mode;
+  }
+
+  concurrency_modet get_concurrency_mode() const
+  {
+    return concurrency_mode;
+  }
+
+  /// How the thread-modular fixed point converged for one thread
+  struct thread_statisticst
+  {
+    /// Number of times the thread was analysed after the sequential fixed
+    /// point
+    std::size_t analyses = 0;
+    /// Number of those analyses that changed its interference summary
+    std::size_t summary_changes = 0;
+    /// Number of applications of abstract transformers in those analyses
+    std::size_t transformers = 0;
+  };
+
+  /// The convergence of each thread, by function, in
+  /// \ref concurrency_modet::THREAD_MODULAR mode
+  const std::map<irep_idt, thread_statisticst> &get_thread_statistics() const
+  {
+    return thread_statistics;
+  }
+
+  void clear() override
+  {
+    ait<domainT>::clear();
+    thread_statistics.clear();
+  }
+
 protected:
   using working_sett = ai_baset::working_sett;
 
+  concurrency_modet concurrency_mode = concurrency_modet::ITERATE_ALL;
+
+  std::map<irep_idt, thread_statisticst> thread_statistics;
+
   void fixedpoint(
     ai_baset::trace_ptrt start_trace,
     const goto_functionst &goto_functions,
@@ -677,6 +903,12 @@ protected:
 
     is_threadedt is_threaded(goto_functions);
 
+    if(concurrency_mode == concurrency_modet::THREAD_MODULAR)
+    {
+      thread_modular_fixedpoint(is_threaded, goto_functions, ns);
+      return;
+    }
+
     // construct an initial shared state collecting the results of all
     // functions
     goto_programt tmp;
@@ -733,7 +965,8 @@ protected:
 
       for(const auto &wl_entry : thread_wl)
       {
-        working_sett working_set;
+        working_sett working_set =
+          ai_baset::make_working_set(*wl_entry.goto_program);
         ai_baset::trace_ptrt t(
           ai_baset::history_factory->epoch(wl_entry.location));
         ai_baset::put_in_working_set(working_set, t);
@@ -763,6 +996,131 @@ protected:
       }
     }
   }
+
+  void thread_modular_fixedpoint(
+    const is_threadedt &is_threaded,
+    const goto_functionst &goto_functions,
+    const namespacet &ns)
+  {
+    struct threadt
+    {
+      irep_idt function_id;
+      const goto_programt *goto_program;
+      /// The instructions that may run concurrently with other threads
+      std::vector<locationt> threaded;
+      locationt end;
+      ai_baset::trace_ptrt end_trace;
+      /// The shared state at the end of the thread
+      std::unique_ptr<statet> summary;
+      /// The threads whose summaries changed since this thread last saw them
+      std::set<std::size_t> changed_summaries;
+    };
+
+    std::vector<threadt> threads;
+
+    for(const auto &gf_entry : goto_functions.function_map)
+    {
+      const goto_programt &body = gf_entry.second.body;
+
+      std::vector<locationt> threaded;
+      forall_goto_program_instructions(t_it, body)
+      {
+        if(is_threaded(t_it))
+          threaded.push_back(t_it);
+      }
+
+      if(threaded.empty())
+        continue;
+
+      const locationt end = std::prev(body.instructions.end());
+      ai_baset::trace_ptrt end_trace(ai_baset::history_factory->epoch(end));
+      std::unique_ptr<statet> summary = ai_baset::domain_factory->make(end);
+      static_cast<domainT &>(*summary).merge_shared(
+        static_cast<const domainT &>(this->get_state(end_trace)),
+        end,
+        end,
+        ns);
+
+      threads.push_back(threadt{gf_entry.first,
+                                &body,
+                                std::move(threaded),
+                                end,
+                                end_trace,
+                                std::move(summary),
+                                {}});
+      thread_statistics[gf_entry.first];
+    }
+
+    // initially, each thread sees the summaries of all threads, including its
+    // own, as there may be several instances of it
+    std::set<std::size_t> thread_worklist;
+    for(std::size_t t = 0; t < threads.size(); ++t)
+    {
+      thread_worklist.insert(t);
+      for(std::size_t u = 0; u < threads.size(); ++u)
+        threads[t].changed_summaries.insert(u);
+    }
+
+    while(!thread_worklist.empty())
+    {
+      const std::size_t current = *thread_worklist.begin();
+      thread_worklist.erase(thread_worklist.begin());
+      threadt &thread = threads[current];
+
+      thread_statisticst &thread_stats = thread_statistics[thread.function_id];
+      ++thread_stats.analyses;
+      const std::size_t transformers_before =
+        ai_baset::statistics.transformers;
+
+      working_sett working_set =
+        ai_baset::make_working_set(*thread.goto_program);
+
+      for(const std::size_t u : thread.changed_summaries)
+      {
+        for(const auto &l : thread.threaded)
+        {
+          ai_baset::trace_ptrt t(ai_baset::history_factory->epoch(l));
+          if(ait<domainT>::merge(*threads[u].summary, threads[u].end_trace, t))
+            ai_baset::put_in_working_set(working_set, t);
+        }
+      }
+      thread.changed_summaries.clear();
+
+      while(!working_set.empty())
+      {
+        ai_baset::trace_ptrt p = ai_baset::get_next(working_set);
+
+        ai_baset::visit(
+          thread.function_id,
+          p,
+          working_set,
+          *thread.goto_program,
+          goto_functions,
+          ns);
+      }
+
+      thread_stats.transformers +=
+        ai_baset::statistics.transformers - transformers_before;
+
+      // as with ITERATE_ALL, the domain must make sure that the final state
+      // carries all possible values
+      if(static_cast<domainT &>(*thread.summary)
+           .merge_shared(
+             static_cast<const domainT &>(this->get_state(thread.end_trace)),
+             thread.end,
+             thread.end,
+             ns))
+      {
+        ++thread_stats.summary_changes;
+
+        for(std::size_t t = 0; t < threads.size(); ++t)
+        {
+          threads[t].changed_summaries.insert(current);
+          thread_worklist.insert(t);
+        }
+      }
+    }
+  }
 };
 
 #endif // CPROVER_ANALYSES_AI_H
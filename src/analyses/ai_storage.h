@@ -92,6 +92,16 @@ public:
   {
     return;
   }
+
+  /// Notifies the storage that the domain for the history \p p will not be
+  /// needed until it is next written to.  Unlike \ref prune, the caller is
+  /// responsible for recomputing it: afterwards get_state will return bottom
+  /// and abstract_state_before will not include it.
+  /// \return true if the domain was discarded
+  virtual bool discard(trace_ptrt p)
+  {
+    return false;
+  }
 };
 
 // There are a number of options for how to store the history objects.
@@ -214,6 +224,16 @@ public:
     return *(it->second);
   }
 
+  bool discard(trace_ptrt p) override
+  {
+    // Other histories reaching the same location would share the domain,
+    // which can only be ruled out for ahistoricalt
+    if(dynamic_cast<const ahistoricalt *>(p.get()) == nullptr)
+      return false;
+
+    return state_map.erase(p->current_location()) != 0;
+  }
+
   void clear() override
   {
     trace_map_storaget::clear();
@@ -292,6 +312,11 @@ public:
     return *(it->second);
   }
 
+  bool discard(trace_ptrt p) override
+  {
+    return domain_map.erase(p) != 0;
+  }
+
   void clear() override
   {
     trace_map_storaget::clear();
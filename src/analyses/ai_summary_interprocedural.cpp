@@ -0,0 +1,272 @@
+/*******************************************************************\
+
+Module: Abstract Interpretation
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// An abstract interpreter that handles function calls using summaries that
+/// are computed once per calling context and reused at every call site that
+/// reaches the function in the same (or a smaller) abstract state.
+
+#include "ai_summary_interprocedural.h"
+
+#include "call_graph.h"
+
+#include <util/make_unique.h>
+
+#include <iterator>
+
+/// The storage used while computing a summary, which makes the states it
+/// holds available for merging into the storage of the caller.
+class summary_storaget : public location_sensitive_storaget
+{
+public:
+  const state_mapt &states() const
+  {
+    return state_map;
+  }
+};
+
+/// Swaps the storage of an abstract interpreter for the lifetime of this
+/// object
+class scoped_storage_swapt
+{
+public:
+  scoped_storage_swapt(
+    std::unique_ptr<ai_storage_baset> &storage,
+    std::unique_ptr<ai_storage_baset> &other)
+    : storage(storage), other(other)
+  {
+    std::swap(storage, other);
+  }
+
+  ~scoped_storage_swapt()
+  {
+    std::swap(storage, other);
+  }
+
+private:
+  std::unique_ptr<ai_storage_baset> &storage;
+  std::unique_ptr<ai_storage_baset> &other;
+};
+
+void ai_summary_interproceduralt::initialize(
+  const goto_functionst &goto_functions)
+{
+  ai_recursive_interproceduralt::initialize(goto_functions);
+
+  const auto call_graph = call_grapht(goto_functions).get_directed_graph();
+  std::vector<call_grapht::directed_grapht::node_indext> scc_numbers;
+  call_graph.SCCs(scc_numbers);
+
+  call_graph_scc.clear();
+  for(const auto &node : call_graph.get_nodes_by_name())
+    call_graph_scc.emplace(node.first, scc_numbers[node.second]);
+}
+
+bool ai_summary_interproceduralt::visit_edge_function_call(
+  const irep_idt &calling_function_id,
+  trace_ptrt p_call,
+  locationt l_return,
+  const irep_idt &callee_function_id,
+  working_sett &working_set,
+  const goto_programt &callee,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  // Recursive calls can't be summarised before the summary is complete
+  const auto caller_scc = call_graph_scc.find(calling_function_id);
+  const auto callee_scc = call_graph_scc.find(callee_function_id);
+  if(
+    caller_scc == call_graph_scc.end() || callee_scc == call_graph_scc.end() ||
+    caller_scc->second == callee_scc->second)
+  {
+    return ai_recursive_interproceduralt::visit_edge_function_call(
+      calling_function_id,
+      p_call,
+      l_return,
+      callee_function_id,
+      working_set,
+      callee,
+      goto_functions,
+      ns);
+  }
+
+  // This is the edge from call site to function head, which gives the
+  // calling context.  The history of the head is only used to compute the
+  // transformer, the state is stored in the summary.
+  locationt l_begin = callee.instructions.begin();
+  const trace_sett no_traces;
+  auto next =
+    p_call->step(l_begin, no_traces, ai_history_baset::no_caller_history);
+  if(next.first == ai_history_baset::step_statust::BLOCKED)
+    return false;
+  trace_ptrt p_begin = next.second;
+
+  std::unique_ptr<statet> entry = make_temporary_state(get_state(p_call));
+  ++statistics.transformers;
+  entry->transform(
+    calling_function_id, p_call, callee_function_id, p_begin, *this, ns);
+  if(entry->is_bottom())
+    return false;
+
+  const summaryt *summary =
+    find_summary(callee_function_id, *entry, p_call, p_begin);
+
+  if(summary != nullptr)
+    ++summaries_reused;
+  else if(
+    max_contexts == 0 || summaries[callee_function_id].size() < max_contexts)
+  {
+    summary = &compute_summary(
+      callee_function_id,
+      std::move(entry),
+      p_begin,
+      callee,
+      goto_functions,
+      ns);
+  }
+  else
+  {
+    // Too many calling contexts, analyse the callee in the current storage
+    return ai_recursive_interproceduralt::visit_edge_function_call(
+      calling_function_id,
+      p_call,
+      l_return,
+      callee_function_id,
+      working_set,
+      callee,
+      goto_functions,
+      ns);
+  }
+
+  // This is the edge from function end to return site.
+  return visit_return_edge(
+    callee_function_id,
+    *summary,
+    calling_function_id,
+    l_return,
+    p_call,
+    ns,
+    working_set);
+}
+
+const ai_summary_interproceduralt::summaryt *
+ai_summary_interproceduralt::find_summary(
+  const irep_idt &callee_function_id,
+  const statet &entry,
+  trace_ptrt p_call,
+  trace_ptrt p_begin)
+{
+  const auto summaries_it = summaries.find(callee_function_id);
+  if(summaries_it == summaries.end())
+    return nullptr;
+
+  for(const auto &summary : summaries_it->second)
+  {
+    // The calling context includes entry if merging entry into it has no
+    // effect
+    std::unique_ptr<statet> context = make_temporary_state(*summary.entry);
+    if(!domain_factory->merge(*context, entry, p_call, p_begin))
+      return &summary;
+  }
+
+  return nullptr;
+}
+
+const ai_summary_interproceduralt::summaryt &
+ai_summary_interproceduralt::compute_summary(
+  const irep_idt &callee_function_id,
+  std::unique_ptr<statet> entry,
+  trace_ptrt p_begin,
+  const goto_programt &callee,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  ++summaries_computed;
+
+  summaryt summary;
+  std::unique_ptr<ai_storage_baset> summary_storage =
+    util_make_unique<summary_storaget>();
+
+  {
+    // Everything the callee (and the functions it calls) computes goes into
+    // the storage of the summary
+    scoped_storage_swapt swap(storage, summary_storage);
+
+    domain_factory->merge(get_state(p_begin), *entry, p_begin, p_begin);
+    fixedpoint(p_begin, callee_function_id, callee, goto_functions, ns);
+
+    locationt l_end = std::prev(callee.instructions.end());
+    DATA_INVARIANT(
+      l_end->is_end_function(),
+      "The last instruction of a goto_program must be END_FUNCTION");
+
+    const auto end_traces = storage->abstract_traces_before(l_end);
+    auto exit = storage->abstract_state_before(l_end, *domain_factory);
+    if(!end_traces->empty() && !exit->is_bottom())
+    {
+      summary.end_trace = *end_traces->begin();
+      summary.exit = make_temporary_state(*exit);
+    }
+  }
+
+  // The per-location results are the join over all calling contexts
+  const auto &states =
+    static_cast<const summary_storaget &>(*summary_storage).states();
+  for(const auto &state : states)
+  {
+    trace_ptrt p = history_factory->epoch(state.first);
+    domain_factory->merge(get_state(p), *state.second, p, p);
+  }
+
+  summary.entry = std::move(entry);
+
+  auto &function_summaries = summaries[callee_function_id];
+  function_summaries.push_back(std::move(summary));
+  return function_summaries.back();
+}
+
+bool ai_summary_interproceduralt::visit_return_edge(
+  const irep_idt &callee_function_id,
+  const summaryt &summary,
+  const irep_idt &calling_function_id,
+  locationt l_return,
+  trace_ptrt p_call,
+  const namespacet &ns,
+  working_sett &working_set)
+{
+  // The function does not return in this calling context
+  if(summary.end_trace == nullptr)
+    return false;
+
+  auto next = summary.end_trace->step(
+    l_return, *(storage->abstract_traces_before(l_return)), p_call);
+  if(next.first == ai_history_baset::step_statust::BLOCKED)
+    return false;
+  trace_ptrt to_p = next.second;
+
+  std::unique_ptr<statet> new_values = make_temporary_state(*summary.exit);
+  ++statistics.transformers;
+  new_values->transform(
+    callee_function_id,
+    summary.end_trace,
+    calling_function_id,
+    to_p,
+    *this,
+    ns);
+
+  if(
+    merge(*new_values, summary.end_trace, to_p) ||
+    (next.first == ai_history_baset::step_statust::NEW &&
+     !new_values->is_bottom()))
+  {
+    put_in_working_set(working_set, to_p);
+    return true;
+  }
+
+  return false;
+}
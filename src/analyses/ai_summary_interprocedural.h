@@ -0,0 +1,152 @@
+/*******************************************************************\
+
+Module: Abstract Interpretation
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// An abstract interpreter that handles function calls using summaries that
+/// are computed once per calling context and reused at every call site that
+/// reaches the function in the same (or a smaller) abstract state.
+
+#ifndef CPROVER_ANALYSES_AI_SUMMARY_INTERPROCEDURAL_H
+#define CPROVER_ANALYSES_AI_SUMMARY_INTERPROCEDURAL_H
+
+#include "ai.h"
+
+#include <unordered_map>
+#include <vector>
+
+/// Interprocedural analysis using function summaries.
+///
+/// A summary of a function is a pair of abstract states: the state at the
+/// head of the function (the calling context) and the state at its
+/// END_FUNCTION.  It is computed by analysing the body of the function in a
+/// fresh storage, starting from the calling context alone, so unlike
+/// ai_recursive_interproceduralt the results for one call site are not
+/// polluted by the others.  Whenever a call reaches the function in a state
+/// that is included in the calling context of an existing summary, the body
+/// is not analysed again and the exit state of that summary is used for the
+/// return edge instead.
+///
+/// Summaries are only used for calls between different strongly connected
+/// components of the call graph; calls within a component (i.e. recursion)
+/// are handled as in ai_recursive_interproceduralt, within the storage of the
+/// enclosing summary.  The per-location results, as returned by
+/// abstract_state_before, are the join over all calling contexts.
+///
+/// Calling contexts are distinguished by the summaries, so this is intended
+/// to be used with ahistoricalt and location_sensitive_storaget.
+class ai_summary_interproceduralt : public ai_recursive_interproceduralt
+{
+public:
+  /// \param hf: history factory
+  /// \param df: domain factory
+  /// \param st: storage for the per-location results
+  /// \param max_contexts: maximum number of summaries per function; further
+  ///   calling contexts are handled as in ai_recursive_interproceduralt.
+  ///   Zero means no limit.
+  ai_summary_interproceduralt(
+    std::unique_ptr<ai_history_factory_baset> &&hf,
+    std::unique_ptr<ai_domain_factory_baset> &&df,
+    std::unique_ptr<ai_storage_baset> &&st,
+    std::size_t max_contexts = 0)
+    : ai_recursive_interproceduralt(
+        std::move(hf),
+        std::move(df),
+        std::move(st)),
+      max_contexts(max_contexts),
+      summaries_computed(0),
+      summaries_reused(0)
+  {
+  }
+
+  void clear() override
+  {
+    ai_recursive_interproceduralt::clear();
+    summaries.clear();
+    summaries_computed = 0;
+    summaries_reused = 0;
+  }
+
+  /// Number of times a function body was analysed for a new calling context
+  std::size_t get_summaries_computed() const
+  {
+    return summaries_computed;
+  }
+
+  /// Number of calls that were handled by an existing summary
+  std::size_t get_summaries_reused() const
+  {
+    return summaries_reused;
+  }
+
+protected:
+  void initialize(const goto_functionst &goto_functions) override;
+
+  bool visit_edge_function_call(
+    const irep_idt &calling_function_id,
+    trace_ptrt p_call,
+    locationt l_return,
+    const irep_idt &callee_function_id,
+    working_sett &working_set,
+    const goto_programt &callee,
+    const goto_functionst &goto_functions,
+    const namespacet &ns) override;
+
+  struct summaryt
+  {
+    /// The abstract state at the head of the function
+    std::unique_ptr<statet> entry;
+    /// The history at the END_FUNCTION of the function, nullptr if the end of
+    /// the function is unreachable in this calling context
+    trace_ptrt end_trace;
+    /// The abstract state before the END_FUNCTION of the function
+    std::unique_ptr<statet> exit;
+  };
+
+  /// Find a summary of \p callee_function_id whose calling context includes
+  /// \p entry, flowing from \p p_call to \p p_begin
+  const summaryt *find_summary(
+    const irep_idt &callee_function_id,
+    const statet &entry,
+    trace_ptrt p_call,
+    trace_ptrt p_begin);
+
+  /// Analyse \p callee in the calling context \p entry, the state at history
+  /// \p p_begin, and record the result
+  const summaryt &compute_summary(
+    const irep_idt &callee_function_id,
+    std::unique_ptr<statet> entry,
+    trace_ptrt p_begin,
+    const goto_programt &callee,
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  /// Apply the transformer of the edge from the end of the callee to the
+  /// return site to the exit state of \p summary
+  bool visit_return_edge(
+    const irep_idt &callee_function_id,
+    const summaryt &summary,
+    const irep_idt &calling_function_id,
+    locationt l_return,
+    trace_ptrt p_call,
+    const namespacet &ns,
+    working_sett &working_set);
+
+  const std::size_t max_contexts;
+
+  typedef std::unordered_map<irep_idt, std::vector<summaryt>, irep_id_hash>
+    summariest;
+  summariest summaries;
+
+  /// Strongly connected component of the call graph of each function
+  std::unordered_map<irep_idt, std::size_t, irep_id_hash> call_graph_scc;
+
+  std::size_t summaries_computed;
+  std::size_t summaries_reused;
+};
+
+#endif // CPROVER_ANALYSES_AI_SUMMARY_INTERPROCEDURAL_H
@@ -59,7 +59,8 @@ void constant_propagator_domaint::assign_rec(
   if(lhs.id() == ID_dereference)
   {
     exprt eval_lhs = lhs;
-    if(partial_evaluate(dest_values, eval_lhs, ns))
+    if(partial_evaluate(
+         dest_values, eval_lhs, ns, cp ? &cp->simplify_cache : nullptr))
     {
       if(is_assignment)
       {
@@ -97,7 +98,8 @@ void constant_propagator_domaint::assign_rec(
     const symbol_exprt &s = to_symbol_expr(lhs);
 
     exprt tmp = rhs;
-    partial_evaluate(dest_values, tmp, ns);
+    partial_evaluate(
+      dest_values, tmp, ns, cp ? &cp->simplify_cache : nullptr);
 
     if(dest_values.is_constant(tmp))
     {
@@ -183,7 +185,7 @@ void constant_propagator_domaint::transform(
       g = from->get_condition();
     else
       g = not_exprt(from->get_condition());
-    partial_evaluate(values, g, ns);
+    partial_evaluate(values, g, ns, cp ? &cp->simplify_cache : nullptr);
     if(g.is_false())
      values.set_to_bottom();
     else
@@ -651,19 +653,25 @@ bool constant_propagator_domaint::merge(
 /// \param known_values: The constant values under which to evaluate \p expr
 /// \param expr: The expression to evaluate
 /// \param ns: The namespace for symbols in the expression
+/// \param simplify_cache: Results of earlier simplifications to reuse, if any
 /// \return True if the expression is unchanged, false otherwise
 bool constant_propagator_domaint::partial_evaluate(
   const valuest &known_values,
   exprt &expr,
-  const namespacet &ns)
+  const namespacet &ns,
+  simplify_expr_cachet *simplify_cache)
 {
   // if the current rounding mode is top we can
   // still get a non-top result by trying all rounding
   // modes and checking if the results are all the same
   if(!known_values.is_constant(ID_cprover_rounding_mode_str))
-    return partial_evaluate_with_all_rounding_modes(known_values, expr, ns);
+  {
+    return partial_evaluate_with_all_rounding_modes(
+      known_values, expr, ns, simplify_cache);
+  }
 
-  return replace_constants_and_simplify(known_values, expr, ns);
+  return replace_constants_and_simplify(
+    known_values, expr, ns, simplify_cache);
 }
 
 /// Attempt to evaluate an expression in all rounding modes.
@@ -671,12 +679,14 @@ bool constant_propagator_domaint::partial_evaluate(
 /// \param known_values: The constant values under which to evaluate \p expr
 /// \param expr: The expression to evaluate
 /// \param ns: The namespace for symbols in the expression
+/// \param simplify_cache: Results of earlier simplifications to reuse, if any
 /// \return If the result is the same for all rounding modes, change
 ///   expr to that result and return false. Otherwise, return true.
 bool constant_propagator_domaint::partial_evaluate_with_all_rounding_modes(
   const valuest &known_values,
   exprt &expr,
-  const namespacet &ns)
+  const namespacet &ns,
+  simplify_expr_cachet *simplify_cache)
 { // NOLINTNEXTLINE (whitespace/braces)
   auto rounding_modes = std::array<ieee_floatt::rounding_modet, 4>{
     // NOLINTNEXTLINE (whitespace/braces)
@@ -693,7 +703,8 @@ bool constant_propagator_domaint::partial_evaluate_with_all_rounding_modes(
       symbol_exprt(ID_cprover_rounding_mode_str, integer_typet()),
       from_integer(rounding_modes[i], integer_typet()));
     exprt result = expr;
-    if(replace_constants_and_simplify(tmp_values, result, ns))
+    if(replace_constants_and_simplify(
+         tmp_values, result, ns, simplify_cache))
     {
       return true;
     }
@@ -710,10 +721,23 @@ bool constant_propagator_domaint::partial_evaluate_with_all_rounding_modes(
   return false;
 }
 
+/// Simplify \p expr, using \p simplify_cache unless it is null
+static bool simplify_cached(
+  exprt &expr,
+  const namespacet &ns,
+  simplify_expr_cachet *simplify_cache)
+{
+  if(simplify_cache == nullptr)
+    return simplify(expr, ns);
+  else
+    return simplify(expr, ns, *simplify_cache);
+}
+
 bool constant_propagator_domaint::replace_constants_and_simplify(
   const valuest &known_values,
   exprt &expr,
-  const namespacet &ns)
+  const namespacet &ns,
+  simplify_expr_cachet *simplify_cache)
 {
   bool did_not_change_anything = true;
 
@@ -726,13 +750,13 @@ bool constant_propagator_domaint::replace_constants_and_simplify(
   while(!known_values.replace_const.replace(expr))
   {
     did_not_change_anything = false;
-    simplify(expr, ns);
+    simplify_cached(expr, ns, simplify_cache);
   }
 
   // even if we haven't been able to constant-propagate anything, run the
   // simplifier on the expression
   if(did_not_change_anything)
-    did_not_change_anything &= simplify(expr, ns);
+    did_not_change_anything &= simplify_cached(expr, ns, simplify_cache);
 
   return did_not_change_anything;
 }
@@ -764,15 +788,19 @@ void constant_propagator_ait::replace(
     {
       exprt c = it->get_condition();
       replace_types_rec(d.values.replace_const, c);
-      if(!constant_propagator_domaint::partial_evaluate(d.values, c, ns))
+      if(!constant_propagator_domaint::partial_evaluate(
+           d.values, c, ns, &simplify_cache))
+      {
         it->set_condition(c);
+      }
     }
     else if(it->is_assign())
     {
       auto assign = it->get_assign();
       exprt &rhs = assign.rhs();
 
-      if(!constant_propagator_domaint::partial_evaluate(d.values, rhs, ns))
+      if(!constant_propagator_domaint::partial_evaluate(
+           d.values, rhs, ns, &simplify_cache))
       {
         if(rhs.id() == ID_constant)
           rhs.add_source_location() = assign.lhs().source_location();
@@ -786,14 +814,19 @@ void constant_propagator_ait::replace(
       bool call_changed = false;
 
       if(!constant_propagator_domaint::partial_evaluate(
-           d.values, call.function(), ns))
+           d.values, call.function(), ns, &simplify_cache))
       {
         call_changed = true;
       }
 
       for(auto &arg : call.arguments())
-        if(!constant_propagator_domaint::partial_evaluate(d.values, arg, ns))
+      {
+        if(!constant_propagator_domaint::partial_evaluate(
+             d.values, arg, ns, &simplify_cache))
+        {
           call_changed = true;
+        }
+      }
 
       if(call_changed)
         it->set_function_call(call);
@@ -804,7 +837,7 @@ void constant_propagator_ait::replace(
       {
         auto c = to_code_expression(it->get_other());
         if(!constant_propagator_domaint::partial_evaluate(
-             d.values, c.expression(), ns))
+             d.values, c.expression(), ns, &simplify_cache))
         {
           it->set_other(c);
         }
@@ -24,6 +24,7 @@ Author: Peter Schrammel
 
 #include <iosfwd>
 #include <util/replace_symbol.h>
+#include <util/simplify_expr_cache.h>
 
 #include "ai.h"
 #include "dirty.h"
@@ -140,7 +141,8 @@ public:
   static bool partial_evaluate(
     const valuest &known_values,
     exprt &expr,
-    const namespacet &ns);
+    const namespacet &ns,
+    simplify_expr_cachet *simplify_cache = nullptr);
 
 protected:
   static void assign_rec(
@@ -159,12 +161,14 @@ protected:
   static bool partial_evaluate_with_all_rounding_modes(
     const valuest &known_values,
     exprt &expr,
-    const namespacet &ns);
+    const namespacet &ns,
+    simplify_expr_cachet *simplify_cache);
 
   static bool replace_constants_and_simplify(
     const valuest &known_values,
     exprt &expr,
-    const namespacet &ns);
+    const namespacet &ns,
+    simplify_expr_cachet *simplify_cache);
 };
 
 class constant_propagator_ait:public ait<constant_propagator_domaint>
@@ -221,6 +225,11 @@ public:
 protected:
   friend class constant_propagator_domaint;
 
+  /// The same expressions are simplified each time a location is revisited
+  /// until the fixed point is reached, so keep the results. This does not
+  /// affect the abstract states, hence mutable.
+  mutable simplify_expr_cachet simplify_cache;
+
   void replace(
     goto_functionst::goto_functiont &,
     const namespacet &);
@@ -269,6 +269,14 @@ public:
     return rd;
   }
 
+  /// Set how the reaching definitions, which the data dependencies are
+  /// computed from, reach a fixed point over threads
+  void set_concurrency_mode(
+    reaching_definitions_analysist::concurrency_modet concurrency_mode)
+  {
+    rd.set_concurrency_mode(concurrency_mode);
+  }
+
 protected:
   friend dep_graph_domain_factoryt;
   friend dep_graph_domaint;
@@ -31,6 +31,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/pointer_predicates.h>
 #include <util/prefix.h>
 #include <util/simplify_expr.h>
+#include <util/simplify_expr_cache.h>
 #include <util/std_expr.h>
 #include <util/std_types.h>
 
@@ -263,6 +264,9 @@ protected:
   bool enable_undefined_shift_check;
   bool enable_float_overflow_check;
   bool enable_simplify;
+  /// The same checks are generated for many instructions, so keep the results
+  /// of simplifying them
+  simplify_expr_cachet simplify_cache;
   bool enable_nan_check;
   bool retain_trivial;
   bool enable_assert_to_assume;
@@ -1521,7 +1525,8 @@ void goto_checkt::add_guarded_property(
 {
   // first try simplifier on it
   exprt simplified_expr =
-    enable_simplify ? simplify_expr(asserted_expr, ns) : asserted_expr;
+    enable_simplify ? simplify_expr(asserted_expr, ns, simplify_cache)
+                    : asserted_expr;
 
   // throw away trivial properties?
   if(!retain_trivial && simplified_expr.is_true())
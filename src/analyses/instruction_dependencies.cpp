@@ -0,0 +1,281 @@
+/*******************************************************************\
+
+Module: Instruction Dependencies
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Dependencies between instructions, extracted from a program dependence
+/// graph so that they can be stored and reused
+
+#include "instruction_dependencies.h"
+
+#include <util/json.h>
+#include <util/string2int.h>
+#include <util/symbol_table.h>
+
+#include "dependence_graph.h"
+
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+
+const instruction_dependenciest::locationst
+  instruction_dependenciest::no_dependencies;
+
+/// Version of the JSON written by \ref instruction_dependenciest::output_json,
+/// to be increased whenever its format or the analysis changes
+static const char *const dependencies_format_version = "1";
+
+// FNV-1a, which, unlike irep_hash, does not depend on the order in which
+// strings were first seen in a run
+
+static void stable_hash(std::uint64_t &hash, const std::string &s)
+{
+  for(const char c : s)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  }
+  // separate consecutive strings
+  hash ^= 0xff;
+  hash *= 1099511628211ull;
+}
+
+static void stable_hash(std::uint64_t &hash, std::size_t n)
+{
+  stable_hash(hash, std::to_string(n));
+}
+
+static void stable_hash(std::uint64_t &hash, const irept &irep)
+{
+  stable_hash(hash, irep.id_string());
+
+  stable_hash(hash, irep.get_sub().size());
+  for(const auto &sub : irep.get_sub())
+    stable_hash(hash, sub);
+
+  for(const auto &named_sub : irep.get_named_sub())
+  {
+    // source locations and other annotations do not affect dependencies
+    if(irept::is_comment(named_sub.first))
+      continue;
+
+    stable_hash(hash, id2string(named_sub.first));
+    stable_hash(hash, named_sub.second);
+  }
+}
+
+static std::string to_hex(std::uint64_t hash)
+{
+  std::ostringstream result;
+  result << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return result.str();
+}
+
+static std::string types_hash(const symbol_tablet &symbol_table)
+{
+  std::uint64_t hash = 14695981039346656037ull;
+
+  // symbol tables are unordered
+  std::map<irep_idt, const symbolt *> types;
+  for(const auto &symbol : symbol_table.symbols)
+  {
+    if(symbol.second.is_type)
+      types.emplace(symbol.first, &symbol.second);
+  }
+
+  for(const auto &type : types)
+  {
+    stable_hash(hash, id2string(type.first));
+    stable_hash(hash, type.second->type);
+  }
+
+  return to_hex(hash);
+}
+
+std::string instruction_dependenciest::content_hash(const goto_programt &body)
+{
+  std::unordered_map<
+    goto_programt::const_targett,
+    std::size_t,
+    const_target_hash,
+    pointee_address_equalt>
+    index;
+  std::size_t next_index = 0;
+  forall_goto_program_instructions(i_it, body)
+    index.emplace(i_it, next_index++);
+
+  std::uint64_t hash = 14695981039346656037ull;
+
+  for(const auto &instruction : body.instructions)
+  {
+    stable_hash(hash, static_cast<std::size_t>(instruction.type));
+    stable_hash(hash, instruction.code);
+    stable_hash(hash, instruction.guard);
+
+    stable_hash(hash, instruction.targets.size());
+    for(const auto &target : instruction.targets)
+      stable_hash(hash, index.at(target));
+  }
+
+  return to_hex(hash);
+}
+
+void instruction_dependenciest::set_program(
+  const goto_functionst &goto_functions)
+{
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    function_hashes[gf_entry.first] = content_hash(gf_entry.second.body);
+
+    locationst &function_instructions = instructions[gf_entry.first];
+    forall_goto_program_instructions(i_it, gf_entry.second.body)
+      function_instructions.push_back(i_it);
+  }
+}
+
+instruction_dependenciest::instruction_dependenciest(
+  const goto_functionst &goto_functions,
+  const dependence_grapht &dependence_graph)
+{
+  set_program(goto_functions);
+
+  for(dependence_grapht::node_indext i = 0; i < dependence_graph.size(); ++i)
+  {
+    const auto &node = dependence_graph[i];
+    if(node.in.empty())
+      continue;
+
+    locationst &dependencies = dependencies_of[node.PC];
+    for(const auto &edge : node.in)
+      dependencies.push_back(dependence_graph[edge.first].PC);
+  }
+}
+
+jsont instruction_dependenciest::output_json(
+  const symbol_tablet &symbol_table) const
+{
+  // position of each instruction in its function
+  std::unordered_map<
+    locationt,
+    std::pair<irep_idt, std::size_t>,
+    const_target_hash,
+    pointee_address_equalt>
+    positions;
+  for(const auto &function : instructions)
+  {
+    for(std::size_t i = 0; i < function.second.size(); ++i)
+    {
+      positions.emplace(
+        function.second[i], std::make_pair(function.first, i));
+    }
+  }
+
+  json_objectt functions;
+  for(const auto &function : instructions)
+  {
+    json_arrayt dependencies;
+
+    for(std::size_t i = 0; i < function.second.size(); ++i)
+    {
+      for(const auto &dependency : this->dependencies(function.second[i]))
+      {
+        const auto &position = positions.at(dependency);
+        dependencies.push_back(json_arrayt{
+          json_numbert(std::to_string(i)),
+          json_stringt(position.first),
+          json_numbert(std::to_string(position.second))});
+      }
+    }
+
+    functions[id2string(function.first)] = json_objectt{
+      {"hash", json_stringt(function_hashes.at(function.first))},
+      {"dependencies", std::move(dependencies)}};
+  }
+
+  return json_objectt{{"version", json_stringt(dependencies_format_version)},
+                      {"types", json_stringt(types_hash(symbol_table))},
+                      {"functions", std::move(functions)}};
+}
+
+optionalt<instruction_dependenciest> instruction_dependenciest::from_json(
+  const jsont &json,
+  const goto_functionst &goto_functions,
+  const symbol_tablet &symbol_table,
+  std::vector<irep_idt> &changed_functions)
+{
+  instruction_dependenciest result;
+  result.set_program(goto_functions);
+
+  if(
+    !json.is_object() ||
+    json["version"].value != dependencies_format_version ||
+    !json["functions"].is_object())
+  {
+    return {};
+  }
+
+  const json_objectt &functions = to_json_object(json["functions"]);
+
+  for(const auto &function : result.function_hashes)
+  {
+    const jsont &stored = functions[id2string(function.first)];
+    if(!stored.is_object() || stored["hash"].value != function.second)
+      changed_functions.push_back(function.first);
+  }
+
+  for(const auto &stored : functions)
+  {
+    if(result.function_hashes.count(stored.first) == 0)
+      changed_functions.push_back(stored.first);
+  }
+
+  if(
+    !changed_functions.empty() ||
+    json["types"].value != types_hash(symbol_table))
+  {
+    return {};
+  }
+
+  // look up an instruction by its function and position
+  auto instruction = [&](const irep_idt &function, const jsont &position)
+    -> optionalt<locationt> {
+    const auto entry = result.instructions.find(function);
+    const auto i = string2optional_size_t(position.value);
+    if(
+      entry == result.instructions.end() || !i.has_value() ||
+      *i >= entry->second.size())
+    {
+      return {};
+    }
+    return entry->second[*i];
+  };
+
+  for(const auto &function : functions)
+  {
+    const jsont &dependencies = function.second["dependencies"];
+    if(!dependencies.is_array())
+      return {};
+
+    for(const auto &dependency : to_json_array(dependencies))
+    {
+      if(!dependency.is_array() || to_json_array(dependency).size() != 3)
+        return {};
+
+      auto element = to_json_array(dependency).begin();
+      const auto to = instruction(function.first, *element);
+      const irep_idt from_function = (++element)->value;
+      const auto from = instruction(from_function, *++element);
+
+      if(!to.has_value() || !from.has_value())
+        return {};
+
+      result.dependencies_of[*to].push_back(*from);
+    }
+  }
+
+  return std::move(result);
+}
@@ -0,0 +1,100 @@
+/*******************************************************************\
+
+Module: Instruction Dependencies
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Dependencies between instructions, extracted from a program dependence
+/// graph so that they can be stored and reused
+
+#ifndef CPROVER_ANALYSES_INSTRUCTION_DEPENDENCIES_H
+#define CPROVER_ANALYSES_INSTRUCTION_DEPENDENCIES_H
+
+#include <util/optional.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+class dependence_grapht;
+class jsont;
+class symbol_tablet;
+
+/// The control and data dependencies of each instruction, as computed by
+/// \ref dependence_grapht, without the abstract states they were computed
+/// from.  These are all a slicer needs, and unlike the dependence graph they
+/// can be written to JSON and read back by a later run on the same program,
+/// which then does not need to run the analysis again.
+///
+/// Instructions are identified in JSON by function and position in the
+/// function body.  Each function is stored with a hash of its body, and the
+/// dependencies are only read back if no function has changed: the data
+/// dependencies of a function may be affected by a change to any other.
+class instruction_dependenciest
+{
+public:
+  typedef goto_programt::const_targett locationt;
+  typedef std::vector<locationt> locationst;
+
+  /// Extract the dependencies from \p dependence_graph, which must have been
+  /// computed for \p goto_functions
+  instruction_dependenciest(
+    const goto_functionst &goto_functions,
+    const dependence_grapht &dependence_graph);
+
+  /// The instructions that the one at \p location depends on
+  const locationst &dependencies(locationt location) const
+  {
+    const auto entry = dependencies_of.find(location);
+    return entry == dependencies_of.end() ? no_dependencies : entry->second;
+  }
+
+  /// \param symbol_table: the symbol table of the functions, whose types are
+  ///   stored as a hash as well
+  jsont output_json(const symbol_tablet &symbol_table) const;
+
+  /// Read dependencies written by \ref output_json for the same program.
+  /// \param json: the output of \ref output_json
+  /// \param goto_functions: the functions the dependencies are for
+  /// \param symbol_table: the symbol table of \p goto_functions
+  /// \param [out] changed_functions: the functions that were added, removed
+  ///   or changed since \p json was written
+  /// \return the dependencies, or an empty optional if \p json was written
+  ///   for a different program
+  static optionalt<instruction_dependenciest> from_json(
+    const jsont &json,
+    const goto_functionst &goto_functions,
+    const symbol_tablet &symbol_table,
+    std::vector<irep_idt> &changed_functions);
+
+  /// A hash of \p body that is the same in all runs and only changes if the
+  /// instructions do, not if only their source locations do
+  static std::string content_hash(const goto_programt &body);
+
+protected:
+  instruction_dependenciest() = default;
+
+  std::unordered_map<
+    locationt,
+    locationst,
+    const_target_hash,
+    pointee_address_equalt>
+    dependencies_of;
+
+  /// Hash of each function body
+  std::map<irep_idt, std::string> function_hashes;
+
+  /// Each instruction, by function and position in the body
+  std::map<irep_idt, locationst> instructions;
+
+  static const locationst no_dependencies;
+
+  void set_program(const goto_functionst &goto_functions);
+};
+
+#endif // CPROVER_ANALYSES_INSTRUCTION_DEPENDENCIES_H
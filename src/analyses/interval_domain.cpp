@@ -16,7 +16,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <langapi/language_util.h>
 #endif
 
+#include <util/expr_util.h>
 #include <util/simplify_expr.h>
+#include <util/std_types.h>
 #include <util/std_expr.h>
 #include <util/arith_tools.h>
 
@@ -137,6 +139,33 @@ void interval_domaint::transform(
     DATA_INVARIANT(false, "Only complete instructions can be analyzed");
     break;
   }
+
+  const auto dirty_aware = dynamic_cast<dirty_aware_interval_ait *>(&ai);
+  if(dirty_aware == nullptr)
+    return;
+
+  // instructions that may write to any address-taken variable, including
+  // calls of functions without a body (the only calls with an edge to the
+  // next instruction), which may write through their pointer arguments
+  if(
+    (instruction.is_assign() &&
+     has_subexpr(instruction.get_assign().lhs(), ID_dereference)) ||
+    (instruction.is_function_call() &&
+     (has_subexpr(instruction.get_function_call().lhs(), ID_dereference) ||
+      (function_from == function_to && to == std::next(from)))) ||
+    instruction.is_other())
+  {
+    havoc_dirty(dirty_aware->dirty);
+  }
+}
+
+void interval_domaint::havoc_dirty(const dirtyt &dirty)
+{
+  for(const auto &identifier : dirty.get_dirty_ids())
+  {
+    int_map.erase(identifier);
+    float_map.erase(identifier);
+  }
 }
 
 /// Sets *this to the mathematical join between the two domains. This can be
@@ -237,14 +266,57 @@ void interval_domaint::havoc_rec(const exprt &lhs)
   }
 }
 
+/// \return true if \p typecast yields the value of its operand for all
+///   values of the operand's type, so that its interval is the same
+static bool is_value_preserving(const typecast_exprt &typecast)
+{
+  const typet &from = typecast.op().type();
+  const typet &to = typecast.type();
+
+  if(from == to)
+    return true;
+
+  if(interval_domaint::is_int(from) && interval_domaint::is_int(to))
+  {
+    const std::size_t from_width = to_bitvector_type(from).get_width();
+    const std::size_t to_width = to_bitvector_type(to).get_width();
+
+    if(from.id() == to.id())
+      return to_width >= from_width;
+
+    // only a wider signed type can hold all unsigned values
+    return from.id() == ID_unsignedbv && to_width > from_width;
+  }
+
+  if(interval_domaint::is_float(from) && interval_domaint::is_float(to))
+  {
+    const floatbv_typet &from_float = to_floatbv_type(from);
+    const floatbv_typet &to_float = to_floatbv_type(to);
+    return to_float.get_e() >= from_float.get_e() &&
+           to_float.get_f() >= from_float.get_f();
+  }
+
+  return false;
+}
+
 void interval_domaint::assume_rec(
   const exprt &lhs, irep_idt id, const exprt &rhs)
 {
+  // a conversion that may change the value, for example by truncation,
+  // tells us nothing about its operand
   if(lhs.id()==ID_typecast)
+  {
+    if(!is_value_preserving(to_typecast_expr(lhs)))
+      return;
     return assume_rec(to_typecast_expr(lhs).op(), id, rhs);
+  }
 
   if(rhs.id()==ID_typecast)
+  {
+    if(!is_value_preserving(to_typecast_expr(rhs)))
+      return;
     return assume_rec(lhs, id, to_typecast_expr(rhs).op());
+  }
 
   if(id==ID_equal)
   {
@@ -17,6 +17,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/interval_template.h>
 
 #include "ai.h"
+#include "dirty.h"
 
 typedef interval_templatet<ieee_floatt> ieee_float_intervalt;
 
@@ -126,6 +127,24 @@ protected:
   void assign(const class code_assignt &assignment);
   integer_intervalt get_int_rec(const exprt &);
   ieee_float_intervalt get_float_rec(const exprt &);
+
+  /// Forget the intervals of all variables in \p dirty
+  void havoc_dirty(const dirtyt &dirty);
+};
+
+/// Interval analysis that also accounts for writes through pointers, calls of
+/// functions without a body and instructions of type OTHER, by forgetting the
+/// intervals of all variables whose address is taken (see \ref dirtyt).
+/// `ait<interval_domaint>` assumes these have no effect.
+class dirty_aware_interval_ait : public ait<interval_domaint>
+{
+public:
+  explicit dirty_aware_interval_ait(const goto_functionst &goto_functions)
+    : dirty(goto_functions)
+  {
+  }
+
+  const dirtyt dirty;
 };
 
 #endif // CPROVER_ANALYSES_INTERVAL_DOMAIN_H
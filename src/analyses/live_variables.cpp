@@ -0,0 +1,223 @@
+/*******************************************************************\
+
+Module: Live Variables
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Live local variables of each function
+
+#include "live_variables.h"
+
+#include "dirty.h"
+
+#include <util/find_symbols.h>
+
+const live_variablest::variablest live_variablest::no_variables;
+
+live_variablest::live_variablest(const goto_functionst &goto_functions)
+{
+  const dirtyt dirty(goto_functions);
+
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    if(gf_entry.second.body_available())
+      build(gf_entry.second, dirty);
+  }
+}
+
+void live_variablest::build(
+  const goto_functiont &goto_function,
+  const dirtyt &dirty)
+{
+  const goto_programt &body = goto_function.body;
+
+  // Number the variables that are tracked
+  variablest variables;
+  std::unordered_map<irep_idt, std::size_t> numbers;
+  auto add_variable = [&](const irep_idt &identifier) {
+    if(
+      !identifier.empty() && !dirty(identifier) &&
+      numbers.emplace(identifier, variables.size()).second)
+    {
+      variables.push_back(identifier);
+    }
+  };
+
+  for(const auto &identifier : goto_function.parameter_identifiers)
+    add_variable(identifier);
+  const std::size_t number_of_parameters = variables.size();
+
+  for(const auto &instruction : body.instructions)
+  {
+    if(instruction.is_decl())
+      add_variable(instruction.get_decl().get_identifier());
+  }
+
+  if(variables.empty())
+    return;
+
+  // Number the instructions
+  std::vector<locationt> instructions;
+  std::unordered_map<
+    locationt,
+    std::size_t,
+    const_target_hash,
+    pointee_address_equalt>
+    instruction_numbers;
+  forall_goto_program_instructions(it, body)
+  {
+    instruction_numbers.emplace(it, instructions.size());
+    instructions.push_back(it);
+  }
+
+  typedef std::vector<bool> sett;
+  const sett empty_set(variables.size(), false);
+  std::vector<sett> use(instructions.size(), empty_set);
+  std::vector<sett> def(instructions.size(), empty_set);
+  std::vector<std::vector<std::size_t>> successors(instructions.size());
+
+  auto add = [&](sett &dest, const exprt &expr) {
+    for(const auto &identifier : find_symbol_identifiers(expr))
+    {
+      const auto number = numbers.find(identifier);
+      if(number != numbers.end())
+        dest[number->second] = true;
+    }
+  };
+
+  for(std::size_t i = 0; i < instructions.size(); ++i)
+  {
+    const auto &instruction = *instructions[i];
+
+    auto add_lhs = [&](const exprt &lhs) {
+      // Writing part of a variable keeps the rest of its value
+      if(lhs.id() == ID_symbol)
+        add(def[i], lhs);
+      else
+        add(use[i], lhs);
+    };
+
+    switch(instruction.type)
+    {
+    case DECL:
+      add(def[i], instruction.get_decl().symbol());
+      break;
+
+    case DEAD:
+      add(def[i], instruction.get_dead().symbol());
+      break;
+
+    case ASSIGN:
+    {
+      const code_assignt &assign = to_code_assign(instruction.code);
+      add_lhs(assign.lhs());
+      add(use[i], assign.rhs());
+      break;
+    }
+
+    case FUNCTION_CALL:
+    {
+      const code_function_callt &call = to_code_function_call(instruction.code);
+      add_lhs(call.lhs());
+      add(use[i], call.function());
+      for(const auto &argument : call.arguments())
+        add(use[i], argument);
+      break;
+    }
+
+    case THROW:
+      // The successors are not known, so anything may be read later
+      use[i].assign(variables.size(), true);
+      break;
+
+    case GOTO:
+    case ASSUME:
+    case ASSERT:
+    case OTHER:
+    case RETURN:
+    case CATCH:
+      add(use[i], instruction.code);
+      add(use[i], instruction.guard);
+      break;
+
+    case SKIP:
+    case START_THREAD:
+    case END_THREAD:
+    case LOCATION:
+    case END_FUNCTION:
+    case ATOMIC_BEGIN:
+    case ATOMIC_END:
+      break;
+
+    case INCOMPLETE_GOTO:
+    case NO_INSTRUCTION_TYPE:
+      UNREACHABLE;
+    }
+
+    for(const auto &successor : body.get_successors(instructions[i]))
+      successors[i].push_back(instruction_numbers.at(successor));
+  }
+
+  // Iterate to the least fixed point, visiting instructions backwards as
+  // liveness flows against the control flow
+  std::vector<sett> live(instructions.size(), empty_set);
+  bool changed = true;
+  while(changed)
+  {
+    changed = false;
+    for(std::size_t i = instructions.size(); i-- > 0;)
+    {
+      sett new_live = use[i];
+      for(const std::size_t successor : successors[i])
+      {
+        for(std::size_t v = 0; v < variables.size(); ++v)
+        {
+          if(live[successor][v] && !def[i][v])
+            new_live[v] = true;
+        }
+      }
+
+      if(new_live != live[i])
+      {
+        live[i].swap(new_live);
+        changed = true;
+      }
+    }
+  }
+
+  std::vector<sett> dying_sets(instructions.size(), empty_set);
+  for(std::size_t i = 0; i < instructions.size(); ++i)
+  {
+    for(const std::size_t successor : successors[i])
+    {
+      for(std::size_t v = 0; v < variables.size(); ++v)
+      {
+        if((live[i][v] || def[i][v]) && !live[successor][v])
+          dying_sets[successor][v] = true;
+      }
+    }
+  }
+
+  // The parameters are written by the call
+  for(std::size_t v = 0; v < number_of_parameters; ++v)
+  {
+    if(!live[0][v])
+      dying_sets[0][v] = true;
+  }
+
+  for(std::size_t i = 0; i < instructions.size(); ++i)
+  {
+    variablest dying_variables;
+    for(std::size_t v = 0; v < variables.size(); ++v)
+    {
+      if(dying_sets[i][v])
+        dying_variables.push_back(variables[v]);
+    }
+
+    if(!dying_variables.empty())
+      dying.emplace(instructions[i], std::move(dying_variables));
+  }
+}
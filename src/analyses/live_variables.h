@@ -0,0 +1,65 @@
+/*******************************************************************\
+
+Module: Live Variables
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Live local variables of each function
+
+#ifndef CPROVER_ANALYSES_LIVE_VARIABLES_H
+#define CPROVER_ANALYSES_LIVE_VARIABLES_H
+
+#include <goto-programs/goto_functions.h>
+
+#include <unordered_map>
+#include <vector>
+
+class dirtyt;
+
+/// Backwards may-liveness of the local variables of each function.
+///
+/// A local variable is live before an instruction if it may be read on some
+/// path from there before it is written, declared or killed.  Function calls
+/// are treated as single instructions: only the arguments and the left hand
+/// side of the call are used by them.  This is sound for the locals whose
+/// address is never taken (see \ref dirtyt), which are therefore the only
+/// variables considered; all others are always treated as live.
+///
+/// Rather than the set of live variables, this records, for each instruction,
+/// the variables that are live before (or written by) one of its predecessors
+/// but not live before the instruction itself.  A non-relational analysis can
+/// forget the values of these when it reaches the instruction, so that it only
+/// stores each value between a definition and its last use.
+class live_variablest
+{
+public:
+  typedef goto_programt::const_targett locationt;
+  typedef std::vector<irep_idt> variablest;
+
+  explicit live_variablest(const goto_functionst &goto_functions);
+
+  /// Local variables that are no longer live when \p l is reached
+  const variablest &dying_at(locationt l) const
+  {
+    const auto entry = dying.find(l);
+    return entry == dying.end() ? no_variables : entry->second;
+  }
+
+protected:
+  typedef std::unordered_map<
+    locationt,
+    variablest,
+    const_target_hash,
+    pointee_address_equalt>
+    dyingt;
+  dyingt dying;
+
+  static const variablest no_variables;
+
+  void build(const goto_functiont &goto_function, const dirtyt &dirty);
+};
+
+#endif // CPROVER_ANALYSES_LIVE_VARIABLES_H
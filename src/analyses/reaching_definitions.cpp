@@ -716,12 +716,15 @@ bool rd_range_domaint::merge_shared(
   locationt,
   const namespacet &ns)
 {
-  // TODO: dirty vars
-#if 0
-  reaching_definitions_analysist *rd=
-    dynamic_cast<reaching_definitions_analysist*>(&ai);
-  assert(rd!=0);
-#endif
+  // domains are only created by reaching_definitions_analysist, which is
+  // their bitvector container
+  const reaching_definitions_analysist &rd =
+    *static_cast<const reaching_definitions_analysist *>(bv_container);
+  // the interference summaries of thread-modular analysis also need to cover
+  // the locals whose address is taken, as other threads may write to them
+  const bool keep_dirty =
+    rd.get_concurrency_mode() ==
+    reaching_definitions_analysist::concurrency_modet::THREAD_MODULAR;
 
   bool changed=has_values.is_false();
   has_values=tvt::unknown();
@@ -731,9 +734,12 @@ bool rd_range_domaint::merge_shared(
   {
     const irep_idt &identifier=value.first;
 
-    if(!ns.lookup(identifier).is_shared()
-       /*&& !rd.get_is_dirty()(identifier)*/)
+    if(
+      !ns.lookup(identifier).is_shared() &&
+      !(keep_dirty && rd.get_is_dirty()(identifier)))
+    {
       continue;
+    }
 
     while(it!=values.end() && it->first<value.first)
       ++it;
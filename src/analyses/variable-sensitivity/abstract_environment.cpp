@@ -311,8 +311,12 @@ bool abstract_environmentt::merge(const abstract_environmentt &env)
       bool object_modified = false;
       abstract_object_pointert new_object = abstract_objectt::merge(
         entry.get_other_map_value(), entry.m, object_modified);
-      modified |= object_modified;
-      map.replace(entry.k, new_object);
+      // Unchanged values are left alone so that the map stays shared
+      if(object_modified)
+      {
+        modified = true;
+        map.replace(entry.k, new_object);
+      }
     }
 
     return modified;
@@ -123,6 +123,7 @@ bool ai_three_way_merget::visit_edge_function_call(
     // Apply transformer
     // This is for an end_function instruction which normally doesn't do much
     // but in VSD it does, so this cannot be omitted.
+    ++statistics.transformers;
     s_working.transform(
       callee_function_id,
       p_callee_end,
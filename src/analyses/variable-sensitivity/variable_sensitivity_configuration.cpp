@@ -40,6 +40,8 @@ vsd_configt vsd_configt::from_options(const optionst &options)
                               ? flow_sensitivityt::insensitive
                               : flow_sensitivityt::sensitive;
 
+  config.sparse = options.get_bool_option("sparse");
+
   return config;
 }
 
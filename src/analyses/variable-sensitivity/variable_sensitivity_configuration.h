@@ -46,6 +46,9 @@ struct vsd_configt
 
   flow_sensitivityt flow_sensitivity;
 
+  /// Forget the values of local variables as soon as they are dead
+  bool sparse;
+
   struct
   {
     bool data_dependency_context;
@@ -70,6 +73,7 @@ struct vsd_configt
       array_abstract_type{ARRAY_INSENSITIVE},
       union_abstract_type{UNION_INSENSITIVE},
       flow_sensitivity{flow_sensitivityt::sensitive},
+      sparse{false},
       context_tracking{false, true},
       advanced_sensitivities{false}
   {
@@ -175,6 +175,13 @@ void variable_sensitivity_domaint::transform(
     throw "unrecognised instruction type";
   }
 
+  if(live_variables != nullptr)
+  {
+    // Values are only needed until their last use
+    for(const irep_idt &identifier : live_variables->dying_at(to))
+      abstract_state.erase(ns.lookup(identifier).symbol_expr());
+  }
+
   DATA_INVARIANT(abstract_state.verify(), "Structural invariant");
 }
 
@@ -69,17 +69,24 @@
 #include <memory>
 
 #include <analyses/ai.h>
+#include <analyses/live_variables.h>
 #include <analyses/variable-sensitivity/abstract_environment.h>
 #include <analyses/variable-sensitivity/variable_sensitivity_configuration.h>
 
 class variable_sensitivity_domaint : public ai_domain_baset
 {
 public:
+  /// \param _object_factory: the factory for the abstract objects
+  /// \param _configuration: the configuration of the domain
+  /// \param _live_variables: if not null, the values of local variables are
+  ///   forgotten (i.e. made top) as soon as they are dead
   explicit variable_sensitivity_domaint(
     variable_sensitivity_object_factory_ptrt _object_factory,
-    const vsd_configt &_configuration)
+    const vsd_configt &_configuration,
+    std::shared_ptr<const live_variablest> _live_variables = nullptr)
     : abstract_state(_object_factory),
-      flow_sensitivity(_configuration.flow_sensitivity)
+      flow_sensitivity(_configuration.flow_sensitivity),
+      live_variables(std::move(_live_variables))
   {
   }
 
@@ -215,6 +222,7 @@ private:
 
   abstract_environmentt abstract_state;
   flow_sensitivityt flow_sensitivity;
+  std::shared_ptr<const live_variablest> live_variables;
 
 #ifdef ENABLE_STATS
 public:
@@ -226,17 +234,27 @@ class variable_sensitivity_domain_factoryt
   : public ai_domain_factoryt<variable_sensitivity_domaint>
 {
 public:
+  /// \param _object_factory: the factory for the abstract objects
+  /// \param _configuration: the configuration of the domain
+  /// \param _live_variables: the live variables of the program, required if
+  ///   the configuration is sparse
   explicit variable_sensitivity_domain_factoryt(
     variable_sensitivity_object_factory_ptrt _object_factory,
-    const vsd_configt &_configuration)
-    : object_factory(_object_factory), configuration(_configuration)
+    const vsd_configt &_configuration,
+    std::shared_ptr<const live_variablest> _live_variables = nullptr)
+    : object_factory(_object_factory),
+      configuration(_configuration),
+      live_variables(std::move(_live_variables))
   {
+    PRECONDITION(!configuration.sparse || live_variables != nullptr);
   }
 
   std::unique_ptr<statet> make(locationt l) const override
   {
     auto d = util_make_unique<variable_sensitivity_domaint>(
-      object_factory, configuration);
+      object_factory,
+      configuration,
+      configuration.sparse ? live_variables : nullptr);
     CHECK_RETURN(d->is_bottom());
     return std::unique_ptr<statet>(d.release());
   }
@@ -244,6 +262,7 @@ public:
 private:
   variable_sensitivity_object_factory_ptrt object_factory;
   const vsd_configt configuration;
+  const std::shared_ptr<const live_variablest> live_variables;
 };
 
 #ifdef ENABLE_STATS
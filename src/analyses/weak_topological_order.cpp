@@ -0,0 +1,255 @@
+/*******************************************************************\
+
+Module: Weak Topological Order
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Weak topological ordering of the instructions of a goto program
+
+#include "weak_topological_order.h"
+
+#include <util/optional.h>
+
+#include "natural_loops.h"
+
+#include <algorithm>
+#include <ostream>
+#include <set>
+
+/// Orders the components of a goto program, innermost last
+class weak_topological_ordert::buildert
+{
+public:
+  buildert(weak_topological_ordert &wto, const goto_programt &goto_program)
+    : wto(wto), goto_program(goto_program)
+  {
+    natural_loops(goto_program);
+
+    std::size_t index = 0;
+    for(auto it = goto_program.instructions.begin();
+        it != goto_program.instructions.end();
+        ++it)
+    {
+      program_index.emplace(it, index++);
+    }
+  }
+
+  /// Append the instructions of \p component, which is either the whole
+  /// program or the natural loop with head \p head, to the order
+  void order_component(
+    const std::set<locationt> &component,
+    const optionalt<locationt> &head,
+    std::size_t depth);
+
+private:
+  weak_topological_ordert &wto;
+  const goto_programt &goto_program;
+  natural_loopst natural_loops;
+  std::unordered_map<
+    locationt,
+    std::size_t,
+    const_target_hash,
+    pointee_address_equalt>
+    program_index;
+};
+
+void weak_topological_ordert::buildert::order_component(
+  const std::set<locationt> &component,
+  const optionalt<locationt> &head,
+  std::size_t depth)
+{
+  if(head.has_value())
+    wto.append(*head, depth, true);
+
+  // The heads of the loops nested in this component, outermost first
+  std::vector<locationt> inner_heads;
+  for(const auto &l : component)
+  {
+    if((!head.has_value() || l != *head) && natural_loops.is_loop_header(l))
+      inner_heads.push_back(l);
+  }
+  std::sort(
+    inner_heads.begin(),
+    inner_heads.end(),
+    [this](const locationt &a, const locationt &b) {
+      const std::size_t size_a = natural_loops.loop_map.at(a).size();
+      const std::size_t size_b = natural_loops.loop_map.at(b).size();
+      return size_a > size_b ||
+             (size_a == size_b && program_index.at(a) < program_index.at(b));
+    });
+
+  // Each instruction belongs to a unit: either the outermost loop nested in
+  // this component that contains it, represented by the head of the loop, or
+  // the instruction itself
+  std::unordered_map<
+    locationt,
+    locationt,
+    const_target_hash,
+    pointee_address_equalt>
+    unit_of;
+  std::set<locationt> loop_units;
+  for(const auto &inner_head : inner_heads)
+  {
+    if(unit_of.count(inner_head) != 0)
+      continue;
+
+    const auto &loop = natural_loops.loop_map.at(inner_head);
+    const bool nested = std::all_of(
+      loop.begin(), loop.end(), [&component](const locationt &l) {
+        return component.count(l) != 0;
+      });
+    if(!nested)
+      continue;
+
+    loop_units.insert(inner_head);
+    for(const auto &l : loop)
+      unit_of.emplace(l, inner_head);
+  }
+
+  auto get_unit = [&unit_of](const locationt &l) {
+    const auto it = unit_of.find(l);
+    return it == unit_of.end() ? l : it->second;
+  };
+
+  // The units ordered topologically, ignoring the edges back to the head
+  std::unordered_map<
+    locationt,
+    std::size_t,
+    const_target_hash,
+    pointee_address_equalt>
+    in_degree;
+  std::unordered_map<
+    locationt,
+    std::vector<locationt>,
+    const_target_hash,
+    pointee_address_equalt>
+    successors;
+  for(const auto &l : component)
+  {
+    if(head.has_value() && l == *head)
+      continue;
+
+    const locationt unit = get_unit(l);
+    in_degree.emplace(unit, 0);
+
+    for(const auto &successor : goto_program.get_successors(l))
+    {
+      if(
+        successor == goto_program.instructions.end() ||
+        component.count(successor) == 0 ||
+        (head.has_value() && successor == *head))
+      {
+        continue;
+      }
+
+      const locationt successor_unit = get_unit(successor);
+      if(successor_unit != unit)
+      {
+        successors[unit].push_back(successor_unit);
+        ++in_degree[successor_unit];
+      }
+    }
+  }
+
+  // Units that are ready to be appended, by their index in the program
+  std::set<std::pair<std::size_t, locationt>> ready;
+  for(const auto &unit : in_degree)
+  {
+    if(unit.second == 0)
+      ready.emplace(program_index.at(unit.first), unit.first);
+  }
+
+  std::set<locationt> done;
+  while(done.size() < in_degree.size())
+  {
+    if(ready.empty())
+    {
+      // A cycle that is not a natural loop: break it at the first unit
+      optionalt<std::pair<std::size_t, locationt>> first;
+      for(const auto &unit : in_degree)
+      {
+        const std::size_t index = program_index.at(unit.first);
+        if(done.count(unit.first) == 0 && (!first || index < first->first))
+          first = std::make_pair(index, unit.first);
+      }
+      ready.insert(*first);
+    }
+
+    const locationt unit = ready.begin()->second;
+    ready.erase(ready.begin());
+    if(!done.insert(unit).second)
+      continue;
+
+    if(loop_units.count(unit) != 0)
+    {
+      const auto &loop = natural_loops.loop_map.at(unit);
+      order_component(
+        std::set<locationt>(loop.begin(), loop.end()), unit, depth + 1);
+    }
+    else
+      wto.append(unit, depth, false);
+
+    for(const auto &successor : successors[unit])
+    {
+      if(--in_degree[successor] == 0 && done.count(successor) == 0)
+        ready.emplace(program_index.at(successor), successor);
+    }
+  }
+}
+
+weak_topological_ordert::weak_topological_ordert(
+  const goto_programt &goto_program)
+{
+  std::set<locationt> all_instructions;
+  for(auto it = goto_program.instructions.begin();
+      it != goto_program.instructions.end();
+      ++it)
+  {
+    all_instructions.insert(it);
+  }
+
+  buildert(*this, goto_program).order_component(all_instructions, {}, 0);
+}
+
+void weak_topological_ordert::append(
+  locationt l,
+  std::size_t depth,
+  bool is_head)
+{
+  entries.emplace(l, entryt{order.size(), depth, is_head});
+  order.push_back(l);
+}
+
+void weak_topological_ordert::output(std::ostream &out) const
+{
+  std::size_t open = 0;
+  bool first = true;
+
+  for(const auto &l : order)
+  {
+    const entryt &entry = entries.at(l);
+
+    // A head starts a new component at its depth
+    const std::size_t keep = entry.is_head ? entry.depth - 1 : entry.depth;
+    for(; open > keep; --open)
+      out << ')';
+
+    if(!first)
+      out << ' ';
+    first = false;
+
+    if(entry.is_head)
+    {
+      out << '(';
+      ++open;
+    }
+
+    out << l->location_number;
+  }
+
+  for(; open > 0; --open)
+    out << ')';
+}
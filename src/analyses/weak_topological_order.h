@@ -0,0 +1,88 @@
+/*******************************************************************\
+
+Module: Weak Topological Order
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Weak topological ordering of the instructions of a goto program
+
+#ifndef CPROVER_ANALYSES_WEAK_TOPOLOGICAL_ORDER_H
+#define CPROVER_ANALYSES_WEAK_TOPOLOGICAL_ORDER_H
+
+#include <goto-programs/goto_program.h>
+
+#include <iosfwd>
+#include <unordered_map>
+#include <vector>
+
+/// A weak topological order (Bourdoncle, "Efficient chaotic iteration
+/// strategies with widenings", 1993) of the instructions of a goto program.
+///
+/// The instructions are ordered such that, ignoring the edges back to loop
+/// heads, every instruction comes after its predecessors, and the instructions
+/// of each loop (a component) immediately follow its head.  Processing a
+/// working list in this order stabilises inner loops before anything after
+/// them is analysed again.  The heads of the components are the points at
+/// which domains of infinite height should widen.
+///
+/// The components are the natural loops of the program.  Cycles that are not
+/// natural loops (i.e. irreducible control flow) are broken at the instruction
+/// with the lowest location number.
+class weak_topological_ordert
+{
+public:
+  typedef goto_programt::const_targett locationt;
+
+  explicit weak_topological_ordert(const goto_programt &goto_program);
+
+  /// The instructions of the program, in order
+  const std::vector<locationt> &get_order() const
+  {
+    return order;
+  }
+
+  /// Index of \p l in \ref get_order
+  std::size_t position(locationt l) const
+  {
+    return entries.at(l).position;
+  }
+
+  /// True if \p l is the head of a component, i.e. a widening point
+  bool is_head(locationt l) const
+  {
+    return entries.at(l).is_head;
+  }
+
+  /// Number of components that contain \p l
+  std::size_t depth(locationt l) const
+  {
+    return entries.at(l).depth;
+  }
+
+  /// Output the order using location numbers, with each component in
+  /// parentheses, e.g. "1 (2 3 4) 5"
+  void output(std::ostream &out) const;
+
+protected:
+  class buildert;
+
+  struct entryt
+  {
+    std::size_t position;
+    std::size_t depth;
+    bool is_head;
+  };
+
+  std::vector<locationt> order;
+  typedef std::
+    unordered_map<locationt, entryt, const_target_hash, pointee_address_equalt>
+      entriest;
+  entriest entries;
+
+  void append(locationt l, std::size_t depth, bool is_head);
+};
+
+#endif // CPROVER_ANALYSES_WEAK_TOPOLOGICAL_ORDER_H
@@ -39,6 +39,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-checker/all_properties_verifier_with_trace_storage.h>
 #include <goto-checker/bmc_util.h>
 #include <goto-checker/cover_goals_verifier_with_trace_storage.h>
+#include <goto-checker/interval_prepass.h>
 #include <goto-checker/multi_path_symex_checker.h>
 #include <goto-checker/multi_path_symex_only_checker.h>
 #include <goto-checker/properties.h>
@@ -236,6 +237,18 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("drop-unused-functions"))
     options.set_option("drop-unused-functions", true);
 
+  if(cmdline.isset("interval-prepass"))
+  {
+    if(cmdline.isset("cover"))
+    {
+      log.error()
+        << "--cover and --interval-prepass must not be given together"
+        << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+    options.set_option("interval-prepass", true);
+  }
+
   if(cmdline.isset("havoc-undefined-functions"))
     options.set_option("havoc-undefined-functions", true);
 
@@ -324,6 +337,9 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   else if(cmdline.isset("arrays-uf-never"))
     options.set_option("arrays-uf", "never");
 
+  if(cmdline.isset("arrays-prune-ackermann"))
+    options.set_option("arrays-prune-ackermann", true);
+
   if(cmdline.isset("dimacs"))
     options.set_option("dimacs", true);
 
@@ -660,6 +676,16 @@ int cbmc_parse_optionst::doit()
   if(set_properties())
     return CPROVER_EXIT_SET_PROPERTIES_FAILED;
 
+  if(options.get_bool_option("interval-prepass"))
+  {
+    for(const auto &property_id :
+        interval_prepass(goto_model, ui_message_handler))
+    {
+      log.status() << "Property " << property_id
+                   << " proved by interval analysis" << messaget::eom;
+    }
+  }
+
   if(
     options.get_bool_option("program-only") ||
     options.get_bool_option("show-vcc") ||
@@ -1014,6 +1040,9 @@ void cbmc_parse_optionst::help()
     " --trace                      give a counterexample trace for failed properties\n" //NOLINT(*)
     " --stop-on-fail               stop analysis once a failed property is detected\n" // NOLINT(*)
     "                              (implies --trace)\n"
+    " --interval-prepass           prove properties with an interval analysis before\n" // NOLINT(*)
+    "                              running symbolic execution\n"
+    "                              (cannot be combined with --cover)\n"
     "\n"
     "C/C++ frontend options:\n"
     " -I path                      set include path (C/C++)\n"
@@ -1103,6 +1132,8 @@ void cbmc_parse_optionst::help()
     " --outfile filename           output formula to given file\n"
     " --arrays-uf-never            never turn arrays into uninterpreted functions\n" // NOLINT(*)
     " --arrays-uf-always           always turn arrays into uninterpreted functions\n" // NOLINT(*)
+    " --arrays-prune-ackermann     omit array Ackermann constraints implied by\n"
+    "                              those of if, with, array_of and casts\n"
     "\n"
     "Other options:\n"
     " --version                    show version and exit\n"
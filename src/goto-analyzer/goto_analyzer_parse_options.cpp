@@ -39,6 +39,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/show_symbol_table.h>
 #include <goto-programs/validate_goto_model.h>
 
+#include <analyses/ai_summary_interprocedural.h>
 #include <analyses/call_stack_history.h>
 #include <analyses/constant_propagator.h>
 #include <analyses/dependence_graph.h>
@@ -246,6 +247,8 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
       options.set_option("recursive-interprocedural", true);
     else if(cmdline.isset("three-way-merge"))
       options.set_option("three-way-merge", true);
+    else if(cmdline.isset("summary-interprocedural"))
+      options.set_option("summary-interprocedural", true);
     else if(cmdline.isset("legacy-ait") || cmdline.isset("location-sensitive"))
     {
       options.set_option("legacy-ait", true);
@@ -258,6 +261,7 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
     else if(cmdline.isset("legacy-concurrent") || cmdline.isset("concurrent"))
     {
       options.set_option("legacy-concurrent", true);
+      options.set_option("thread-modular", cmdline.isset("thread-modular"));
       options.set_option("ahistorical", true);
       options.set_option("history set", true);
       options.set_option("one-domain-per-location", true);
@@ -274,6 +278,17 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
       options.set_option("storage set", true);
     }
 
+    if(
+      cmdline.isset("thread-modular") &&
+      !options.get_bool_option("legacy-concurrent"))
+    {
+      log.error() << "--thread-modular requires --concurrent" << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    if(cmdline.isset("weak-topological-order"))
+      options.set_option("weak-topological-order", true);
+
     // History choice
     if(cmdline.isset("ahistorical"))
     {
@@ -396,6 +411,23 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("storage set", true);
   }
 
+  if(cmdline.isset("discard-transient-states"))
+  {
+    // Only the abstract interpreters built from a history, domain and storage
+    // factory can recompute the states they discard
+    if(
+      !options.get_bool_option("recursive-interprocedural") &&
+      !options.get_bool_option("three-way-merge") &&
+      !options.get_bool_option("summary-interprocedural"))
+    {
+      log.error() << "--discard-transient-states requires "
+                  << "--recursive-interprocedural, --three-way-merge or "
+                  << "--summary-interprocedural" << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+    options.set_option("discard-transient-states", true);
+  }
+
   if(!options.get_bool_option("storage set"))
   {
     // one-domain-per-location and one-domain-per-history are effectively
@@ -423,11 +455,16 @@ ai_baset *goto_analyzer_parse_optionst::build_analyzer(
   auto vsd_config = vsd_configt::from_options(options);
   auto vs_object_factory =
     variable_sensitivity_object_factoryt::configured_with(vsd_config);
+  std::shared_ptr<const live_variablest> live_variables;
+  if(vsd_config.sparse)
+    live_variables =
+      std::make_shared<live_variablest>(goto_model.goto_functions);
 
   // These support all of the option categories
   if(
     options.get_bool_option("recursive-interprocedural") ||
-    options.get_bool_option("three-way-merge"))
+    options.get_bool_option("three-way-merge") ||
+    options.get_bool_option("summary-interprocedural"))
   {
     // Build the history factory
     std::unique_ptr<ai_history_factory_baset> hf = nullptr;
@@ -464,7 +501,7 @@ ai_baset *goto_analyzer_parse_optionst::build_analyzer(
     else if(options.get_bool_option("vsd"))
     {
       df = util_make_unique<variable_sensitivity_domain_factoryt>(
-        vs_object_factory, vsd_config);
+        vs_object_factory, vsd_config, live_variables);
     }
     // non-null is not fully supported, despite the historical options
     // dependency-graph is quite heavily tied to the legacy-ait infrastructure
@@ -485,9 +522,10 @@ ai_baset *goto_analyzer_parse_optionst::build_analyzer(
     // correctly specified and configured
     if(hf != nullptr && df != nullptr && st != nullptr)
     {
+      std::unique_ptr<ai_baset> analyzer;
       if(options.get_bool_option("recursive-interprocedural"))
       {
-        return new ai_recursive_interproceduralt(
+        analyzer = util_make_unique<ai_recursive_interproceduralt>(
           std::move(hf), std::move(df), std::move(st));
       }
       else if(options.get_bool_option("three-way-merge"))
@@ -495,10 +533,25 @@ ai_baset *goto_analyzer_parse_optionst::build_analyzer(
         // Only works with VSD
         if(options.get_bool_option("vsd"))
         {
-          return new ai_three_way_merget(
+          analyzer = util_make_unique<ai_three_way_merget>(
             std::move(hf), std::move(df), std::move(st));
         }
       }
+      else if(options.get_bool_option("summary-interprocedural"))
+      {
+        analyzer = util_make_unique<ai_summary_interproceduralt>(
+          std::move(hf), std::move(df), std::move(st));
+      }
+
+      if(
+        analyzer != nullptr &&
+        options.get_bool_option("discard-transient-states"))
+      {
+        analyzer->set_state_retention(
+          ai_baset::state_retentiont::JOIN_POINTS);
+      }
+
+      return analyzer.release();
     }
   }
   else if(options.get_bool_option("legacy-ait"))
@@ -520,7 +573,7 @@ ai_baset *goto_analyzer_parse_optionst::build_analyzer(
     else if(options.get_bool_option("vsd"))
     {
       auto df = util_make_unique<variable_sensitivity_domain_factoryt>(
-        vs_object_factory, vsd_config);
+        vs_object_factory, vsd_config, live_variables);
       return new ait<variable_sensitivity_domaint>(std::move(df));
     }
     else if(options.get_bool_option("intervals"))
@@ -537,15 +590,21 @@ ai_baset *goto_analyzer_parse_optionst::build_analyzer(
   }
   else if(options.get_bool_option("legacy-concurrent"))
   {
-#if 0
     // Very few domains can work with this interpreter
     // as it requires that changes to the domain are
-    // 'non-revertable' and it has merge shared
+    // 'non-revertable' and it has merge shared.
+    // The dependence graph uses it for the reaching definitions its data
+    // dependencies are computed from.
     if(options.get_bool_option("dependence-graph"))
     {
-      return new dependence_grapht(ns);
+      auto dependence_graph = util_make_unique<dependence_grapht>(ns);
+      if(options.get_bool_option("thread-modular"))
+      {
+        dependence_graph->set_concurrency_mode(
+          reaching_definitions_analysist::concurrency_modet::THREAD_MODULAR);
+      }
+      return dependence_graph.release();
     }
-#endif
   }
 
   // Construction failed due to configuration errors
@@ -779,9 +838,16 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
       return CPROVER_EXIT_INTERNAL_ERROR;
     }
 
+    if(options.get_bool_option("weak-topological-order"))
+      analyzer->set_worklist_order(ai_baset::worklist_ordert::WEAK_TOPOLOGICAL);
+
     // Run
     log.status() << "Computing abstract states" << messaget::eom;
     (*analyzer)(goto_model);
+    log.statistics() << "Transformer applications: "
+                     << analyzer->get_statistics().transformers
+                     << ", merges: " << analyzer->get_statistics().merges
+                     << messaget::eom;
 
     // Perform the task
     log.status() << "Performing task" << messaget::eom;
@@ -904,9 +970,17 @@ void goto_analyzer_parse_optionst::help()
     // NOLINTNEXTLINE(whitespace/line_length)
     " --three-way-merge            use VSD's three-way merge on return from function call\n"
     // NOLINTNEXTLINE(whitespace/line_length)
+    " --summary-interprocedural    reuse per-calling-context function summaries\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
     " --legacy-ait                 recursion for function and one domain per location\n"
     // NOLINTNEXTLINE(whitespace/line_length)
     " --legacy-concurrent          legacy-ait with an extended fixed-point for concurrency\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --thread-modular             with --concurrent, reach the fixed-point using per-thread\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              interference summaries (only --dependence-graph)\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --weak-topological-order     stabilise inner loops before visiting the code after them\n"
     "\n"
     "History options:\n"
     // NOLINTNEXTLINE(whitespace/line_length)
@@ -943,12 +1017,19 @@ void goto_analyzer_parse_optionst::help()
     " --vsd-pointers               pointer sensitive analysis - top-bottom|constants|value-set\n"
     " --vsd-unions                 union sensitive analysis - top-bottom\n"
     " --vsd-flow-insensitive       disables flow sensitivity\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --vsd-sparse                 only keep the values of local variables while they are live\n"
     " --vsd-data-dependencies      track data dependencies\n"
     "\n"
     "Storage options:\n"
     // NOLINTNEXTLINE(whitespace/line_length)
     " --one-domain-per-history     stores a domain for each history object created\n"
     " --one-domain-per-location    stores a domain for each location reached\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --discard-transient-states   only keep domains at function entries, joins and calls,\n"
+    "                              recomputing the others when needed\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              (not supported by --legacy-ait or --concurrent)\n"
     "\n"
     "Output options:\n"
     " --text file_name             output results in plain text to given file\n"
@@ -1021,4 +1102,5 @@ void vsd_options(optionst &options, const cmdlinet &cmdline)
   options.set_option("structs", cmdline.get_value("vsd-structs"));
   options.set_option("unions", cmdline.get_value("vsd-unions"));
   options.set_option("flow-insensitive", cmdline.isset("vsd-flow-insensitive"));
+  options.set_option("sparse", cmdline.isset("vsd-sparse"));
 }
@@ -116,8 +116,11 @@ class optionst;
 #define GOTO_ANALYSER_OPTIONS_AI \
   "(recursive-interprocedural)" \
   "(three-way-merge)" \
+  "(summary-interprocedural)" \
   "(legacy-ait)" \
-  "(legacy-concurrent)"
+  "(legacy-concurrent)" \
+  "(thread-modular)" \
+  "(weak-topological-order)"
 
 #define GOTO_ANALYSER_OPTIONS_HISTORY \
   "(ahistorical)" \
@@ -141,11 +144,13 @@ class optionst;
   "(vsd-pointers):" \
   "(vsd-unions):" \
   "(vsd-flow-insensitive)" \
+  "(vsd-sparse)" \
   "(vsd-data-dependencies)"
 
 #define GOTO_ANALYSER_OPTIONS_STORAGE \
   "(one-domain-per-history)" \
-  "(one-domain-per-location)"
+  "(one-domain-per-location)" \
+  "(discard-transient-states)"
 
 #define GOTO_ANALYSER_OPTIONS_OUTPUT \
   "(json):(xml):" \
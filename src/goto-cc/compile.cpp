@@ -576,6 +576,7 @@ bool compilet::write_bin_object_file(
   const std::string &file_name,
   const goto_modelt &src_goto_model,
   bool validate_goto_model,
+  bool compress_goto_binary,
   message_handlert &message_handler)
 {
   messaget log(message_handler);
@@ -602,7 +603,10 @@ bool compilet::write_bin_object_file(
     return true;
   }
 
-  if(write_goto_binary(outfile, src_goto_model))
+  const int version = compress_goto_binary ? GOTO_BINARY_COMPRESSED_VERSION
+                                           : GOTO_BINARY_VERSION;
+
+  if(write_goto_binary(outfile, src_goto_model, version))
     return true;
 
   const auto cnt = function_body_count(src_goto_model.goto_functions);
@@ -29,6 +29,7 @@ public:
   // configuration
   bool echo_file_name;
   bool validate_goto_model = false;
+  bool compress_goto_binary = false;
 
   enum { PREPROCESS_ONLY, // gcc -E
          COMPILE_ONLY, // gcc -c
@@ -70,12 +71,14 @@ public:
   /// \param file_name: Target file to serialize \p src_goto_model to
   /// \param src_goto_model: goto model to serialize
   /// \param validate_goto_model: enable goto-model validation
+  /// \param compress_goto_binary: use the compressed goto binary format
   /// \param message_handler: message handler
   /// \return true on error, false otherwise
   static bool write_bin_object_file(
     const std::string &file_name,
     const goto_modelt &src_goto_model,
     bool validate_goto_model,
+    bool compress_goto_binary,
     message_handlert &message_handler);
 
   /// \brief Has this compiler written any object files?
@@ -122,6 +125,7 @@ protected:
          file_name,
          src_goto_model,
          validate_goto_model,
+         compress_goto_binary,
          log.get_message_handler()))
     {
       return true;
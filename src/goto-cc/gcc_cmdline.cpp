@@ -51,6 +51,7 @@ const char *goto_cc_options_without_argument[]=
   "--no-arch",
   "--partial-inlining",
   "--validate-goto-model",
+  "--compress-goto-binary",
   "-?",
   "--export-file-local-symbols",
   // This is deprecated. Currently prints out a deprecation warning.
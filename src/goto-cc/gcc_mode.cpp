@@ -427,6 +427,9 @@ int gcc_modet::doit()
   // model validation
   compiler.validate_goto_model = cmdline.isset("validate-goto-model");
 
+  // write goto binaries in the compressed format
+  compiler.compress_goto_binary = cmdline.isset("compress-goto-binary");
+
   // determine actions to be undertaken
   if(cmdline.isset('S'))
     compiler.mode=compilet::ASSEMBLE_ONLY;
@@ -113,6 +113,7 @@ int linker_script_merget::add_linker_script_definitions()
     goto_binary,
     *original_goto_model,
     cmdline.isset("validate-goto-model"),
+    cmdline.isset("compress-goto-binary"),
     log.get_message_handler());
 
   if(fail!=0)
@@ -69,6 +69,9 @@ int ms_cl_modet::doit()
   // model validation
   compiler.validate_goto_model = cmdline.isset("validate-goto-model");
 
+  // write goto binaries in the compressed format
+  compiler.compress_goto_binary = cmdline.isset("compress-goto-binary");
+
   // get configuration
   config.set(cmdline);
 
@@ -0,0 +1,107 @@
+/*******************************************************************\
+
+Module: Interval Analysis Pre-pass
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Discharging properties with an interval analysis before BMC
+
+#include "interval_prepass.h"
+
+#include <util/message.h>
+
+#include <goto-programs/goto_model.h>
+
+#include <analyses/interval_domain.h>
+
+#include <chrono>
+#include <map>
+
+/// \return true if \p condition holds in all states represented by \p state
+static bool holds(
+  const ai_domain_baset &state,
+  const exprt &condition,
+  const namespacet &ns)
+{
+  // interval_domaint::ai_simplify over-approximates the states satisfying a
+  // conjunction, and would thus claim too much
+  if(condition.id() == ID_and)
+  {
+    for(const auto &op : condition.operands())
+    {
+      if(!holds(state, op, ns))
+        return false;
+    }
+    return true;
+  }
+
+  exprt simplified = condition;
+  state.ai_simplify(simplified, ns);
+  return simplified.is_true();
+}
+
+std::set<irep_idt>
+interval_prepass(goto_modelt &goto_model, message_handlert &message_handler)
+{
+  messaget log(message_handler);
+
+  std::map<irep_idt, std::vector<goto_programt::targett>> assertions;
+  for(auto &gf_entry : goto_model.goto_functions.function_map)
+  {
+    Forall_goto_program_instructions(i_it, gf_entry.second.body)
+    {
+      if(i_it->is_start_thread() || i_it->is_throw() || i_it->is_catch())
+      {
+        log.warning() << "interval pre-pass does not support threads or "
+                      << "exceptions" << messaget::eom;
+        return {};
+      }
+
+      if(i_it->is_assert() && !i_it->get_condition().is_true())
+        assertions[i_it->source_location.get_property_id()].push_back(i_it);
+    }
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  const namespacet ns(goto_model.symbol_table);
+  dirty_aware_interval_ait interval_analysis(goto_model.goto_functions);
+  interval_analysis(goto_model.goto_functions, ns);
+
+  std::set<irep_idt> proved;
+  for(const auto &property : assertions)
+  {
+    bool all_proved = true;
+    for(const auto &assertion : property.second)
+    {
+      const auto state = interval_analysis.abstract_state_before(assertion);
+      if(!state->is_bottom() && !holds(*state, assertion->get_condition(), ns))
+      {
+        all_proved = false;
+        break;
+      }
+    }
+
+    if(!all_proved)
+      continue;
+
+    for(auto &assertion : property.second)
+      assertion->set_condition(true_exprt());
+
+    proved.insert(property.first);
+  }
+
+  const auto stop = std::chrono::steady_clock::now();
+  const std::chrono::duration<double> runtime =
+    std::chrono::duration<double>(stop - start);
+
+  log.status() << "Interval analysis proved " << proved.size() << " of "
+               << assertions.size() << " properties" << messaget::eom;
+  log.statistics() << "Runtime interval analysis: " << runtime.count() << "s"
+                   << messaget::eom;
+
+  return proved;
+}
@@ -0,0 +1,32 @@
+/*******************************************************************\
+
+Module: Interval Analysis Pre-pass
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Discharging properties with an interval analysis before BMC
+
+#ifndef CPROVER_GOTO_CHECKER_INTERVAL_PREPASS_H
+#define CPROVER_GOTO_CHECKER_INTERVAL_PREPASS_H
+
+#include <util/irep.h>
+
+#include <set>
+
+class goto_modelt;
+class message_handlert;
+
+/// Try to prove the assertions of \p goto_model with an interval analysis,
+/// which is much cheaper than BMC.  Assertions that are proved, or found to
+/// be unreachable, are replaced by `ASSERT true`, for which symex does not
+/// generate verification conditions, so that their properties are reported
+/// as PASS without involving the solver.  The analysis does not model
+/// threads or exceptions, and the program is left unchanged if it uses any.
+/// \return the properties all of whose assertions were proved
+std::set<irep_idt>
+interval_prepass(goto_modelt &goto_model, message_handlert &message_handler);
+
+#endif // CPROVER_GOTO_CHECKER_INTERVAL_PREPASS_H
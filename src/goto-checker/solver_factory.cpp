@@ -229,6 +229,9 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_default()
   else if(options.get_option("arrays-uf") == "always")
     bv_pointers->unbounded_array = bv_pointerst::unbounded_arrayt::U_ALL;
 
+  bv_pointers->prune_ackermann_constraints =
+    options.get_bool_option("arrays-prune-ackermann");
+
   set_decision_procedure_time_limit(*bv_pointers);
   solver->set_decision_procedure(std::move(bv_pointers));
 
@@ -292,6 +295,8 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_bv_refinement()
   info.message_handler = &message_handler;
 
   auto decision_procedure = util_make_unique<bv_refinementt>(info);
+  decision_procedure->prune_ackermann_constraints =
+    options.get_bool_option("arrays-prune-ackermann");
   set_decision_procedure_time_limit(*decision_procedure);
   return util_make_unique<solvert>(
     std::move(decision_procedure), std::move(prop));
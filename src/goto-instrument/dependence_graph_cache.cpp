@@ -0,0 +1,84 @@
+/*******************************************************************\
+
+Module: Dependence Graph Cache
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Reuse of the dependencies computed by an earlier run on the same program
+
+#include "dependence_graph_cache.h"
+
+#include <util/json.h>
+#include <util/message.h>
+
+#include <goto-programs/goto_model.h>
+
+#include <analyses/dependence_graph.h>
+
+#include <json/json_parser.h>
+
+#include <fstream>
+
+instruction_dependenciest load_or_compute_dependencies(
+  const goto_modelt &goto_model,
+  const std::string &file_name,
+  message_handlert &message_handler)
+{
+  messaget log(message_handler);
+
+  std::ifstream in(file_name);
+  if(in)
+  {
+    in.close();
+
+    jsont json;
+    // a file that cannot be parsed is overwritten below
+    null_message_handlert null_message_handler;
+    if(!parse_json(file_name, null_message_handler, json))
+    {
+      std::vector<irep_idt> changed_functions;
+      auto dependencies = instruction_dependenciest::from_json(
+        json,
+        goto_model.goto_functions,
+        goto_model.symbol_table,
+        changed_functions);
+
+      if(dependencies.has_value())
+      {
+        log.status() << "Reusing dependence graph from " << file_name
+                     << messaget::eom;
+        return std::move(*dependencies);
+      }
+
+      for(const auto &function : changed_functions)
+      {
+        log.debug() << "Function " << function << " changed since "
+                    << file_name << " was written" << messaget::eom;
+      }
+    }
+
+    log.status() << "Dependence graph in " << file_name
+                 << " is out of date, recomputing it" << messaget::eom;
+  }
+
+  const namespacet ns(goto_model.symbol_table);
+  dependence_grapht dependence_graph(ns);
+  dependence_graph(goto_model.goto_functions, ns);
+
+  instruction_dependenciest dependencies(
+    goto_model.goto_functions, dependence_graph);
+
+  std::ofstream out(file_name);
+  if(!out)
+  {
+    log.warning() << "failed to write dependence graph to " << file_name
+                  << messaget::eom;
+  }
+  else
+    out << dependencies.output_json(goto_model.symbol_table) << '\n';
+
+  return dependencies;
+}
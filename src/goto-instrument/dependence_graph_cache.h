@@ -0,0 +1,31 @@
+/*******************************************************************\
+
+Module: Dependence Graph Cache
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Reuse of the dependencies computed by an earlier run on the same program
+
+#ifndef CPROVER_GOTO_INSTRUMENT_DEPENDENCE_GRAPH_CACHE_H
+#define CPROVER_GOTO_INSTRUMENT_DEPENDENCE_GRAPH_CACHE_H
+
+#include <analyses/instruction_dependencies.h>
+
+#include <string>
+
+class goto_modelt;
+class message_handlert;
+
+/// Read the dependencies between the instructions of \p goto_model from
+/// \p file_name if it was written for the same program, or else compute them
+/// with \ref dependence_grapht and write them to \p file_name.  The location
+/// numbers of \p goto_model must be up to date.
+instruction_dependenciest load_or_compute_dependencies(
+  const goto_modelt &goto_model,
+  const std::string &file_name,
+  message_handlert &message_handler);
+
+#endif // CPROVER_GOTO_INSTRUMENT_DEPENDENCE_GRAPH_CACHE_H
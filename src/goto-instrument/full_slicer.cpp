@@ -17,24 +17,21 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <goto-programs/remove_skip.h>
 
+#include <unordered_set>
+
 void full_slicert::add_dependencies(
   const cfgt::nodet &node,
+  const criteria_sett &criteria,
   queuet &queue,
-  const dependence_grapht &dep_graph,
-  const dep_node_to_cfgt &dep_node_to_cfg)
+  const instruction_dependenciest &dependencies)
 {
-  const dependence_grapht::nodet &d_node=
-    dep_graph[dep_graph[node.PC].get_node_id()];
-
-  for(dependence_grapht::edgest::const_iterator
-      it=d_node.in.begin();
-      it!=d_node.in.end();
-      ++it)
-    add_to_queue(queue, dep_node_to_cfg[it->first], node.PC);
+  for(const auto &dependency : dependencies.dependencies(node.PC))
+    add_to_queue(queue, cfg.get_node_index(dependency), criteria, node.PC);
 }
 
 void full_slicert::add_function_calls(
   const cfgt::nodet &node,
+  const criteria_sett &criteria,
   queuet &queue,
   const goto_functionst &goto_functions)
 {
@@ -48,11 +45,12 @@ void full_slicert::add_function_calls(
 
   const auto &entry = cfg.get_node(begin_function);
   for(const auto &in_edge : entry.in)
-    add_to_queue(queue, in_edge.first, node.PC);
+    add_to_queue(queue, in_edge.first, criteria, node.PC);
 }
 
 void full_slicert::add_decl_dead(
   const cfgt::nodet &node,
+  const criteria_sett &criteria,
   queuet &queue,
   decl_deadt &decl_dead)
 {
@@ -72,14 +70,72 @@ void full_slicert::add_decl_dead(
     if(entry==decl_dead.end())
       continue;
 
-    while(!entry->second.empty())
+    criteria_sett new_criteria = criteria;
+    new_criteria.erase(entry->second.required);
+    if(new_criteria.empty())
+      continue;
+
+    entry->second.required.insert(new_criteria);
+    for(const auto &decl_dead_entry : entry->second.entries)
+      add_to_queue(queue, decl_dead_entry, new_criteria, node.PC);
+  }
+}
+
+/// \return the instruction in the slice for \p criterion that requires
+///   \p jump to be added to it, if any
+optionalt<goto_programt::const_targett> full_slicert::jump_required_by(
+  const cfgt::nodet &jump,
+  std::size_t criterion,
+  const dependence_grapht::post_dominators_mapt &post_dominators)
+{
+  // check nearest lexical successor in slice
+  goto_programt::const_targett lex_succ = jump.PC;
+  for( ; !lex_succ->is_end_function(); ++lex_succ)
+  {
+    if(cfg.get_node(lex_succ).required.contains(criterion))
+      break;
+  }
+  if(lex_succ->is_end_function())
+    return {};
+
+  const irep_idt &id = jump.function_id;
+  const cfg_post_dominatorst &pd=post_dominators.at(id);
+
+  const auto &j_PC_node = pd.get_node(jump.PC);
+
+  // find the nearest post-dominator in slice
+  if(!pd.dominates(lex_succ, j_PC_node))
+    return lex_succ;
+
+  // check whether the nearest post-dominator is different from
+  // lex_succ
+  goto_programt::const_targett nearest=lex_succ;
+  std::size_t post_dom_size=0;
+  for(cfg_dominatorst::target_sett::const_iterator d_it =
+        j_PC_node.dominators.begin();
+      d_it != j_PC_node.dominators.end();
+      ++d_it)
+  {
+    const auto &node = cfg.get_node(*d_it);
+    if(node.required.contains(criterion))
     {
-      add_to_queue(queue, entry->second.top(), node.PC);
-      entry->second.pop();
-    }
+      const irep_idt &id2 = node.function_id;
+      INVARIANT(id==id2,
+                "goto/jump expected to be within a single function");
 
-    decl_dead.erase(entry);
+      const auto &postdom_node = pd.get_node(*d_it);
+
+      if(postdom_node.dominators.size() > post_dom_size)
+      {
+        nearest=*d_it;
+        post_dom_size = postdom_node.dominators.size();
+      }
+    }
   }
+  if(nearest!=lex_succ)
+    return nearest;
+
+  return {};
 }
 
 void full_slicert::add_jumps(
@@ -106,6 +162,7 @@ void full_slicert::add_jumps(
   // labeled L is not in Slice then associate the label L with its
   // nearest postdominator in Slice;
   // return (Slice);
+  // This is done separately for the slice of each criterion.
 
   for(jumpst::iterator
       it=jumps.begin();
@@ -117,72 +174,29 @@ void full_slicert::add_jumps(
 
     const cfgt::nodet &j=cfg[*it];
 
-    // is j in the slice already?
-    if(j.node_required)
-    {
-      jumps.erase(it);
-      it=next;
-      continue;
-    }
-
-    // check nearest lexical successor in slice
-    goto_programt::const_targett lex_succ=j.PC;
-    for( ; !lex_succ->is_end_function(); ++lex_succ)
-    {
-      if(cfg.get_node(lex_succ).node_required)
-        break;
-    }
-    if(lex_succ->is_end_function())
-    {
-      it=next;
-      continue;
-    }
-
-    const irep_idt &id = j.function_id;
-    const cfg_post_dominatorst &pd=post_dominators.at(id);
+    // the jump can be dropped once it is in all slices
+    bool in_all_slices = true;
 
-    const auto &j_PC_node = pd.get_node(j.PC);
-
-    // find the nearest post-dominator in slice
-    if(!pd.dominates(lex_succ, j_PC_node))
+    for(std::size_t criterion = 0; criterion < number_of_criteria; ++criterion)
     {
-      add_to_queue(queue, *it, lex_succ);
-      jumps.erase(it);
-    }
-    else
-    {
-      // check whether the nearest post-dominator is different from
-      // lex_succ
-      goto_programt::const_targett nearest=lex_succ;
-      std::size_t post_dom_size=0;
-      for(cfg_dominatorst::target_sett::const_iterator d_it =
-            j_PC_node.dominators.begin();
-          d_it != j_PC_node.dominators.end();
-          ++d_it)
-      {
-        const auto &node = cfg.get_node(*d_it);
-        if(node.node_required)
-        {
-          const irep_idt &id2 = node.function_id;
-          INVARIANT(id==id2,
-                    "goto/jump expected to be within a single function");
-
-          const auto &postdom_node = pd.get_node(*d_it);
+      // is j in the slice already?
+      if(j.required.contains(criterion))
+        continue;
 
-          if(postdom_node.dominators.size() > post_dom_size)
-          {
-            nearest=*d_it;
-            post_dom_size = postdom_node.dominators.size();
-          }
-        }
-      }
-      if(nearest!=lex_succ)
+      const auto reason = jump_required_by(j, criterion, post_dominators);
+      if(reason.has_value())
       {
-        add_to_queue(queue, *it, nearest);
-        jumps.erase(it);
+        criteria_sett criteria;
+        criteria.insert(criterion);
+        add_to_queue(queue, *it, criteria, *reason);
       }
+      else
+        in_all_slices = false;
     }
 
+    if(in_all_slices)
+      jumps.erase(it);
+
     it=next;
   }
 }
@@ -192,14 +206,9 @@ void full_slicert::fixedpoint(
   queuet &queue,
   jumpst &jumps,
   decl_deadt &decl_dead,
-  const dependence_grapht &dep_graph)
+  const instruction_dependenciest &dependencies,
+  const dependence_grapht::post_dominators_mapt &post_dominators)
 {
-  std::vector<cfgt::entryt> dep_node_to_cfg;
-  dep_node_to_cfg.reserve(dep_graph.size());
-
-  for(dependence_grapht::node_indext i = 0; i < dep_graph.size(); ++i)
-    dep_node_to_cfg.push_back(cfg.get_node_index(dep_graph[i].PC));
-
   // process queue until empty
   while(!queue.empty())
   {
@@ -209,25 +218,29 @@ void full_slicert::fixedpoint(
       cfgt::nodet &node=cfg[e];
       queue.pop();
 
+      criteria_sett criteria;
+      criteria.swap(node.pending);
+
       // already done by some earlier iteration?
-      if(node.node_required)
+      criteria.erase(node.required);
+      if(criteria.empty())
         continue;
 
       // node is required
-      node.node_required=true;
+      node.required.insert(criteria);
 
       // add data and control dependencies of node
-      add_dependencies(node, queue, dep_graph, dep_node_to_cfg);
+      add_dependencies(node, criteria, queue, dependencies);
 
       // retain all calls of the containing function
-      add_function_calls(node, queue, goto_functions);
+      add_function_calls(node, criteria, queue, goto_functions);
 
       // find all the symbols it uses to add declarations
-      add_decl_dead(node, queue, decl_dead);
+      add_decl_dead(node, criteria, queue, decl_dead);
     }
 
     // add any required jumps
-    add_jumps(queue, jumps, dep_graph.cfg_post_dominators());
+    add_jumps(queue, jumps, post_dominators);
   }
 }
 
@@ -255,6 +268,83 @@ void full_slicert::operator()(
   goto_functionst &goto_functions,
   const namespacet &ns,
   const slicing_criteriont &criterion)
+{
+  // compute program dependence graph (and post-dominators)
+  dependence_grapht dep_graph(ns);
+  dep_graph(goto_functions, ns);
+
+  slice(
+    goto_functions,
+    {&criterion},
+    instruction_dependenciest(goto_functions, dep_graph),
+    dep_graph.cfg_post_dominators(),
+    {});
+}
+
+/// The post-dominators of the instructions of each function, which are cheap
+/// to compute, unlike the dependencies
+static dependence_grapht::post_dominators_mapt
+compute_post_dominators(const goto_functionst &goto_functions)
+{
+  dependence_grapht::post_dominators_mapt post_dominators;
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    if(!gf_entry.second.body.empty())
+      post_dominators[gf_entry.first](gf_entry.second.body);
+  }
+  return post_dominators;
+}
+
+void full_slicert::operator()(
+  goto_functionst &goto_functions,
+  const slicing_criteriont &criterion,
+  const instruction_dependenciest &dependencies)
+{
+  slice(
+    goto_functions,
+    {&criterion},
+    dependencies,
+    compute_post_dominators(goto_functions),
+    {});
+}
+
+void full_slicert::operator()(
+  goto_functionst &goto_functions,
+  const namespacet &ns,
+  const criteriat &criteria,
+  const slice_handlert &handler)
+{
+  dependence_grapht dep_graph(ns);
+  dep_graph(goto_functions, ns);
+
+  slice(
+    goto_functions,
+    criteria,
+    instruction_dependenciest(goto_functions, dep_graph),
+    dep_graph.cfg_post_dominators(),
+    handler);
+}
+
+void full_slicert::operator()(
+  goto_functionst &goto_functions,
+  const criteriat &criteria,
+  const instruction_dependenciest &dependencies,
+  const slice_handlert &handler)
+{
+  slice(
+    goto_functions,
+    criteria,
+    dependencies,
+    compute_post_dominators(goto_functions),
+    handler);
+}
+
+void full_slicert::slice(
+  goto_functionst &goto_functions,
+  const criteriat &criteria,
+  const instruction_dependenciest &dependencies,
+  const dependence_grapht::post_dominators_mapt &post_dominators,
+  const slice_handlert &handler)
 {
   // build the CFG data structure
   cfg(goto_functions);
@@ -264,6 +354,11 @@ void full_slicert::operator()(
       cfg.get_node(i_it).function_id = gf_entry.first;
   }
 
+  number_of_criteria = criteria.size();
+  criteria_sett all_criteria;
+  for(std::size_t i = 0; i < number_of_criteria; ++i)
+    all_criteria.insert(i);
+
   // fill queue with according to slicing criterion
   queuet queue;
   // gather all unconditional jumps as they may need to be included
@@ -275,10 +370,20 @@ void full_slicert::operator()(
   {
     const auto &instruction = instruction_and_index.first;
     const auto instruction_node_index = instruction_and_index.second;
-    if(criterion(cfg[instruction_node_index].function_id, instruction))
-      add_to_queue(queue, instruction_node_index, instruction);
-    else if(implicit(instruction))
-      add_to_queue(queue, instruction_node_index, instruction);
+    const irep_idt &function_id = cfg[instruction_node_index].function_id;
+
+    criteria_sett matching;
+    for(std::size_t i = 0; i < number_of_criteria; ++i)
+    {
+      if((*criteria[i])(function_id, instruction))
+        matching.insert(i);
+    }
+
+    if(!matching.empty())
+      add_to_queue(queue, instruction_node_index, matching, instruction);
+
+    if(implicit(instruction))
+      add_to_queue(queue, instruction_node_index, all_criteria, instruction);
     else if(
       (instruction->is_goto() && instruction->get_condition().is_true()) ||
       instruction->is_throw())
@@ -286,35 +391,61 @@ void full_slicert::operator()(
     else if(instruction->is_decl())
     {
       const auto &s = to_code_decl(instruction->code).symbol();
-      decl_dead[s.get_identifier()].push(instruction_node_index);
+      decl_dead[s.get_identifier()].entries.push_back(instruction_node_index);
     }
     else if(instruction->is_dead())
     {
       const auto &s = to_code_dead(instruction->code).symbol();
-      decl_dead[s.get_identifier()].push(instruction_node_index);
+      decl_dead[s.get_identifier()].entries.push_back(instruction_node_index);
     }
   }
 
-  // compute program dependence graph (and post-dominators)
-  dependence_grapht dep_graph(ns);
-  dep_graph(goto_functions, ns);
-
   // compute the fixedpoint
-  fixedpoint(goto_functions, queue, jumps, decl_dead, dep_graph);
+  fixedpoint(
+    goto_functions, queue, jumps, decl_dead, dependencies, post_dominators);
 
+  if(handler)
+  {
+    for(std::size_t i = 0; i < number_of_criteria; ++i)
+    {
+      goto_functionst sliced;
+      sliced.copy_from(goto_functions);
+      apply_slice(goto_functions, sliced, [i](const cfgt::nodet &node) {
+        return node.required.contains(i);
+      });
+      handler(i, sliced);
+    }
+  }
+
+  apply_slice(goto_functions, goto_functions, [](const cfgt::nodet &node) {
+    return !node.required.empty();
+  });
+}
+
+void full_slicert::apply_slice(
+  const goto_functionst &goto_functions,
+  goto_functionst &sliced,
+  const std::function<bool(const cfgt::nodet &)> &is_required)
+{
   // now replace those instructions that are not needed
   // by skips
 
-  for(auto &gf_entry : goto_functions.function_map)
+  for(auto &gf_entry : sliced.function_map)
   {
     if(gf_entry.second.body_available())
     {
+      // the CFG refers to the instructions of goto_functions, of which
+      // sliced is a copy
+      goto_programt::const_targett original_it =
+        goto_functions.function_map.at(gf_entry.first)
+          .body.instructions.begin();
+
       Forall_goto_program_instructions(i_it, gf_entry.second.body)
       {
-        const auto &cfg_node = cfg.get_node(i_it);
+        const auto &cfg_node = cfg.get_node(original_it++);
         if(
           !i_it->is_end_function() && // always retained
-          !cfg_node.node_required)
+          !is_required(cfg_node))
         {
           i_it->turn_into_skip();
         }
@@ -341,7 +472,7 @@ void full_slicert::operator()(
   }
 
   // remove the skips
-  remove_skip(goto_functions);
+  remove_skip(sliced);
 }
 
 void full_slicer(
@@ -384,6 +515,68 @@ void property_slicer(
   property_slicer(goto_model.goto_functions, ns, properties);
 }
 
+void property_slicer(
+  goto_modelt &goto_model,
+  const std::list<std::string> &properties,
+  const std::function<void(const irep_idt &, goto_functionst &)> &handler,
+  const instruction_dependenciest *dependencies)
+{
+  std::vector<irep_idt> property_ids(properties.begin(), properties.end());
+  if(property_ids.empty())
+  {
+    std::unordered_set<irep_idt> seen;
+    for(const auto &gf_entry : goto_model.goto_functions.function_map)
+    {
+      forall_goto_program_instructions(i_it, gf_entry.second.body)
+      {
+        if(!i_it->is_assert())
+          continue;
+
+        const irep_idt &property_id = i_it->source_location.get_property_id();
+        if(seen.insert(property_id).second)
+          property_ids.push_back(property_id);
+      }
+    }
+  }
+
+  std::vector<property_criteriont> criteria;
+  criteria.reserve(property_ids.size());
+  full_slicert::criteriat criterion_pointers;
+  for(const auto &property_id : property_ids)
+  {
+    criteria.emplace_back(property_id);
+    criterion_pointers.push_back(&criteria.back());
+  }
+
+  const full_slicert::slice_handlert slice_handler =
+    [&property_ids, &handler](std::size_t i, goto_functionst &sliced) {
+      handler(property_ids[i], sliced);
+    };
+
+  if(dependencies != nullptr)
+  {
+    full_slicert()(
+      goto_model.goto_functions,
+      criterion_pointers,
+      *dependencies,
+      slice_handler);
+  }
+  else
+  {
+    const namespacet ns(goto_model.symbol_table);
+    full_slicert()(
+      goto_model.goto_functions, ns, criterion_pointers, slice_handler);
+  }
+}
+
+void full_slicer(
+  goto_functionst &goto_functions,
+  const slicing_criteriont &criterion,
+  const instruction_dependenciest &dependencies)
+{
+  full_slicert()(goto_functions, criterion, dependencies);
+}
+
 slicing_criteriont::~slicing_criteriont()
 {
 }
@@ -14,6 +14,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <goto-programs/goto_model.h>
 
+#include <functional>
+
 void full_slicer(
   goto_functionst &,
   const namespacet &);
@@ -29,6 +31,21 @@ void property_slicer(
   goto_modelt &,
   const std::list<std::string> &properties);
 
+class instruction_dependenciest;
+
+/// Compute the full slices with respect to each of \p properties, or to each
+/// property of \p goto_model if \p properties is empty, in a single pass.
+/// \p handler is called with each property and the goto functions sliced
+/// with respect to it, after which the goto functions of \p goto_model are
+/// sliced to the union of all these slices.  The dependencies between
+/// instructions are taken from \p dependencies if given, for example from an
+/// earlier run, and computed otherwise.
+void property_slicer(
+  goto_modelt &goto_model,
+  const std::list<std::string> &properties,
+  const std::function<void(const irep_idt &, goto_functionst &)> &handler,
+  const instruction_dependenciest *dependencies = nullptr);
+
 class slicing_criteriont
 {
 public:
@@ -43,4 +60,12 @@ void full_slicer(
   const namespacet &ns,
   const slicing_criteriont &criterion);
 
+/// Slice with respect to \p criterion, using the dependencies between
+/// instructions in \p dependencies, for example from an earlier run, rather
+/// than computing them
+void full_slicer(
+  goto_functionst &goto_functions,
+  const slicing_criteriont &criterion,
+  const instruction_dependenciest &dependencies);
+
 #endif // CPROVER_GOTO_INSTRUMENT_FULL_SLICER_H
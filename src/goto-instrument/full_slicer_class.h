@@ -12,6 +12,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_INSTRUMENT_FULL_SLICER_CLASS_H
 #define CPROVER_GOTO_INSTRUMENT_FULL_SLICER_CLASS_H
 
+#include <cstdint>
+#include <functional>
 #include <stack>
 #include <vector>
 #include <list>
@@ -20,6 +22,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/cfg.h>
 
 #include <analyses/dependence_graph.h>
+#include <analyses/instruction_dependencies.h>
 
 #include "full_slicer.h"
 
@@ -43,14 +46,92 @@ public:
     const namespacet &ns,
     const slicing_criteriont &criterion);
 
+  /// Slice with the dependencies given by \p dependencies rather than
+  /// computing them
+  void operator()(
+    goto_functionst &goto_functions,
+    const slicing_criteriont &criterion,
+    const instruction_dependenciest &dependencies);
+
+  typedef std::vector<const slicing_criteriont *> criteriat;
+  typedef std::function<void(std::size_t, goto_functionst &)> slice_handlert;
+
+  /// Compute the slices with respect to each of \p criteria in a single pass,
+  /// and call \p handler with the index of each criterion and a copy of
+  /// \p goto_functions sliced with respect to it.  \p goto_functions itself
+  /// is then sliced to the union of all slices.
+  void operator()(
+    goto_functionst &goto_functions,
+    const namespacet &ns,
+    const criteriat &criteria,
+    const slice_handlert &handler);
+
+  /// As above, but with the dependencies given by \p dependencies rather
+  /// than computing them
+  void operator()(
+    goto_functionst &goto_functions,
+    const criteriat &criteria,
+    const instruction_dependenciest &dependencies,
+    const slice_handlert &handler);
+
 protected:
-  struct cfg_nodet
+  /// Set of indices of slicing criteria, stored as a bit set
+  class criteria_sett
   {
-    cfg_nodet():node_required(false)
+  public:
+    bool empty() const
+    {
+      for(const auto word : words)
+      {
+        if(word != 0)
+          return false;
+      }
+      return true;
+    }
+
+    bool contains(std::size_t criterion) const
+    {
+      return criterion / 64 < words.size() &&
+             (words[criterion / 64] >> (criterion % 64) & 1) != 0;
+    }
+
+    void insert(std::size_t criterion)
+    {
+      if(words.size() <= criterion / 64)
+        words.resize(criterion / 64 + 1, 0);
+      words[criterion / 64] |= std::uint64_t(1) << (criterion % 64);
+    }
+
+    void insert(const criteria_sett &other)
     {
+      if(words.size() < other.words.size())
+        words.resize(other.words.size(), 0);
+      for(std::size_t i = 0; i < other.words.size(); ++i)
+        words[i] |= other.words[i];
     }
 
-    bool node_required;
+    void erase(const criteria_sett &other)
+    {
+      for(std::size_t i = 0; i < words.size() && i < other.words.size(); ++i)
+        words[i] &= ~other.words[i];
+    }
+
+    void swap(criteria_sett &other)
+    {
+      words.swap(other.words);
+    }
+
+  protected:
+    std::vector<std::uint64_t> words;
+  };
+
+  struct cfg_nodet
+  {
+    /// The criteria whose slices contain this node
+    criteria_sett required;
+    /// Criteria whose slices are to contain this node once it has been taken
+    /// off the queue
+    criteria_sett pending;
     irep_idt function_id;
 #ifdef DEBUG_FULL_SLICERT
     std::set<unsigned> required_by;
@@ -60,31 +141,51 @@ protected:
   typedef cfg_baset<cfg_nodet> cfgt;
   cfgt cfg;
 
-  typedef std::vector<cfgt::entryt> dep_node_to_cfgt;
+  std::size_t number_of_criteria;
+
   typedef std::stack<cfgt::entryt> queuet;
   typedef std::list<cfgt::entryt> jumpst;
-  typedef std::unordered_map<irep_idt, queuet> decl_deadt;
+
+  /// The declarations and dead instructions of a symbol, and the criteria
+  /// whose slices already contain them
+  struct decl_dead_instructionst
+  {
+    std::vector<cfgt::entryt> entries;
+    criteria_sett required;
+  };
+
+  typedef std::unordered_map<irep_idt, decl_dead_instructionst> decl_deadt;
+
+  void slice(
+    goto_functionst &goto_functions,
+    const criteriat &criteria,
+    const instruction_dependenciest &dependencies,
+    const dependence_grapht::post_dominators_mapt &post_dominators,
+    const slice_handlert &handler);
 
   void fixedpoint(
     goto_functionst &goto_functions,
     queuet &queue,
     jumpst &jumps,
     decl_deadt &decl_dead,
-    const dependence_grapht &dep_graph);
+    const instruction_dependenciest &dependencies,
+    const dependence_grapht::post_dominators_mapt &post_dominators);
 
   void add_dependencies(
     const cfgt::nodet &node,
+    const criteria_sett &criteria,
     queuet &queue,
-    const dependence_grapht &dep_graph,
-    const dep_node_to_cfgt &dep_node_to_cfg);
+    const instruction_dependenciest &dependencies);
 
   void add_function_calls(
     const cfgt::nodet &node,
+    const criteria_sett &criteria,
     queuet &queue,
     const goto_functionst &goto_functions);
 
   void add_decl_dead(
     const cfgt::nodet &node,
+    const criteria_sett &criteria,
     queuet &queue,
     decl_deadt &decl_dead);
 
@@ -93,9 +194,22 @@ protected:
     jumpst &jumps,
     const dependence_grapht::post_dominators_mapt &post_dominators);
 
+  optionalt<goto_programt::const_targett> jump_required_by(
+    const cfgt::nodet &jump,
+    std::size_t criterion,
+    const dependence_grapht::post_dominators_mapt &post_dominators);
+
+  /// Remove the instructions of \p sliced, which is \p goto_functions or a
+  /// copy of it, for which \p is_required does not hold
+  void apply_slice(
+    const goto_functionst &goto_functions,
+    goto_functionst &sliced,
+    const std::function<bool(const cfgt::nodet &)> &is_required);
+
   void add_to_queue(
     queuet &queue,
     const cfgt::entryt &entry,
+    const criteria_sett &criteria,
     goto_programt::const_targett reason)
   {
 #ifdef DEBUG_FULL_SLICERT
@@ -103,7 +217,10 @@ protected:
 #else
     (void)reason; // unused parameter
 #endif
-    queue.push(entry);
+    criteria_sett &pending = cfg[entry].pending;
+    if(pending.empty())
+      queue.push(entry);
+    pending.insert(criteria);
   }
 };
 
@@ -167,4 +284,23 @@ protected:
   const std::list<std::string> &property_ids;
 };
 
+class property_criteriont : public slicing_criteriont
+{
+public:
+  explicit property_criteriont(const irep_idt &_property_id)
+    : property_id(_property_id)
+  {
+  }
+
+  virtual bool
+  operator()(const irep_idt &, goto_programt::const_targett target) const
+  {
+    return target->is_assert() &&
+           target->source_location.get_property_id() == property_id;
+  }
+
+protected:
+  const irep_idt property_id;
+};
+
 #endif // CPROVER_GOTO_INSTRUMENT_FULL_SLICER_CLASS_H
@@ -86,10 +86,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "branch.h"
 #include "call_sequences.h"
 #include "concurrency.h"
+#include "dependence_graph_cache.h"
 #include "document_properties.h"
 #include "dot.h"
 #include "dump_c.h"
 #include "full_slicer.h"
+#include "full_slicer_class.h"
 #include "function.h"
 #include "havoc_loops.h"
 #include "horn_encoding.h"
@@ -543,9 +545,24 @@ int goto_instrument_parse_optionst::doit()
 
       const namespacet ns(goto_model.symbol_table);
       reaching_definitions_analysist rd_analysis(ns);
+      if(cmdline.isset("thread-modular"))
+      {
+        rd_analysis.set_concurrency_mode(
+          reaching_definitions_analysist::concurrency_modet::THREAD_MODULAR);
+      }
       rd_analysis(goto_model);
       rd_analysis.output(goto_model, std::cout);
 
+      for(const auto &thread : rd_analysis.get_thread_statistics())
+      {
+        log.statistics() << "Thread " << thread.first << " converged after "
+                         << thread.second.analyses << " analyses ("
+                         << thread.second.summary_changes
+                         << " changed its interference summary, "
+                         << thread.second.transformers << " transformers)"
+                         << messaget::eom;
+      }
+
       return CPROVER_EXIT_SUCCESS;
     }
 
@@ -1188,6 +1205,12 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     do_indirect_call_and_rtti_removal();
   }
 
+  if(cmdline.isset("points-to-fp-removal"))
+  {
+    points_to_fp_removal(goto_model, ui_message_handler);
+    do_indirect_call_and_rtti_removal();
+  }
+
   // replace function pointers, if explicitly requested
   if(cmdline.isset("remove-function-pointers"))
   {
@@ -1649,7 +1672,87 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     do_remove_returns();
 
     log.status() << "Performing a full slice" << messaget::eom;
-    if(cmdline.isset("property"))
+    if(cmdline.isset("property-slices"))
+    {
+      if(cmdline.args.size() != 2)
+      {
+        throw invalid_command_line_argument_exceptiont(
+          "--property-slices requires an output file",
+          "--property-slices",
+          "goto-instrument --full-slice --property-slices in out");
+      }
+
+      // full_slicer requires that the model has unique location numbers:
+      goto_model.goto_functions.update();
+
+      optionalt<instruction_dependenciest> dependencies;
+      if(cmdline.isset("dependence-graph-cache"))
+      {
+        dependencies = load_or_compute_dependencies(
+          goto_model,
+          cmdline.get_value("dependence-graph-cache"),
+          ui_message_handler);
+      }
+
+      // property ids may contain characters that are not valid in file
+      // names, hence the slices are numbered, and the file listing the
+      // slice of each property is written alongside them
+      std::size_t slice_number = 0;
+      json_objectt slice_files;
+      property_slicer(
+        goto_model,
+        cmdline.get_values("property"),
+        [this, &slice_number, &slice_files](
+          const irep_idt &property_id, goto_functionst &sliced) {
+          const std::string file_name =
+            cmdline.args[1] + "." + std::to_string(++slice_number);
+          log.status() << "Writing slice for property " << property_id
+                       << " to '" << file_name << "'" << messaget::eom;
+
+          std::ofstream out(file_name, std::ios::binary);
+          if(!out || write_goto_binary(out, goto_model.symbol_table, sliced))
+          {
+            throw system_exceptiont(
+              "failed to write slice to '" + file_name + "'");
+          }
+
+          slice_files[id2string(property_id)] = json_stringt(file_name);
+        },
+        dependencies.has_value() ? &*dependencies : nullptr);
+
+      const std::string slices_file_name = cmdline.args[1] + ".slices";
+      std::ofstream slices_out(slices_file_name);
+      if(!slices_out)
+      {
+        throw system_exceptiont(
+          "failed to write list of slices to '" + slices_file_name + "'");
+      }
+      slices_out << slice_files << '\n';
+    }
+    else if(cmdline.isset("dependence-graph-cache"))
+    {
+      // full_slicer requires that the model has unique location numbers:
+      goto_model.goto_functions.update();
+      const instruction_dependenciest dependencies =
+        load_or_compute_dependencies(
+          goto_model,
+          cmdline.get_value("dependence-graph-cache"),
+          ui_message_handler);
+
+      if(cmdline.isset("property"))
+      {
+        full_slicer(
+          goto_model.goto_functions,
+          properties_criteriont(cmdline.get_values("property")),
+          dependencies);
+      }
+      else
+      {
+        full_slicer(
+          goto_model.goto_functions, assert_criteriont(), dependencies);
+      }
+    }
+    else if(cmdline.isset("property"))
       property_slicer(goto_model, cmdline.get_values("property"));
     else
     {
@@ -1772,6 +1875,9 @@ void goto_instrument_parse_optionst::help()
     HELP_SHOW_CLASS_HIERARCHY
     // NOLINTNEXTLINE(whitespace/line_length)
     " --show-threaded              show instructions that may be executed by more than one thread\n"
+    " --show-reaching-definitions  show the reaching definitions of each instruction\n" // NOLINT(*)
+    " --thread-modular             with --show-reaching-definitions, analyse threads\n" // NOLINT(*)
+    "                              separately, using interference summaries\n"
     " --show-local-safe-pointers   show pointer expressions that are trivially dominated by a not-null check\n" // NOLINT(*)
     " --show-safe-dereferences     show pointer expressions that are trivially dominated by a not-null check\n" // NOLINT(*)
     "                              *and* used as a dereference operand\n" // NOLINT(*)
@@ -1835,6 +1941,13 @@ void goto_instrument_parse_optionst::help()
     HELP_REACHABILITY_SLICER
     " --full-slice                 slice away instructions that don't affect assertions\n" // NOLINT(*)
     " --property id                slice with respect to specific property only\n" // NOLINT(*)
+    " --property-slices            with --full-slice, also write the slice for each property\n" // NOLINT(*)
+    "                              (those given by --property, or all) to out.1, out.2, ...\n" // NOLINT(*)
+    "                              in the order of the properties, and the file of each\n" // NOLINT(*)
+    "                              property to out.slices as a JSON object\n" // NOLINT(*)
+    " --dependence-graph-cache file\n"
+    "                              with --full-slice, reuse the dependence graph stored in file\n" // NOLINT(*)
+    "                              if the program has not changed, and store it otherwise\n" // NOLINT(*)
     " --slice-global-inits         slice away initializations of unused global variables\n" // NOLINT(*)
     " --aggressive-slice           remove bodies of any functions not on the shortest path between\n" // NOLINT(*)
     "                              the start function and the function containing the property(s)\n" // NOLINT(*)
@@ -1859,6 +1972,7 @@ void goto_instrument_parse_optionst::help()
     " --value-set-fi-fp-removal    build flow-insensitive value set and replace function pointers by a case statement\n" // NOLINT(*)
     "                              over the possible assignments. If the set of possible assignments is empty the function pointer\n" // NOLINT(*)
     "                              is removed using the standard remove-function-pointers pass. \n" // NOLINT(*)
+    " --points-to-fp-removal       like --value-set-fi-fp-removal, but using a faster inclusion-based points-to analysis\n" // NOLINT(*)
     HELP_RESTRICT_FUNCTION_POINTER
     HELP_REMOVE_CALLS_NO_BODY
     HELP_REMOVE_CONST_FUNCTION_POINTERS
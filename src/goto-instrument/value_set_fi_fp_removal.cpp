@@ -11,6 +11,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/goto_model.h>
 #include <goto-programs/remove_function_pointers.h>
 
+#include <pointer-analysis/andersen_points_to.h>
 #include <pointer-analysis/value_set_analysis_fi.h>
 
 #include <util/base_type.h>
@@ -194,6 +195,36 @@ void value_set_fi_fp_removal(
   value_set_analysis_fit value_sets(ns);
   value_sets(goto_model.goto_functions);
 
+  value_set_fi_fp_removal(goto_model, value_sets, message_handler);
+}
+
+void points_to_fp_removal(
+  goto_modelt &goto_model,
+  message_handlert &message_handler)
+{
+  messaget message(message_handler);
+  message.status() << "Doing inclusion-based points-to analysis"
+                   << messaget::eom;
+
+  const namespacet ns(goto_model.symbol_table);
+  andersen_points_tot points_to(ns);
+  points_to(goto_model.goto_functions);
+
+  const auto &statistics = points_to.get_statistics();
+  message.statistics() << "Points-to graph: " << statistics.nodes
+                       << " nodes, " << statistics.collapsed
+                       << " collapsed on cycles, " << statistics.propagations
+                       << " propagations" << messaget::eom;
+
+  value_set_fi_fp_removal(goto_model, points_to, message_handler);
+}
+
+void value_set_fi_fp_removal(
+  goto_modelt &goto_model,
+  value_setst &value_sets,
+  message_handlert &message_handler)
+{
+  messaget message(message_handler);
   message.status() << "Instrumenting" << messaget::eom;
 
   // now replace aliases by addresses
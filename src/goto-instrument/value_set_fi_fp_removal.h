@@ -14,6 +14,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 class goto_modelt;
 class message_handlert;
+class value_setst;
+
 /// Builds the flow-insensitive value set for all function pointers
 /// and replaces function pointers with a non-deterministic switch
 /// between this set. If the set is empty, the function pointer is
@@ -25,4 +27,23 @@ void value_set_fi_fp_removal(
   goto_modelt &goto_model,
   message_handlert &message_handler);
 
+/// As above, but using the flow-insensitive points-to information in
+/// \p value_sets, which must have been computed for \p goto_model.
+/// \param goto_model: goto model to be modified
+/// \param value_sets: points-to analysis to query
+/// \param message_handler: message handler for status output
+void value_set_fi_fp_removal(
+  goto_modelt &goto_model,
+  value_setst &value_sets,
+  message_handlert &message_handler);
+
+/// Replaces function pointers as \ref value_set_fi_fp_removal does, using the
+/// inclusion-based \ref andersen_points_tot rather than
+/// \ref value_set_analysis_fit, which scales to much larger programs.
+/// \param goto_model: goto model to be modified
+/// \param message_handler: message handler for status output
+void points_to_fp_removal(
+  goto_modelt &goto_model,
+  message_handlert &message_handler);
+
 #endif // CPROVER_GOTO_INSTRUMENT_VALUE_SET_FI_FP_REMOVAL_H
@@ -0,0 +1,184 @@
+/*******************************************************************\
+
+Module: Compressed Streams
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// Stream buffers that compress to / decompress from an underlying stream
+/// using the zlib format
+
+#include "deflate_stream.h"
+
+#include <istream>
+#include <ostream>
+
+#include <miniz/miniz.h>
+
+#include <util/exception_utils.h>
+#include <util/narrow.h>
+
+/// Amount of uncompressed data handed to miniz at a time
+static const std::size_t block_size = 1 << 16;
+
+deflate_streambuft::deflate_streambuft(std::ostream &_out, int level)
+  : out(_out),
+    stream(new mz_stream()),
+    in_buffer(block_size),
+    out_buffer(block_size),
+    finished(false)
+{
+  if(mz_deflateInit(stream.get(), level) != MZ_OK)
+    throw system_exceptiont("failed to initialize compression");
+
+  setp(in_buffer.data(), in_buffer.data() + in_buffer.size());
+}
+
+deflate_streambuft::~deflate_streambuft()
+{
+  if(!finished)
+  {
+    // errors can only be reported by calling finish() explicitly
+    try
+    {
+      finish();
+    }
+    catch(const system_exceptiont &)
+    {
+    }
+  }
+
+  mz_deflateEnd(stream.get());
+}
+
+void deflate_streambuft::compress_buffer(int flush)
+{
+  stream->next_in = reinterpret_cast<const unsigned char *>(pbase());
+  stream->avail_in = narrow_cast<unsigned>(pptr() - pbase());
+
+  while(true)
+  {
+    stream->next_out = reinterpret_cast<unsigned char *>(out_buffer.data());
+    stream->avail_out = narrow_cast<unsigned>(out_buffer.size());
+
+    const int status = mz_deflate(stream.get(), flush);
+
+    if(status != MZ_OK && status != MZ_STREAM_END && status != MZ_BUF_ERROR)
+      throw system_exceptiont("failed to compress output");
+
+    out.write(
+      out_buffer.data(),
+      narrow_cast<std::streamsize>(out_buffer.size() - stream->avail_out));
+
+    // the output buffer not being filled means that miniz is done with
+    // everything we have handed over so far
+    if(status == MZ_STREAM_END || status == MZ_BUF_ERROR)
+      break;
+    if(flush != MZ_FINISH && stream->avail_in == 0 && stream->avail_out != 0)
+      break;
+  }
+
+  setp(in_buffer.data(), in_buffer.data() + in_buffer.size());
+}
+
+deflate_streambuft::int_type deflate_streambuft::overflow(int_type ch)
+{
+  if(finished)
+    return traits_type::eof();
+
+  compress_buffer(MZ_NO_FLUSH);
+
+  if(!traits_type::eq_int_type(ch, traits_type::eof()))
+  {
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+  }
+
+  return traits_type::not_eof(ch);
+}
+
+int deflate_streambuft::sync()
+{
+  if(!finished)
+    compress_buffer(MZ_SYNC_FLUSH);
+
+  out.flush();
+  return out.good() ? 0 : -1;
+}
+
+void deflate_streambuft::finish()
+{
+  if(finished)
+    return;
+
+  compress_buffer(MZ_FINISH);
+  finished = true;
+  setp(nullptr, nullptr);
+  mz_deflateEnd(stream.get());
+
+  if(!out.good())
+    throw system_exceptiont("failed to write compressed output");
+}
+
+inflate_streambuft::inflate_streambuft(std::istream &_in)
+  : in(_in),
+    stream(new mz_stream()),
+    in_buffer(block_size),
+    out_buffer(block_size),
+    finished(false)
+{
+  if(mz_inflateInit(stream.get()) != MZ_OK)
+    throw system_exceptiont("failed to initialize decompression");
+}
+
+inflate_streambuft::~inflate_streambuft()
+{
+  mz_inflateEnd(stream.get());
+}
+
+/// Corrupt or truncated input yields end-of-file, which the consumer of the
+/// stream is expected to report.
+inflate_streambuft::int_type inflate_streambuft::underflow()
+{
+  if(gptr() < egptr())
+    return traits_type::to_int_type(*gptr());
+
+  while(!finished)
+  {
+    if(stream->avail_in == 0)
+    {
+      in.read(in_buffer.data(), narrow_cast<std::streamsize>(in_buffer.size()));
+      if(in.gcount() == 0)
+        return traits_type::eof();
+
+      stream->next_in =
+        reinterpret_cast<const unsigned char *>(in_buffer.data());
+      stream->avail_in = narrow_cast<unsigned>(in.gcount());
+    }
+
+    stream->next_out = reinterpret_cast<unsigned char *>(out_buffer.data());
+    stream->avail_out = narrow_cast<unsigned>(out_buffer.size());
+
+    const int status = mz_inflate(stream.get(), MZ_NO_FLUSH);
+
+    if(status == MZ_STREAM_END)
+      finished = true;
+    else if(status != MZ_OK && status != MZ_BUF_ERROR)
+      return traits_type::eof();
+
+    const std::size_t produced = out_buffer.size() - stream->avail_out;
+
+    if(produced != 0)
+    {
+      setg(
+        out_buffer.data(), out_buffer.data(), out_buffer.data() + produced);
+      return traits_type::to_int_type(*gptr());
+    }
+    else if(status == MZ_BUF_ERROR && stream->avail_in != 0)
+      return traits_type::eof();
+  }
+
+  return traits_type::eof();
+}
@@ -0,0 +1,78 @@
+/*******************************************************************\
+
+Module: Compressed Streams
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// Stream buffers that compress to / decompress from an underlying stream
+/// using the zlib format
+
+#ifndef CPROVER_GOTO_PROGRAMS_DEFLATE_STREAM_H
+#define CPROVER_GOTO_PROGRAMS_DEFLATE_STREAM_H
+
+#include <iosfwd>
+#include <memory>
+#include <streambuf>
+#include <vector>
+
+struct mz_stream_s;
+
+/// Compresses everything written to it and passes the result on to an
+/// output stream, one block at a time. The compressed stream is terminated
+/// by \ref finish, or by the destructor if \ref finish was not called.
+class deflate_streambuft : public std::streambuf
+{
+public:
+  /// \param out: stream to write the compressed data to
+  /// \param level: compression level between 0 (none) and 9 (best)
+  explicit deflate_streambuft(std::ostream &out, int level = 6);
+  ~deflate_streambuft() override;
+
+  deflate_streambuft(const deflate_streambuft &) = delete;
+  deflate_streambuft &operator=(const deflate_streambuft &) = delete;
+
+  /// Compress any buffered data and write the end of the compressed stream
+  void finish();
+
+protected:
+  int_type overflow(int_type) override;
+  int sync() override;
+
+private:
+  std::ostream &out;
+  std::unique_ptr<mz_stream_s> stream;
+  std::vector<char> in_buffer;
+  std::vector<char> out_buffer;
+  bool finished;
+
+  void compress_buffer(int flush);
+};
+
+/// Decompresses data read from an input stream. Input is read ahead in
+/// blocks, hence the compressed data must extend to the end of the
+/// underlying stream.
+class inflate_streambuft : public std::streambuf
+{
+public:
+  /// \param in: stream to read the compressed data from
+  explicit inflate_streambuft(std::istream &in);
+  ~inflate_streambuft() override;
+
+  inflate_streambuft(const inflate_streambuft &) = delete;
+  inflate_streambuft &operator=(const inflate_streambuft &) = delete;
+
+protected:
+  int_type underflow() override;
+
+private:
+  std::istream &in;
+  std::unique_ptr<mz_stream_s> stream;
+  std::vector<char> in_buffer;
+  std::vector<char> out_buffer;
+  bool finished;
+};
+
+#endif // CPROVER_GOTO_PROGRAMS_DEFLATE_STREAM_H
@@ -13,22 +13,109 @@ Date: June 2006
 
 #include "read_bin_goto_object.h"
 
+#include <util/exception_utils.h>
 #include <util/namespace.h>
 #include <util/message.h>
 #include <util/symbol_table.h>
 #include <util/irep_serialization.h>
 
+#include "deflate_stream.h"
 #include "goto_functions.h"
 #include "write_goto_binary.h"
 
+/// Reads the string table and irep dictionary at the beginning of a
+/// compressed goto binary, and then resolves the references to them.
+class irep_dictionary_readert
+{
+public:
+  explicit irep_dictionary_readert(irep_serializationt &_irepconverter)
+    : irepconverter(_irepconverter)
+  {
+  }
+
+  void read(std::istream &);
+
+  const irept &reference_convert(std::istream &in)
+  {
+    const std::size_t n = read_gb_word(in);
+    if(n >= ireps.size())
+      throw deserialization_exceptiont("irep number out of range");
+    return ireps[n];
+  }
+
+  irep_idt read_string_ref(std::istream &in)
+  {
+    const std::size_t n = read_gb_word(in);
+    if(n >= strings.size())
+      throw deserialization_exceptiont("string number out of range");
+    return strings[n];
+  }
+
+  static std::size_t read_gb_word(std::istream &in)
+  {
+    return irep_serializationt::read_gb_word(in);
+  }
+
+  irep_idt read_gb_string(std::istream &in)
+  {
+    return irepconverter.read_gb_string(in);
+  }
+
+protected:
+  irep_serializationt &irepconverter;
+  std::vector<irep_idt> strings;
+  std::vector<irept> ireps;
+};
+
+void irep_dictionary_readert::read(std::istream &in)
+{
+  const std::size_t string_count = read_gb_word(in);
+  strings.reserve(string_count);
+  for(std::size_t i = 0; i < string_count; ++i)
+    strings.push_back(read_gb_string(in));
+
+  // ireps only ever refer to ireps with smaller numbers
+  const std::size_t irep_count = read_gb_word(in);
+  ireps.reserve(irep_count);
+  for(std::size_t i = 0; i < irep_count; ++i)
+  {
+    irep_idt id = read_string_ref(in);
+    irept::subt sub;
+    irept::named_subt named_sub;
+
+    const std::size_t sub_count = read_gb_word(in);
+    sub.reserve(sub_count);
+    for(std::size_t j = 0; j < sub_count; ++j)
+      sub.push_back(reference_convert(in));
+
+    const std::size_t named_sub_count = read_gb_word(in);
+#if NAMED_SUB_IS_FORWARD_LIST
+    irept::named_subt::iterator before = named_sub.before_begin();
+#endif
+    for(std::size_t j = 0; j < named_sub_count; ++j)
+    {
+      irep_idt name = read_string_ref(in);
+#if NAMED_SUB_IS_FORWARD_LIST
+      named_sub.emplace_after(before, name, reference_convert(in));
+      ++before;
+#else
+      named_sub.emplace(name, reference_convert(in));
+#endif
+    }
+
+    ireps.emplace_back(std::move(id), std::move(named_sub), std::move(sub));
+  }
+}
+
 /// read goto binary format
 /// \par parameters: input stream, symbol_table, functions
 /// \return true on error, false otherwise
+template <typename irep_convertert>
 static bool read_bin_goto_object(
   std::istream &in,
   symbol_tablet &symbol_table,
   goto_functionst &functions,
-  irep_serializationt &irepconverter)
+  irep_convertert &irepconverter)
 {
   std::size_t count = irepconverter.read_gb_word(in); // # of symbols
 
@@ -232,6 +319,17 @@ bool read_bin_goto_object(
     {
       return read_bin_goto_object(in, symbol_table, functions, irepconverter);
     }
+    else if(version == GOTO_BINARY_COMPRESSED_VERSION)
+    {
+      inflate_streambuft inflater(in);
+      std::istream decompressed(&inflater);
+
+      irep_dictionary_readert dictionary(irepconverter);
+      dictionary.read(decompressed);
+
+      return read_bin_goto_object(
+        decompressed, symbol_table, functions, dictionary);
+    }
     else
     {
       message.error() <<
@@ -12,21 +12,133 @@ Author: CM Wintersteiger
 #include "write_goto_binary.h"
 
 #include <fstream>
+#include <unordered_map>
 
 #include <util/exception_utils.h>
 #include <util/invariant.h>
+#include <util/irep_hash.h>
 #include <util/irep_serialization.h>
 #include <util/message.h>
 #include <util/symbol_table.h>
 
 #include <goto-programs/goto_model.h>
 
+#include "deflate_stream.h"
+
+/// Numbers strings and ireps so that each of them can be written once, up
+/// front, and be referred to by its number afterwards. Ireps are numbered
+/// bottom-up and told apart by content including comments. As a first
+/// level, ireps are looked up by the address of their content, hence all
+/// ireps passed in need to stay alive while the writer is in use.
+class irep_dictionary_writert
+{
+public:
+  void reference_convert(const irept &irep, std::ostream &out)
+  {
+    write_gb_word(out, number(irep));
+  }
+
+  void write_string_ref(std::ostream &out, const irep_idt &s)
+  {
+    write_gb_word(out, number(s));
+  }
+
+  /// Write the string table followed by all ireps in the order of their
+  /// numbers, which puts each irep after all of its subtrees
+  void write(std::ostream &out) const;
+
+protected:
+  std::unordered_map<irep_idt, std::size_t, irep_id_hash> string_numbers;
+  std::vector<irep_idt> strings;
+
+  // an irep is packed as: the number of its id, the number of subs, their
+  // numbers, the number of named subs, and pairs of name and irep number
+  typedef std::vector<std::size_t> packedt;
+
+  struct packed_hasht
+  {
+    std::size_t operator()(const packedt &packed) const
+    {
+      std::size_t result = packed.size();
+      for(const auto n : packed)
+        result = hash_combine(result, n);
+      return result;
+    }
+  };
+
+  std::unordered_map<const void *, std::size_t> irep_numbers;
+  std::unordered_map<packedt, std::size_t, packed_hasht> packed_numbers;
+  std::vector<const packedt *> ireps;
+
+  std::size_t number(const irep_idt &);
+  std::size_t number(const irept &);
+};
+
+std::size_t irep_dictionary_writert::number(const irep_idt &s)
+{
+  const auto entry = string_numbers.emplace(s, strings.size());
+  if(entry.second)
+    strings.push_back(s);
+  return entry.first->second;
+}
+
+std::size_t irep_dictionary_writert::number(const irept &irep)
+{
+  const auto it = irep_numbers.find(&irep.read());
+  if(it != irep_numbers.end())
+    return it->second;
+
+  packedt packed;
+  packed.push_back(number(irep.id()));
+
+  packed.push_back(irep.get_sub().size());
+  for(const auto &sub_irep : irep.get_sub())
+    packed.push_back(number(sub_irep));
+
+  const std::size_t named_sub_size_index = packed.size();
+  packed.push_back(0);
+  for(const auto &sub_irep_entry : irep.get_named_sub())
+  {
+    packed.push_back(number(sub_irep_entry.first));
+    packed.push_back(number(sub_irep_entry.second));
+    ++packed[named_sub_size_index];
+  }
+
+  const auto entry = packed_numbers.emplace(std::move(packed), ireps.size());
+  if(entry.second)
+    ireps.push_back(&entry.first->first);
+
+  irep_numbers.emplace(&irep.read(), entry.first->second);
+
+  return entry.first->second;
+}
+
+void irep_dictionary_writert::write(std::ostream &out) const
+{
+  write_gb_word(out, strings.size());
+  for(const auto &s : strings)
+    write_gb_string(out, id2string(s));
+
+  write_gb_word(out, ireps.size());
+  for(const auto packed : ireps)
+  {
+    for(const auto n : *packed)
+      write_gb_word(out, n);
+  }
+}
+
 /// Writes a goto program to disc, using goto binary format
-bool write_goto_binary(
+/// \param out: target stream
+/// \param symbol_table: symbols to write
+/// \param goto_functions: functions to write
+/// \param irepconverter: writes references to ireps and strings, either
+///   \ref irep_serializationt or \ref irep_dictionary_writert
+template <typename irep_convertert>
+static bool write_goto_binary(
   std::ostream &out,
   const symbol_tablet &symbol_table,
   const goto_functionst &goto_functions,
-  irep_serializationt &irepconverter)
+  irep_convertert &irepconverter)
 {
   // first write symbol table
 
@@ -121,6 +233,32 @@ bool write_goto_binary(
   return false;
 }
 
+/// Writes a goto program to disc, using the compressed goto binary format:
+/// a string table and a dictionary of all ireps are followed by the symbols
+/// and functions, which refer to strings and ireps by number. Everything is
+/// compressed block by block while being written.
+static bool write_compressed_goto_binary(
+  std::ostream &out,
+  const symbol_tablet &symbol_table,
+  const goto_functionst &goto_functions)
+{
+  irep_dictionary_writert irepconverter;
+
+  // first pass: number all strings and ireps, discarding any output
+  std::ostream discard(nullptr);
+  write_goto_binary(discard, symbol_table, goto_functions, irepconverter);
+
+  deflate_streambuft deflater(out);
+  std::ostream compressed(&deflater);
+
+  irepconverter.write(compressed);
+  write_goto_binary(compressed, symbol_table, goto_functions, irepconverter);
+
+  deflater.finish();
+
+  return false;
+}
+
 /// Writes a goto program to disc
 bool write_goto_binary(
   std::ostream &out,
@@ -148,23 +286,30 @@ bool write_goto_binary(
   irep_serializationt::ireps_containert irepc;
   irep_serializationt irepconverter(irepc);
 
+  const std::string supported_versions =
+    "supported versions = " + std::to_string(GOTO_BINARY_VERSION) + ", " +
+    std::to_string(GOTO_BINARY_COMPRESSED_VERSION);
+
   if(version < GOTO_BINARY_VERSION)
     throw invalid_command_line_argument_exceptiont(
       "version " + std::to_string(version) + " no longer supported",
-      "supported version = " + std::to_string(GOTO_BINARY_VERSION));
-  else if(version > GOTO_BINARY_VERSION)
+      supported_versions);
+  else if(version == GOTO_BINARY_VERSION)
+    return write_goto_binary(out, symbol_table, goto_functions, irepconverter);
+  else if(version == GOTO_BINARY_COMPRESSED_VERSION)
+    return write_compressed_goto_binary(out, symbol_table, goto_functions);
+  else
     throw invalid_command_line_argument_exceptiont(
       "unknown goto binary version " + std::to_string(version),
-      "supported version = " + std::to_string(GOTO_BINARY_VERSION));
-  else
-    return write_goto_binary(out, symbol_table, goto_functions, irepconverter);
+      supported_versions);
 }
 
 /// Writes a goto program to disc
 bool write_goto_binary(
   const std::string &filename,
   const goto_modelt &goto_model,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  int version)
 {
   std::ofstream out(filename, std::ios::binary);
 
@@ -175,5 +320,5 @@ bool write_goto_binary(
     return true;
   }
 
-  return write_goto_binary(out, goto_model);
+  return write_goto_binary(out, goto_model, version);
 }
@@ -14,6 +14,10 @@ Author: CM Wintersteiger
 
 #define GOTO_BINARY_VERSION 5
 
+/// Goto binaries of this version consist of the usual header followed by a
+/// compressed string table, irep dictionary, symbols and functions
+#define GOTO_BINARY_COMPRESSED_VERSION 6
+
 #include <iosfwd>
 #include <string>
 
@@ -36,6 +40,7 @@ bool write_goto_binary(
 bool write_goto_binary(
   const std::string &filename,
   const goto_modelt &,
-  message_handlert &);
+  message_handlert &,
+  int version = GOTO_BINARY_VERSION);
 
 #endif // CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H
@@ -33,7 +33,7 @@ unsigned goto_symext::dynamic_counter=0;
 void goto_symext::do_simplify(exprt &expr)
 {
   if(symex_config.simplify_opt)
-    simplify(expr, ns);
+    simplify(expr, ns, simplify_cache);
 }
 
 void goto_symext::symex_assign(statet &state, const code_assignt &code)
@@ -98,7 +98,7 @@ void goto_symext::symex_assign(statet &state, const code_assignt &code)
       assignment_type = symex_targett::assignment_typet::HIDDEN;
 
     symex_assignt symex_assign{
-      state, assignment_type, ns, symex_config, target};
+      state, assignment_type, ns, symex_config, target, &simplify_cache};
 
     // Try to constant propagate potential side effects of the assignment, when
     // simplification is turned on and there is one thread only. Constant
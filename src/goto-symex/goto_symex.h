@@ -14,6 +14,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/options.h>
 #include <util/message.h>
+#include <util/simplify_expr_cache.h>
 
 #include <goto-programs/abstract_goto_model.h>
 
@@ -255,6 +256,11 @@ protected:
   /// goto-program, and the names of dynamically-created objects.
   namespacet ns;
 
+  /// Results of \ref do_simplify and of simplifying assignments. Cleared
+  /// whenever \ref ns is changed, as the symbols minted during symbolic
+  /// execution may differ between states.
+  simplify_expr_cachet simplify_cache;
+
   /// Used to create guards. Guards created with different guard managers cannot
   /// be combined together, so guards created by goto-symex should not escape
   /// the scope of this manager.
@@ -165,7 +165,12 @@ void symex_assignt::assign_non_struct_symbol(
   assignmentt assignment{lhs, full_lhs, l2_rhs};
 
   if(symex_config.simplify_opt)
-    assignment.rhs = simplify_expr(std::move(assignment.rhs), ns);
+  {
+    assignment.rhs =
+      simplify_cache == nullptr
+        ? simplify_expr(std::move(assignment.rhs), ns)
+        : simplify_expr(std::move(assignment.rhs), ns, *simplify_cache);
+  }
 
   const ssa_exprt l2_lhs = state
                              .assignment(
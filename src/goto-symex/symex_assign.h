@@ -18,6 +18,7 @@ Author: Romain Brenguier, romain.brenguier@diffblue.com
 class byte_extract_exprt;
 class expr_skeletont;
 class goto_symex_statet;
+class simplify_expr_cachet;
 class ssa_exprt;
 struct symex_configt;
 
@@ -30,12 +31,14 @@ public:
     symex_targett::assignment_typet assignment_type,
     const namespacet &ns,
     const symex_configt &symex_config,
-    symex_targett &target)
+    symex_targett &target,
+    simplify_expr_cachet *simplify_cache = nullptr)
     : state(state),
       assignment_type(assignment_type),
       ns(ns),
       symex_config(symex_config),
-      target(target)
+      target(target),
+      simplify_cache(simplify_cache)
   {
   }
 
@@ -61,6 +64,8 @@ private:
   const namespacet &ns;
   const symex_configt &symex_config;
   symex_targett &target;
+  /// Cache of simplification results, if any
+  simplify_expr_cachet *simplify_cache;
 
   void assign_from_struct(
     const ssa_exprt &lhs, // L1
@@ -189,8 +189,12 @@ void goto_symext::lift_let(statet &state, const let_exprt &let_expr)
   do_simplify(let_value);
 
   exprt::operandst value_assignment_guard;
-  symex_assignt{
-    state, symex_targett::assignment_typet::HIDDEN, ns, symex_config, target}
+  symex_assignt{state,
+                symex_targett::assignment_typet::HIDDEN,
+                ns,
+                symex_config,
+                target,
+                &simplify_cache}
     .assign_symbol(
       to_ssa_expr(state.rename<L1>(let_expr.symbol(), ns).get()),
       expr_skeletont{},
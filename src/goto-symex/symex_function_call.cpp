@@ -141,7 +141,8 @@ void goto_symext::parameter_assignments(
       rhs = clean_expr(std::move(rhs), state, false);
 
       exprt::operandst lhs_conditions;
-      symex_assignt{state, assignment_type, ns, symex_config, target}
+      symex_assignt{
+        state, assignment_type, ns, symex_config, target, &simplify_cache}
         .assign_rec(lhs, expr_skeletont{}, rhs, lhs_conditions);
     }
 
@@ -353,6 +353,7 @@ void goto_symext::symex_with_state(
   // `state`'s symbol table and the symbol table of the original
   // goto-program.
   ns = namespacet(outer_symbol_table, state.symbol_table);
+  simplify_cache.clear();
 
   // whichever way we exit this method, reset the namespace back to a sane state
   // as state.symbol_table might go out of scope
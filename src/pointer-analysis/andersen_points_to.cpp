@@ -0,0 +1,676 @@
+/*******************************************************************\
+
+Module: Inclusion-Based Points-To Analysis
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Flow- and context-insensitive inclusion-based (Andersen-style) points-to
+/// analysis
+
+#include "andersen_points_to.h"
+
+#include <util/c_types.h>
+#include <util/namespace.h>
+#include <util/pointer_expr.h>
+#include <util/std_code.h>
+#include <util/string_constant.h>
+
+#include <goto-programs/remove_returns.h>
+
+#include <map>
+
+void andersen_points_tot::operator()(const goto_functionst &goto_functions)
+{
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    if(gf_entry.second.body_available())
+      parameters[gf_entry.first] = gf_entry.second.parameter_identifiers;
+  }
+
+  for(const auto &gf_entry : goto_functions.function_map)
+  {
+    forall_goto_program_instructions(i_it, gf_entry.second.body)
+      instruction(gf_entry.first, i_it);
+  }
+
+  solve();
+}
+
+std::vector<exprt> andersen_points_tot::get_values(
+  const irep_idt &function_id,
+  goto_programt::const_targett l,
+  const exprt &expr)
+{
+  current_function = function_id;
+  current_location = l;
+
+  const auto node = eval(expr);
+  if(!node.has_value())
+    return {};
+
+  // the query may have added constraints
+  solve();
+
+  std::vector<exprt> result;
+  for(const auto object : nodes[cycles.find(*node)].points_to)
+    result.push_back(object_descriptor_exprt(objects[object]));
+
+  return result;
+}
+
+void andersen_points_tot::instruction(
+  const irep_idt &function_id,
+  goto_programt::const_targett target)
+{
+  current_function = function_id;
+  current_location = target;
+
+  if(target->is_assign())
+  {
+    const code_assignt &code_assign = target->get_assign();
+    assign(code_assign.lhs(), code_assign.rhs());
+  }
+  else if(target->is_function_call())
+  {
+    const code_function_callt &call = target->get_function_call();
+    function_call(call.lhs(), call.function(), call.arguments());
+  }
+  else if(target->is_return())
+  {
+    const code_returnt &code_return = target->get_return();
+    if(code_return.has_return_value())
+    {
+      const exprt &return_value = code_return.return_value();
+      assign(
+        symbol_exprt(
+          return_value_identifier(function_id), return_value.type()),
+        return_value);
+    }
+  }
+}
+
+void andersen_points_tot::assign(const exprt &lhs, const exprt &rhs)
+{
+  const typet &type = ns.follow(lhs.type());
+
+  // struct members are separate locations, copy them one by one
+  if(type.id() == ID_struct)
+  {
+    const auto &components = to_struct_type(type).components();
+
+    if(rhs.id() == ID_struct && rhs.operands().size() == components.size())
+    {
+      for(std::size_t i = 0; i < components.size(); ++i)
+        assign(member_exprt(lhs, components[i]), rhs.operands()[i]);
+    }
+    else
+    {
+      for(const auto &component : components)
+      {
+        assign(
+          member_exprt(lhs, component),
+          member_exprt(rhs, component.get_name(), component.type()));
+      }
+    }
+
+    return;
+  }
+
+  const auto source = eval(rhs);
+  if(source.has_value())
+    write(access(lhs), *source);
+}
+
+void andersen_points_tot::function_call(
+  const exprt &lhs,
+  const exprt &function,
+  const exprt::operandst &arguments)
+{
+  if(function.id() == ID_symbol)
+  {
+    bind_call(to_symbol_expr(function).get_identifier(), lhs, arguments);
+    return;
+  }
+
+  if(function.id() != ID_dereference)
+    return;
+
+  const auto pointer = eval(to_dereference_expr(function).pointer());
+  if(!pointer.has_value())
+    return;
+
+  callt call;
+  call.function_id = current_function;
+  call.location = current_location;
+  call.lhs = lhs;
+  call.arguments = arguments;
+  calls.push_back(std::move(call));
+
+  complex_constraintt constraint;
+  constraint.kind = complex_constraintt::kindt::CALL;
+  constraint.node = *pointer;
+  constraint.call = calls.size() - 1;
+  add_constraint(*pointer, constraint);
+}
+
+void andersen_points_tot::bind_call(
+  const irep_idt &callee,
+  const exprt &lhs,
+  const exprt::operandst &arguments)
+{
+  const auto parameters_entry = parameters.find(callee);
+
+  if(parameters_entry == parameters.end())
+  {
+    // we do not know what the function does, but it may allocate memory
+    if(lhs.is_not_nil() && lhs.type().id() == ID_pointer)
+    {
+      const node_indext result = new_node();
+      add_object(result, heap_object(to_pointer_type(lhs.type()).subtype()));
+      write(access(lhs), result);
+    }
+
+    return;
+  }
+
+  // copy, as looking up the parameters below may rehash the map
+  const std::vector<irep_idt> parameter_identifiers = parameters_entry->second;
+
+  for(std::size_t i = 0;
+      i < parameter_identifiers.size() && i < arguments.size();
+      ++i)
+  {
+    const symbolt *parameter;
+    if(
+      parameter_identifiers[i].empty() ||
+      ns.lookup(parameter_identifiers[i], parameter))
+    {
+      continue;
+    }
+
+    assign(parameter->symbol_expr(), arguments[i]);
+  }
+
+  if(lhs.is_not_nil())
+  {
+    assign(
+      lhs, symbol_exprt(return_value_identifier(callee), lhs.type()));
+  }
+}
+
+optionalt<andersen_points_tot::node_indext>
+andersen_points_tot::eval(const exprt &expr)
+{
+  if(expr.type().id() == ID_bool)
+    return {};
+
+  if(
+    expr.id() == ID_address_of ||
+    (expr.id() == ID_symbol && expr.type().id() == ID_code))
+  {
+    const accesst target = access(
+      expr.id() == ID_address_of ? to_address_of_expr(expr).object() : expr);
+
+    if(target.pointer.has_value())
+    {
+      // &*p is p
+      if(target.path.empty())
+        return target.pointer;
+
+      complex_constraintt constraint;
+      constraint.kind = complex_constraintt::kindt::OFFSET;
+      constraint.node = new_node();
+      constraint.path = target.path;
+      add_constraint(*target.pointer, constraint);
+      return constraint.node;
+    }
+    else if(target.base.has_value())
+    {
+      const node_indext result = new_node();
+      add_object(result, *target.base);
+      return result;
+    }
+
+    return {};
+  }
+  else if(
+    expr.id() == ID_member &&
+    to_member_expr(expr).struct_op().id() == ID_if)
+  {
+    const member_exprt &member = to_member_expr(expr);
+    const if_exprt &if_expr = to_if_expr(member.struct_op());
+
+    return eval(if_exprt(
+      if_expr.cond(),
+      member_exprt(
+        if_expr.true_case(), member.get_component_name(), member.type()),
+      member_exprt(
+        if_expr.false_case(), member.get_component_name(), member.type())));
+  }
+  else if(
+    expr.id() == ID_symbol || expr.id() == ID_member ||
+    expr.id() == ID_index || expr.id() == ID_dereference)
+  {
+    const auto result = read(access(expr));
+    if(result.has_value())
+      return result;
+  }
+  else if(
+    expr.id() == ID_side_effect &&
+    to_side_effect_expr(expr).get_statement() == ID_allocate)
+  {
+    const node_indext result = new_node();
+    const typet &allocated_type =
+      static_cast<const typet &>(expr.find(ID_C_cxx_alloc_type));
+    add_object(result, heap_object(allocated_type));
+    return result;
+  }
+
+  // anything else may point to whatever its operands point to
+  std::vector<node_indext> sources;
+  for(const auto &op : expr.operands())
+  {
+    const auto source = eval(op);
+    if(source.has_value())
+      sources.push_back(*source);
+  }
+
+  if(sources.empty())
+    return {};
+  else if(sources.size() == 1)
+    return sources.front();
+
+  const node_indext result = new_node();
+  for(const auto source : sources)
+    add_edge(source, result);
+  return result;
+}
+
+andersen_points_tot::accesst andersen_points_tot::access(const exprt &expr)
+{
+  if(expr.id() == ID_symbol)
+  {
+    accesst result;
+    result.base = named_node(to_symbol_expr(expr).get_identifier(), expr);
+    return result;
+  }
+  else if(expr.id() == ID_member)
+  {
+    const member_exprt &member = to_member_expr(expr);
+    accesst result = access(member.struct_op());
+    if(result.pointer.has_value())
+      result.path.push_back(member.get_component_name());
+    else if(result.base.has_value())
+      result.base = field(*result.base, member.get_component_name());
+    return result;
+  }
+  else if(expr.id() == ID_index)
+  {
+    // all elements of an array are the same location
+    return access(to_index_expr(expr).array());
+  }
+  else if(expr.id() == ID_dereference)
+  {
+    accesst result;
+    result.pointer = eval(to_dereference_expr(expr).pointer());
+    return result;
+  }
+  else if(
+    expr.id() == ID_typecast || expr.id() == ID_byte_extract_little_endian ||
+    expr.id() == ID_byte_extract_big_endian)
+  {
+    return access(expr.operands().front());
+  }
+  else if(expr.id() == ID_string_constant)
+  {
+    accesst result;
+    result.base = named_node(
+      "andersen_points_to::string_constant::" +
+        id2string(to_string_constant(expr).get_value()),
+      expr);
+    return result;
+  }
+
+  return {};
+}
+
+optionalt<andersen_points_tot::node_indext>
+andersen_points_tot::read(const accesst &access)
+{
+  if(access.base.has_value())
+    return access.base;
+
+  if(!access.pointer.has_value())
+    return {};
+
+  complex_constraintt constraint;
+  constraint.kind = complex_constraintt::kindt::LOAD;
+  constraint.node = new_node();
+  constraint.path = access.path;
+  add_constraint(*access.pointer, constraint);
+  return constraint.node;
+}
+
+void andersen_points_tot::write(const accesst &access, node_indext source)
+{
+  if(access.base.has_value())
+  {
+    add_edge(source, *access.base);
+  }
+  else if(access.pointer.has_value())
+  {
+    complex_constraintt constraint;
+    constraint.kind = complex_constraintt::kindt::STORE;
+    constraint.node = source;
+    constraint.path = access.path;
+    add_constraint(*access.pointer, constraint);
+  }
+}
+
+andersen_points_tot::node_indext andersen_points_tot::new_node()
+{
+  nodes.emplace_back();
+  objects.push_back(nil_exprt());
+  node_names.push_back(irep_idt());
+  ++statistics.nodes;
+  return nodes.size() - 1;
+}
+
+andersen_points_tot::node_indext
+andersen_points_tot::named_node(const irep_idt &name, const exprt &object)
+{
+  const auto entry = node_numbers.find(name);
+  if(entry != node_numbers.end())
+    return entry->second;
+
+  const node_indext node = new_node();
+  objects[node] = object;
+  node_names[node] = name;
+  node_numbers.emplace(name, node);
+  return node;
+}
+
+andersen_points_tot::node_indext andersen_points_tot::field(
+  node_indext object,
+  const irep_idt &component_name)
+{
+  const exprt &struct_op = objects[object];
+  const typet &type = ns.follow(struct_op.type());
+
+  // arrays, unions and anything accessed through a type cast are not split
+  if(type.id() != ID_struct)
+    return object;
+
+  const struct_typet &struct_type = to_struct_type(type);
+  if(!struct_type.has_component(component_name))
+    return object;
+
+  const exprt member = member_exprt(
+    struct_op, struct_type.get_component(component_name));
+
+  return named_node(
+    id2string(node_names[object]) + "." + id2string(component_name), member);
+}
+
+andersen_points_tot::node_indext
+andersen_points_tot::field(node_indext object, const patht &path)
+{
+  for(const auto &component_name : path)
+    object = field(object, component_name);
+  return object;
+}
+
+andersen_points_tot::node_indext
+andersen_points_tot::heap_object(const typet &type)
+{
+  const std::string name = "andersen_points_to::dynamic_object::" +
+                           id2string(current_function) + "::" +
+                           std::to_string(current_location->location_number);
+
+  const auto entry = node_numbers.find(name);
+  if(entry != node_numbers.end())
+    return entry->second;
+
+  dynamic_object_exprt dynamic_object(type);
+  dynamic_object.set_instance(node_numbers.size());
+  dynamic_object.valid() = true_exprt();
+
+  return named_node(name, dynamic_object);
+}
+
+void andersen_points_tot::add_object(node_indext node, node_indext object)
+{
+  node = cycles.find(node);
+
+  if(nodes[node].points_to.insert(object).second)
+  {
+    nodes[node].delta.insert(object);
+    push(node);
+  }
+}
+
+void andersen_points_tot::add_edge(
+  node_indext source,
+  node_indext destination)
+{
+  source = cycles.find(source);
+  destination = cycles.find(destination);
+
+  if(source == destination)
+    return;
+
+  if(!nodes[source].successors.insert(destination).second)
+    return;
+
+  // a new edge needs all objects, not only the recent ones
+  propagate(source, destination, nodes[source].points_to);
+}
+
+void andersen_points_tot::add_constraint(
+  node_indext pointer,
+  const complex_constraintt &constraint)
+{
+  pointer = cycles.find(pointer);
+  nodes[pointer].constraints.push_back(constraint);
+
+  // applying the constraint may add to the points-to set of the pointer
+  const objectst objects = nodes[pointer].points_to;
+  for(const auto object : objects)
+    apply(constraint, object);
+}
+
+void andersen_points_tot::apply(
+  const complex_constraintt &constraint,
+  node_indext object)
+{
+  switch(constraint.kind)
+  {
+  case complex_constraintt::kindt::LOAD:
+    add_edge(field(object, constraint.path), constraint.node);
+    break;
+
+  case complex_constraintt::kindt::STORE:
+    add_edge(constraint.node, field(object, constraint.path));
+    break;
+
+  case complex_constraintt::kindt::OFFSET:
+    add_object(constraint.node, field(object, constraint.path));
+    break;
+
+  case complex_constraintt::kindt::CALL:
+  {
+    const exprt &function = objects[object];
+    if(function.id() != ID_symbol || function.type().id() != ID_code)
+      break;
+
+    const irep_idt callee = to_symbol_expr(function).get_identifier();
+    if(!calls[constraint.call].targets.insert(callee).second)
+      break;
+
+    // binding may add calls, invalidating references into the vector
+    const callt call = calls[constraint.call];
+    const irep_idt function_id = current_function;
+    const goto_programt::const_targett location = current_location;
+    current_function = call.function_id;
+    current_location = call.location;
+    bind_call(callee, call.lhs, call.arguments);
+    current_function = function_id;
+    current_location = location;
+    break;
+  }
+  }
+}
+
+void andersen_points_tot::propagate(
+  node_indext source,
+  node_indext destination,
+  const objectst &objects)
+{
+  ++statistics.propagations;
+
+  bool changed = false;
+  for(const auto object : objects)
+  {
+    if(nodes[destination].points_to.insert(object).second)
+    {
+      nodes[destination].delta.insert(object);
+      changed = true;
+    }
+  }
+
+  if(changed)
+    push(destination);
+
+  if(
+    !nodes[source].points_to.empty() &&
+    nodes[source].points_to == nodes[destination].points_to &&
+    checked_edges.insert({source, destination}).second)
+  {
+    cycle_candidates.emplace_back(source, destination);
+  }
+}
+
+void andersen_points_tot::push(node_indext node)
+{
+  if(!nodes[node].in_worklist)
+  {
+    nodes[node].in_worklist = true;
+    worklist.push_back(node);
+  }
+}
+
+void andersen_points_tot::solve()
+{
+  while(!worklist.empty())
+  {
+    const node_indext node = worklist.front();
+    worklist.pop_front();
+    nodes[node].in_worklist = false;
+
+    // merged into another node, which has been queued instead
+    if(cycles.find(node) != node)
+      continue;
+
+    objectst delta;
+    delta.swap(nodes[node].delta);
+
+    // applying constraints may add further ones to this node
+    for(std::size_t i = 0; i < nodes[node].constraints.size(); ++i)
+    {
+      const complex_constraintt constraint = nodes[node].constraints[i];
+      for(const auto object : delta)
+        apply(constraint, object);
+    }
+
+    const objectst successors = nodes[node].successors;
+    for(const auto successor : successors)
+    {
+      const node_indext destination = cycles.find(successor);
+      if(destination != node)
+        propagate(node, destination, delta);
+    }
+
+    // collapsing changes the nodes, so only do so once done with this one
+    std::vector<std::pair<node_indext, node_indext>> candidates;
+    candidates.swap(cycle_candidates);
+    for(const auto &edge : candidates)
+      collapse_cycle(edge.first, edge.second);
+  }
+}
+
+void andersen_points_tot::collapse_cycle(
+  node_indext source,
+  node_indext destination)
+{
+  source = cycles.find(source);
+  destination = cycles.find(destination);
+  if(source == destination)
+    return;
+
+  // search for a path back from the destination to the source
+  std::map<node_indext, node_indext> predecessor;
+  std::vector<node_indext> stack{destination};
+  predecessor[destination] = destination;
+  bool found = false;
+
+  while(!stack.empty() && !found)
+  {
+    const node_indext node = stack.back();
+    stack.pop_back();
+
+    for(const auto successor : nodes[node].successors)
+    {
+      const node_indext next = cycles.find(successor);
+      if(!predecessor.emplace(next, node).second)
+        continue;
+
+      if(next == source)
+      {
+        found = true;
+        break;
+      }
+
+      stack.push_back(next);
+    }
+  }
+
+  if(!found)
+    return;
+
+  for(node_indext node = source; node != destination;
+      node = predecessor[node])
+  {
+    merge(destination, node);
+  }
+}
+
+void andersen_points_tot::merge(node_indext a, node_indext b)
+{
+  a = cycles.find(a);
+  b = cycles.find(b);
+  if(a == b)
+    return;
+
+  cycles.make_union(a, b);
+  const node_indext root = cycles.find(a);
+  const node_indext other = root == a ? b : a;
+
+  nodes[root].points_to.insert(
+    nodes[other].points_to.begin(), nodes[other].points_to.end());
+  nodes[root].successors.insert(
+    nodes[other].successors.begin(), nodes[other].successors.end());
+  nodes[root].constraints.insert(
+    nodes[root].constraints.end(),
+    nodes[other].constraints.begin(),
+    nodes[other].constraints.end());
+
+  // the constraints of either node have not seen all objects of the other
+  nodes[root].delta = nodes[root].points_to;
+  push(root);
+
+  nodes[other] = nodet();
+  ++statistics.collapsed;
+}
@@ -0,0 +1,204 @@
+/*******************************************************************\
+
+Module: Inclusion-Based Points-To Analysis
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Flow- and context-insensitive inclusion-based (Andersen-style) points-to
+/// analysis
+
+#ifndef CPROVER_POINTER_ANALYSIS_ANDERSEN_POINTS_TO_H
+#define CPROVER_POINTER_ANALYSIS_ANDERSEN_POINTS_TO_H
+
+#include <util/optional.h>
+#include <util/union_find.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include "value_sets.h"
+
+#include <deque>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+/// Flow- and context-insensitive points-to analysis that answers the same
+/// queries as \ref value_set_analysis_fit, but rather than iterating over all
+/// instructions until the value sets stabilise it translates the program into
+/// inclusion constraints once and then solves these with a worklist.
+///
+/// Every abstract location (a variable, a field of a struct-typed object, a
+/// heap allocation site or a temporary) is a node of a constraint graph, and
+/// an edge from `a` to `b` means that `b` may point to everything `a` may
+/// point to.  Loads, stores and indirect calls are complex constraints that
+/// add edges as the points-to set of the pointer they go through grows.
+///  - Only the objects that were added to a node since it was last processed
+///    are propagated along its edges (difference propagation).
+///  - When an edge connects two nodes with equal points-to sets the graph is
+///    searched for a cycle through that edge, and the nodes of a cycle found
+///    are collapsed into a single node using a union-find structure (lazy
+///    cycle detection).
+///
+/// Struct members are tracked separately; array elements and union members
+/// are not.  Calls through function pointers are resolved while solving.
+/// Functions without a body are assumed to return a fresh heap object.
+class andersen_points_tot : public value_setst
+{
+public:
+  explicit andersen_points_tot(const namespacet &_ns) : ns(_ns)
+  {
+  }
+
+  /// Generate the constraints for all functions in \p goto_functions and
+  /// solve them
+  void operator()(const goto_functionst &goto_functions);
+
+  /// The objects \p expr may point to, as object descriptors.  As the analysis
+  /// is flow-insensitive, \p function_id and \p l are only used to name the
+  /// heap objects allocated by \p expr.
+  std::vector<exprt> get_values(
+    const irep_idt &function_id,
+    goto_programt::const_targett l,
+    const exprt &expr) override;
+
+  struct statisticst
+  {
+    /// Nodes of the constraint graph, including collapsed ones
+    std::size_t nodes = 0;
+    /// Nodes merged into another one because they were on a cycle
+    std::size_t collapsed = 0;
+    /// Times a set of objects was propagated along an edge
+    std::size_t propagations = 0;
+  };
+
+  const statisticst &get_statistics() const
+  {
+    return statistics;
+  }
+
+protected:
+  const namespacet &ns;
+
+  typedef std::size_t node_indext;
+  typedef std::set<node_indext> objectst;
+  typedef std::vector<irep_idt> patht;
+
+  /// A load `dst = *p`, a store `*p = src`, an address computation
+  /// `dst = &p->path` or an indirect call `(*p)(...)` through the node `p`
+  /// the constraint is attached to
+  struct complex_constraintt
+  {
+    enum class kindt
+    {
+      LOAD,
+      STORE,
+      OFFSET,
+      CALL
+    };
+    kindt kind;
+    /// The destination of a load or an address, or the source of a store
+    node_indext node;
+    /// Fields selected in each object the pointer points to
+    patht path;
+    /// Index into \ref calls for a call
+    std::size_t call;
+  };
+
+  struct nodet
+  {
+    objectst points_to;
+    /// Objects added to \ref points_to since the node was last processed
+    objectst delta;
+    objectst successors;
+    std::vector<complex_constraintt> constraints;
+    bool in_worklist = false;
+  };
+
+  std::vector<nodet> nodes;
+  /// The expression each node stands for when it is pointed to; nil for
+  /// temporaries
+  std::vector<exprt> objects;
+  std::unordered_map<irep_idt, node_indext> node_numbers;
+  std::vector<irep_idt> node_names;
+
+  /// Nodes that were merged because they are on a cycle share a root
+  unsigned_union_find cycles;
+  std::deque<node_indext> worklist;
+  /// Edges whose endpoints had equal points-to sets and that have not yet
+  /// been searched for a cycle
+  std::vector<std::pair<node_indext, node_indext>> cycle_candidates;
+  std::set<std::pair<node_indext, node_indext>> checked_edges;
+
+  struct callt
+  {
+    irep_idt function_id;
+    goto_programt::const_targett location;
+    exprt lhs;
+    exprt::operandst arguments;
+    /// Functions the call has been bound to
+    std::set<irep_idt> targets;
+  };
+  std::vector<callt> calls;
+
+  std::unordered_map<irep_idt, std::vector<irep_idt>> parameters;
+
+  /// Where the constraints currently generated come from
+  irep_idt current_function;
+  goto_programt::const_targett current_location;
+
+  statisticst statistics;
+
+  /// The locations denoted by an lvalue: either the fixed node \c base, or the
+  /// field \c path of each object the node \c pointer may point to.  Neither
+  /// is set if the expression does not denote a location that is tracked.
+  struct accesst
+  {
+    optionalt<node_indext> base;
+    optionalt<node_indext> pointer;
+    patht path;
+  };
+
+  node_indext new_node();
+  node_indext named_node(const irep_idt &name, const exprt &object);
+  node_indext field(node_indext object, const irep_idt &component_name);
+  node_indext field(node_indext object, const patht &path);
+  node_indext heap_object(const typet &type);
+
+  void instruction(
+    const irep_idt &function_id,
+    goto_programt::const_targett target);
+  void assign(const exprt &lhs, const exprt &rhs);
+  void function_call(
+    const exprt &lhs,
+    const exprt &function,
+    const exprt::operandst &arguments);
+  void bind_call(
+    const irep_idt &callee,
+    const exprt &lhs,
+    const exprt::operandst &arguments);
+
+  /// A node that may point to everything \p expr may evaluate to
+  optionalt<node_indext> eval(const exprt &expr);
+  accesst access(const exprt &expr);
+  optionalt<node_indext> read(const accesst &access);
+  void write(const accesst &access, node_indext source);
+
+  void add_object(node_indext node, node_indext object);
+  void add_edge(node_indext source, node_indext destination);
+  void add_constraint(node_indext pointer, const complex_constraintt &);
+  void apply(const complex_constraintt &constraint, node_indext object);
+  void propagate(
+    node_indext source,
+    node_indext destination,
+    const objectst &objects);
+  void push(node_indext node);
+
+  void solve();
+  void collapse_cycle(node_indext source, node_indext destination);
+  void merge(node_indext a, node_indext b);
+};
+
+#endif // CPROVER_POINTER_ANALYSIS_ANDERSEN_POINTS_TO_H
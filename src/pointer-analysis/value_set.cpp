@@ -124,11 +124,10 @@ bool value_sett::insert(
   if(insert_action == insert_actiont::NONE)
     return false;
 
-  auto &new_offset = dest.write()[n];
   if(insert_action == insert_actiont::INSERT)
-    new_offset = offset;
+    dest.write().set(n, offset);
   else
-    new_offset.reset();
+    dest.write().set(n, offsett());
 
   return true;
 }
@@ -268,33 +267,16 @@ bool value_sett::make_union_would_change(
   const object_mapt &dest,
   const object_mapt &src) const
 {
-  for(const auto &number_and_offset : src.read())
-  {
-    if(
-      get_insert_action(
-        dest, number_and_offset.first, number_and_offset.second) !=
-      insert_actiont::NONE)
-    {
-      return true;
-    }
-  }
-
-  return false;
+  return !dest.read().includes(src.read());
 }
 
 bool value_sett::make_union(object_mapt &dest, const object_mapt &src) const
 {
-  bool result=false;
-
-  for(object_map_dt::const_iterator it=src.read().begin();
-      it!=src.read().end();
-      it++)
-  {
-    if(insert(dest, *it))
-      result=true;
-  }
+  // check first, as writing detaches a shared map
+  if(dest.read().includes(src.read()))
+    return false;
 
-  return result;
+  return dest.write().make_union(src.read());
 }
 
 bool value_sett::eval_pointer_offset(
@@ -1653,7 +1635,7 @@ void value_sett::erase_values_from_entry(
 
   std::vector<object_map_dt::key_type> keys_to_erase;
 
-  for(auto &key_value : entry->object_map.read())
+  for(const auto &key_value : entry->object_map.read())
   {
     const auto &rhs_object = to_expr(key_value);
     if(values_to_erase.count(rhs_object))
@@ -21,6 +21,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/sharing_map.h>
 
 #include "object_numbering.h"
+#include "value_set_object_map.h"
 #include "value_sets.h"
 
 class namespacet;
@@ -85,8 +86,9 @@ public:
   /// offsets (`offsett` instances). This is the RHS set of a single row of
   /// the enclosing `value_sett`, such as `{ null, dynamic_object1 }`.
   /// The set is represented as a map from numbered `exprt`s to `offsett`
-  /// instead of a set of pairs to make lookup by `exprt` easier.
-  using object_map_dt = std::map<object_numberingt::number_type, offsett>;
+  /// instead of a set of pairs to make lookup by `exprt` easier; see
+  /// \ref value_set_object_mapt for how it is stored.
+  using object_map_dt = value_set_object_mapt;
 
   static const object_map_dt empty_object_map;
 
@@ -117,7 +119,7 @@ public:
   /// \param it: iterator pointing to new element
   void set(object_mapt &dest, const object_map_dt::value_type &it) const
   {
-    dest.write()[it.first]=it.second;
+    dest.write().set(it.first, it.second);
   }
 
   /// Merges an existing element into an object map. If the destination map
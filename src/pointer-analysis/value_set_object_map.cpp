@@ -0,0 +1,515 @@
+/*******************************************************************\
+
+Module: Value Set Object Map
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Set of numbered objects with offsets, as stored in each row of a value set
+
+#include "value_set_object_map.h"
+
+#include <algorithm>
+
+const value_set_object_mapt::mapped_type value_set_object_mapt::unknown_offset;
+constexpr std::size_t value_set_object_mapt::inline_capacity;
+
+static const std::size_t bits_per_word = 64;
+
+/// Index of the lowest bit set in the non-zero \p word
+static std::size_t lowest_bit(std::uint64_t word)
+{
+#ifdef __GNUC__
+  return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+  std::size_t result = 0;
+  for(; !(word & 1); word >>= 1)
+    ++result;
+  return result;
+#endif
+}
+
+static std::size_t population_count(std::uint64_t word)
+{
+#ifdef __GNUC__
+  return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+  std::size_t result = 0;
+  for(; word != 0; word &= word - 1)
+    ++result;
+  return result;
+#endif
+}
+
+static bool offset_key_less(
+  const std::pair<std::size_t, value_set_object_mapt::mapped_type> &a,
+  const std::pair<std::size_t, value_set_object_mapt::mapped_type> &b)
+{
+  return a.first < b.first;
+}
+
+value_set_object_mapt::const_iterator::const_iterator(
+  const value_set_object_mapt &_map,
+  std::size_t _position,
+  std::uint64_t _remaining)
+  : map(&_map),
+    position(_position),
+    remaining(_remaining),
+    key(0),
+    offset_position(0)
+{
+  if(settle())
+  {
+    offset_position = std::lower_bound(
+                        map->offsets.begin(),
+                        map->offsets.end(),
+                        std::make_pair(key, mapped_type()),
+                        offset_key_less) -
+                      map->offsets.begin();
+  }
+}
+
+bool value_set_object_mapt::const_iterator::settle()
+{
+  if(!map->dense)
+  {
+    if(position >= map->number_of_keys)
+      return false;
+    key = map->inline_keys[position];
+  }
+  else
+  {
+    if(remaining == 0)
+      return false;
+    key = map->words[position].index * bits_per_word + lowest_bit(remaining);
+  }
+
+  return true;
+}
+
+value_set_object_mapt::const_iterator &value_set_object_mapt::const_iterator::
+operator++()
+{
+  if(!map->dense)
+    ++position;
+  else
+  {
+    // clear the lowest bit
+    remaining &= remaining - 1;
+    if(remaining == 0)
+    {
+      ++position;
+      if(position < map->words.size())
+        remaining = map->words[position].bits;
+    }
+  }
+
+  // both keys and offsets are sorted
+  if(settle())
+  {
+    while(offset_position < map->offsets.size() &&
+          map->offsets[offset_position].first < key)
+    {
+      ++offset_position;
+    }
+  }
+
+  return *this;
+}
+
+bool value_set_object_mapt::contains(key_type key) const
+{
+  if(!dense)
+  {
+    return std::binary_search(
+      inline_keys.begin(), inline_keys.begin() + number_of_keys, key);
+  }
+
+  const std::size_t index = key / bits_per_word;
+  const auto word = std::lower_bound(
+    words.begin(), words.end(), index, [](const wordt &w, std::size_t i) {
+      return w.index < i;
+    });
+
+  return word != words.end() && word->index == index &&
+         ((word->bits >> (key % bits_per_word)) & 1) != 0;
+}
+
+value_set_object_mapt::const_iterator
+value_set_object_mapt::find(key_type key) const
+{
+  if(!contains(key))
+    return end();
+
+  if(!dense)
+  {
+    return const_iterator(
+      *this,
+      std::lower_bound(
+        inline_keys.begin(), inline_keys.begin() + number_of_keys, key) -
+        inline_keys.begin(),
+      0);
+  }
+
+  const auto word = std::lower_bound(
+    words.begin(),
+    words.end(),
+    key / bits_per_word,
+    [](const wordt &w, std::size_t i) { return w.index < i; });
+
+  // skip the keys below the one we are looking for
+  return const_iterator(
+    *this,
+    word - words.begin(),
+    word->bits & (~std::uint64_t(0) << (key % bits_per_word)));
+}
+
+void value_set_object_mapt::set(key_type key, const mapped_type &offset)
+{
+  add_key(key);
+
+  const auto entry = std::lower_bound(
+    offsets.begin(),
+    offsets.end(),
+    std::make_pair(key, mapped_type()),
+    offset_key_less);
+  const bool found = entry != offsets.end() && entry->first == key;
+
+  if(offset.has_value())
+  {
+    if(found)
+      entry->second = offset;
+    else
+      offsets.emplace(entry, key, offset);
+  }
+  else if(found)
+    offsets.erase(entry);
+}
+
+std::size_t value_set_object_mapt::erase(key_type key)
+{
+  if(!contains(key))
+    return 0;
+
+  if(!dense)
+  {
+    const auto last = inline_keys.begin() + number_of_keys;
+    const auto entry = std::lower_bound(inline_keys.begin(), last, key);
+    std::copy(entry + 1, last, entry);
+  }
+  else
+  {
+    const auto word = std::lower_bound(
+      words.begin(),
+      words.end(),
+      key / bits_per_word,
+      [](const wordt &w, std::size_t i) { return w.index < i; });
+    word->bits &= ~(std::uint64_t(1) << (key % bits_per_word));
+    if(word->bits == 0)
+      words.erase(word);
+  }
+
+  --number_of_keys;
+
+  const auto entry = std::lower_bound(
+    offsets.begin(),
+    offsets.end(),
+    std::make_pair(key, mapped_type()),
+    offset_key_less);
+  if(entry != offsets.end() && entry->first == key)
+    offsets.erase(entry);
+
+  return 1;
+}
+
+bool value_set_object_mapt::make_union(const value_set_object_mapt &src)
+{
+  if(src.empty())
+    return false;
+
+  if(empty())
+  {
+    *this = src;
+    return true;
+  }
+
+  // The offsets depend on which keys this map had before, so merge them
+  // first.  Known offsets that become unknown are reset and then removed.
+  std::vector<std::pair<key_type, mapped_type>> added_offsets;
+  bool offset_reset = false;
+
+  auto entry = offsets.begin();
+  auto src_entry = src.offsets.begin();
+  while(entry != offsets.end() || src_entry != src.offsets.end())
+  {
+    if(
+      src_entry == src.offsets.end() ||
+      (entry != offsets.end() && entry->first < src_entry->first))
+    {
+      // if src has this key, its offset there is unknown
+      if(src.contains(entry->first))
+      {
+        entry->second.reset();
+        offset_reset = true;
+      }
+      ++entry;
+    }
+    else if(entry == offsets.end() || src_entry->first < entry->first)
+    {
+      // a key we already have keeps its unknown offset
+      if(!contains(src_entry->first))
+        added_offsets.push_back(*src_entry);
+      ++src_entry;
+    }
+    else
+    {
+      if(*entry->second != *src_entry->second)
+      {
+        entry->second.reset();
+        offset_reset = true;
+      }
+      ++entry;
+      ++src_entry;
+    }
+  }
+
+  if(offset_reset)
+  {
+    offsets.erase(
+      std::remove_if(
+        offsets.begin(),
+        offsets.end(),
+        [](const std::pair<key_type, mapped_type> &o) {
+          return !o.second.has_value();
+        }),
+      offsets.end());
+  }
+
+  if(!added_offsets.empty())
+  {
+    const std::size_t middle = offsets.size();
+    offsets.insert(
+      offsets.end(),
+      std::make_move_iterator(added_offsets.begin()),
+      std::make_move_iterator(added_offsets.end()));
+    std::inplace_merge(
+      offsets.begin(),
+      offsets.begin() + middle,
+      offsets.end(),
+      offset_key_less);
+  }
+
+  const bool keys_added = add_keys(src);
+  return keys_added || offset_reset;
+}
+
+bool value_set_object_mapt::includes(const value_set_object_mapt &src) const
+{
+  if(src.number_of_keys > number_of_keys)
+    return false;
+
+  if(dense && src.dense)
+  {
+    // every word of src must be covered by the word with the same index
+    auto word = words.begin();
+    for(const auto &src_word : src.words)
+    {
+      while(word != words.end() && word->index < src_word.index)
+        ++word;
+      if(
+        word == words.end() || word->index != src_word.index ||
+        (src_word.bits & ~word->bits) != 0)
+      {
+        return false;
+      }
+    }
+  }
+  else
+  {
+    for(const auto &element : src)
+    {
+      if(!contains(element.first))
+        return false;
+    }
+  }
+
+  // All keys of src are present here, so an offset changes only if it is
+  // known here and differs in src.
+  auto src_entry = src.offsets.begin();
+  for(const auto &entry : offsets)
+  {
+    while(src_entry != src.offsets.end() && src_entry->first < entry.first)
+      ++src_entry;
+
+    if(src_entry != src.offsets.end() && src_entry->first == entry.first)
+    {
+      if(*src_entry->second != *entry.second)
+        return false;
+    }
+    else if(src.contains(entry.first))
+      return false;
+  }
+
+  return true;
+}
+
+bool value_set_object_mapt::operator==(
+  const value_set_object_mapt &other) const
+{
+  if(number_of_keys != other.number_of_keys || offsets != other.offsets)
+    return false;
+
+  if(!dense && !other.dense)
+  {
+    return std::equal(
+      inline_keys.begin(),
+      inline_keys.begin() + number_of_keys,
+      other.inline_keys.begin());
+  }
+  else if(dense && other.dense)
+  {
+    return words.size() == other.words.size() &&
+           std::equal(
+             words.begin(),
+             words.end(),
+             other.words.begin(),
+             [](const wordt &a, const wordt &b) {
+               return a.index == b.index && a.bits == b.bits;
+             });
+  }
+
+  return std::equal(
+    begin(), end(), other.begin(), [](value_type a, value_type b) {
+      return a.first == b.first;
+    });
+}
+
+bool value_set_object_mapt::add_key(key_type key)
+{
+  if(!dense)
+  {
+    const auto last = inline_keys.begin() + number_of_keys;
+    const auto entry = std::lower_bound(inline_keys.begin(), last, key);
+    if(entry != last && *entry == key)
+      return false;
+
+    if(number_of_keys < inline_capacity)
+    {
+      std::copy_backward(entry, last, last + 1);
+      *entry = key;
+      ++number_of_keys;
+      return true;
+    }
+
+    make_dense();
+  }
+
+  const std::size_t index = key / bits_per_word;
+  auto word = std::lower_bound(
+    words.begin(), words.end(), index, [](const wordt &w, std::size_t i) {
+      return w.index < i;
+    });
+  if(word == words.end() || word->index != index)
+    word = words.insert(word, wordt{index, 0});
+
+  const std::uint64_t mask = std::uint64_t(1) << (key % bits_per_word);
+  if((word->bits & mask) != 0)
+    return false;
+
+  word->bits |= mask;
+  ++number_of_keys;
+  return true;
+}
+
+bool value_set_object_mapt::add_keys(const value_set_object_mapt &src)
+{
+  if(!dense && !src.dense)
+  {
+    std::array<key_type, 2 * inline_capacity> merged;
+    const std::size_t merged_size =
+      std::set_union(
+        inline_keys.begin(),
+        inline_keys.begin() + number_of_keys,
+        src.inline_keys.begin(),
+        src.inline_keys.begin() + src.number_of_keys,
+        merged.begin()) -
+      merged.begin();
+
+    if(merged_size == number_of_keys)
+      return false;
+
+    if(merged_size <= inline_capacity)
+    {
+      std::copy(
+        merged.begin(), merged.begin() + merged_size, inline_keys.begin());
+      number_of_keys = merged_size;
+      return true;
+    }
+  }
+
+  if(!dense)
+    make_dense();
+
+  if(!src.dense)
+  {
+    bool added = false;
+    for(std::size_t i = 0; i < src.number_of_keys; ++i)
+      added |= add_key(src.inline_keys[i]);
+    return added;
+  }
+
+  // merge the words, combining those with the same index
+  std::vector<wordt> merged;
+  merged.reserve(words.size() + src.words.size());
+  std::size_t added = 0;
+
+  auto word = words.begin();
+  auto src_word = src.words.begin();
+  while(word != words.end() || src_word != src.words.end())
+  {
+    if(
+      src_word == src.words.end() ||
+      (word != words.end() && word->index < src_word->index))
+    {
+      merged.push_back(*word++);
+    }
+    else if(word == words.end() || src_word->index < word->index)
+    {
+      added += population_count(src_word->bits);
+      merged.push_back(*src_word++);
+    }
+    else
+    {
+      added += population_count(src_word->bits & ~word->bits);
+      merged.push_back(wordt{word->index, word->bits | src_word->bits});
+      ++word;
+      ++src_word;
+    }
+  }
+
+  if(added == 0)
+    return false;
+
+  words.swap(merged);
+  number_of_keys += added;
+  return true;
+}
+
+void value_set_object_mapt::make_dense()
+{
+  std::vector<wordt> new_words;
+
+  for(std::size_t i = 0; i < number_of_keys; ++i)
+  {
+    const std::size_t index = inline_keys[i] / bits_per_word;
+    if(new_words.empty() || new_words.back().index != index)
+      new_words.push_back(wordt{index, 0});
+    new_words.back().bits |= std::uint64_t(1)
+                             << (inline_keys[i] % bits_per_word);
+  }
+
+  words.swap(new_words);
+  dense = true;
+}
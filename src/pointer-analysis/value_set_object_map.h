@@ -0,0 +1,223 @@
+/*******************************************************************\
+
+Module: Value Set Object Map
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Set of numbered objects with offsets, as stored in each row of a value set
+
+#ifndef CPROVER_POINTER_ANALYSIS_VALUE_SET_OBJECT_MAP_H
+#define CPROVER_POINTER_ANALYSIS_VALUE_SET_OBJECT_MAP_H
+
+#include <util/mp_arith.h>
+#include <util/optional.h>
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/// Map from object numbers to (possibly unknown) offsets, with the interface
+/// of an ordered map, that stores the set of object numbers separately from
+/// the offsets:
+///  - Up to \ref inline_capacity object numbers are kept in a sorted array
+///    inside the map itself.
+///  - Larger sets are kept as a bit set, stored as a sorted list of the
+///    non-zero 64-bit words only, so that the numbers of all objects ever
+///    seen do not have to be covered.  Unions of such sets combine whole
+///    words at a time.
+///  - Only known offsets are stored, sorted by object number.  Most value
+///    sets have few of them, and iterating over the map walks both lists in
+///    step.
+///
+/// Iterators produce the pairs by value, so elements cannot be modified
+/// through them; use \ref set instead.
+class value_set_object_mapt
+{
+public:
+  typedef std::size_t key_type;
+  typedef optionalt<mp_integer> mapped_type;
+  typedef std::pair<key_type, const mapped_type &> value_type;
+
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef value_set_object_mapt::value_type value_type;
+    typedef value_type reference;
+    typedef std::ptrdiff_t difference_type;
+
+    struct pointer
+    {
+      value_type value;
+
+      const value_type *operator->() const
+      {
+        return &value;
+      }
+    };
+
+    reference operator*() const
+    {
+      return value_type(key, map->offset_at(offset_position, key));
+    }
+
+    pointer operator->() const
+    {
+      return pointer{**this};
+    }
+
+    const_iterator &operator++();
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const
+    {
+      return position == other.position && remaining == other.remaining;
+    }
+
+    bool operator!=(const const_iterator &other) const
+    {
+      return !(*this == other);
+    }
+
+  private:
+    friend class value_set_object_mapt;
+
+    const_iterator(
+      const value_set_object_mapt &_map,
+      std::size_t _position,
+      std::uint64_t _remaining);
+
+    /// Set \ref key from \ref position and \ref remaining
+    /// \return false at the end of the map
+    bool settle();
+
+    const value_set_object_mapt *map;
+    /// Index into the inline keys, or into the words of a bit set
+    std::size_t position;
+    /// Bits of the current word that have not been visited yet
+    std::uint64_t remaining;
+    key_type key;
+    /// Index of the first known offset whose key is not below \ref key
+    std::size_t offset_position;
+  };
+
+  typedef const_iterator iterator;
+
+  const_iterator begin() const
+  {
+    return const_iterator(
+      *this, 0, dense && !words.empty() ? words.front().bits : 0);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(*this, dense ? words.size() : number_of_keys, 0);
+  }
+
+  std::size_t size() const
+  {
+    return number_of_keys;
+  }
+
+  bool empty() const
+  {
+    return number_of_keys == 0;
+  }
+
+  bool contains(key_type key) const;
+
+  std::size_t count(key_type key) const
+  {
+    return contains(key) ? 1 : 0;
+  }
+
+  const_iterator find(key_type key) const;
+
+  /// Add \p key if not present and set its offset to \p offset
+  void set(key_type key, const mapped_type &offset);
+
+  /// Add the elements in [\p first, \p last) whose keys are not yet present,
+  /// leaving existing ones unchanged
+  template <typename iteratort>
+  void insert(iteratort first, iteratort last)
+  {
+    for(; first != last; ++first)
+    {
+      const auto element = *first;
+      if(!contains(element.first))
+        set(element.first, element.second);
+    }
+  }
+
+  std::size_t erase(key_type key);
+
+  /// Add all elements of \p src, as if each were added by
+  /// \ref value_sett::insert: new keys keep the offset they have in \p src,
+  /// and keys present in both with differing offsets get an unknown offset.
+  /// \return true if this map changed
+  bool make_union(const value_set_object_mapt &src);
+
+  /// \return true if \ref make_union with \p src would not change this map
+  bool includes(const value_set_object_mapt &src) const;
+
+  void clear()
+  {
+    *this = value_set_object_mapt();
+  }
+
+  bool operator==(const value_set_object_mapt &other) const;
+
+  bool operator!=(const value_set_object_mapt &other) const
+  {
+    return !(*this == other);
+  }
+
+  static constexpr std::size_t inline_capacity = 8;
+
+protected:
+  struct wordt
+  {
+    /// Keys `64 * index` to `64 * index + 63`
+    std::size_t index;
+    std::uint64_t bits;
+  };
+
+  std::size_t number_of_keys = 0;
+  /// Whether the keys are stored in \ref words rather than \ref inline_keys
+  bool dense = false;
+  std::array<key_type, inline_capacity> inline_keys{};
+  /// Non-zero words of the bit set, sorted by index
+  std::vector<wordt> words;
+  /// Keys that have a known offset, with that offset, sorted by key
+  std::vector<std::pair<key_type, mapped_type>> offsets;
+
+  /// The offset of \p key, where \p position is the index of the first
+  /// element of \ref offsets whose key is not below \p key
+  const mapped_type &offset_at(std::size_t position, key_type key) const
+  {
+    if(position < offsets.size() && offsets[position].first == key)
+      return offsets[position].second;
+    return unknown_offset;
+  }
+
+  static const mapped_type unknown_offset;
+
+  /// \return true if \p key was not present
+  bool add_key(key_type key);
+  /// \return true if a key was not present
+  bool add_keys(const value_set_object_mapt &src);
+  void make_dense();
+};
+
+#endif // CPROVER_POINTER_ANALYSIS_VALUE_SET_OBJECT_MAP_H
@@ -40,6 +40,7 @@ arrayst::arrayst(
   incremental_cache = false;  // for incremental solving
   // get_array_constraints is true when --show-array-constraints is used
   get_array_constraints = _get_array_constraints;
+  prune_ackermann_constraints = false;
 }
 
 void arrayst::record_array_index(const index_exprt &index)
@@ -331,6 +332,9 @@ void arrayst::add_array_Ackermann_constraints()
   std::cout << "arrays.size(): " << arrays.size() << '\n';
 #endif
 
+  std::size_t number_of_constraints = 0;
+  std::size_t number_of_pruned_constraints = 0;
+
   // iterate over arrays
   for(std::size_t i=0; i<arrays.size(); i++)
   {
@@ -354,6 +358,14 @@ void arrayst::add_array_Ackermann_constraints()
           if(i1->is_constant() && i2->is_constant())
             continue;
 
+          if(
+            prune_ackermann_constraints &&
+            !needs_Ackermann_constraint(arrays[i], *i1, *i2))
+          {
+            number_of_pruned_constraints++;
+            continue;
+          }
+
           // index equality
           const equal_exprt indices_equal(
             *i1, typecast_exprt::conditional_cast(*i2, i1->type()));
@@ -375,6 +387,7 @@ void arrayst::add_array_Ackermann_constraints()
               implies_exprt(literal_exprt(indices_equal_lit), values_equal));
             add_array_constraint(lazy, true); // added lazily
             array_constraint_count[constraint_typet::ARRAY_ACKERMANN]++;
+            number_of_constraints++;
 
 #if 0 // old code for adding, not significantly faster
             prop.lcnf(!indices_equal_lit, convert(values_equal));
@@ -382,6 +395,48 @@ void arrayst::add_array_Ackermann_constraints()
           }
         }
   }
+
+  if(prune_ackermann_constraints)
+  {
+    log.statistics() << "Array Ackermann constraints: "
+                     << number_of_constraints << " added, "
+                     << number_of_pruned_constraints << " pruned"
+                     << messaget::eom;
+  }
+}
+
+/// Decide whether the Ackermann constraint for \p index1 and \p index2 is
+/// needed for \p array, or whether it is implied by the constraints of other
+/// arrays of its class.  Arrays defined by `if`, `array_of` and typecast
+/// expressions have their elements at every index of the class constrained
+/// to those of their operands, or a single value, so they inherit the
+/// Ackermann constraints of their operands.  An array `y with [k:=v]` has
+/// the elements of `y` at all indices not syntactically equal to `k`, unless
+/// the index is equal to `k`; it thus only needs the constraints relating
+/// `k` to the other indices.
+bool arrayst::needs_Ackermann_constraint(
+  const exprt &array,
+  const exprt &index1,
+  const exprt &index2) const
+{
+  if(
+    array.id() == ID_if || array.id() == ID_array_of ||
+    array.id() == ID_typecast)
+  {
+    return false;
+  }
+  else if(array.id() == ID_with)
+  {
+    const exprt::operandst &operands = array.operands();
+    for(std::size_t i = 1; i + 1 < operands.size(); i += 2)
+    {
+      if(operands[i] == index1 || operands[i] == index2)
+        return true;
+    }
+    return false;
+  }
+  else
+    return true;
 }
 
 /// merge the indices into the root
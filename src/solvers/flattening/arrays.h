@@ -50,6 +50,12 @@ public:
   literalt record_array_equality(const equal_exprt &expr);
   void record_array_index(const index_exprt &expr);
 
+  /// Only add Ackermann constraints where they are not implied by the
+  /// constraints of `if`, `with`, `array_of` and typecast expressions,
+  /// which define the elements of such arrays at all indices of their
+  /// class in terms of other arrays of the same class
+  bool prune_ackermann_constraints;
+
 protected:
   const namespacet &ns;
   messaget log;
@@ -133,6 +139,10 @@ protected:
   // adds all the constraints eagerly
   void add_array_constraints();
   void add_array_Ackermann_constraints();
+  bool needs_Ackermann_constraint(
+    const exprt &array,
+    const exprt &index1,
+    const exprt &index2) const;
   void add_array_constraints_equality(
     const index_sett &index_set, const array_equalityt &array_equality);
   void add_array_constraints(
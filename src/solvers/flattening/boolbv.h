@@ -20,6 +20,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/mp_arith.h>
 #include <util/optional.h>
 
+#include <solvers/lowering/byte_operator_lowering.h>
 #include <solvers/lowering/functions.h>
 
 #include "bv_utils.h"
@@ -50,6 +51,7 @@ public:
       bv_width(_ns),
       bv_utils(_prop),
       functions(*this),
+      byte_operator_lowering(_ns),
       map(_prop)
   {
   }
@@ -76,6 +78,12 @@ public:
     post_process_quantifiers();
     functions.post_process();
     SUB::post_process();
+
+    if(!byte_operator_lowering.empty())
+    {
+      byte_operator_lowering.output_statistics(log.statistics());
+      log.statistics() << messaget::eom;
+    }
   }
 
   enum class unbounded_arrayt { U_NONE, U_ALL, U_AUTO };
@@ -111,6 +119,9 @@ protected:
   // uninterpreted functions
   functionst functions;
 
+  // byte operators on unbounded arrays
+  byte_operator_loweringt byte_operator_lowering;
+
   // the mapping from identifiers to literals
   boolbv_mapt map;
 
@@ -15,8 +15,6 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/pointer_offset_size.h>
 #include <util/std_expr.h>
 
-#include <solvers/lowering/expr_lowering.h>
-
 bvt map_bv(const endianness_mapt &map, const bvt &src)
 {
   PRECONDITION(map.number_of_bits() == src.size());
@@ -39,7 +37,7 @@ bvt boolbvt::convert_byte_extract(const byte_extract_exprt &expr)
   // unbounded arrays
   if(is_unbounded_array(expr.op().type()))
   {
-    return convert_bv(lower_byte_extract(expr, ns));
+    return convert_bv(byte_operator_lowering(expr));
   }
 
   const std::size_t width = boolbv_width(expr.type());
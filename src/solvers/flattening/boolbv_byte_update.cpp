@@ -13,8 +13,6 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/expr_util.h>
 #include <util/invariant.h>
 
-#include <solvers/lowering/expr_lowering.h>
-
 bvt boolbvt::convert_byte_update(const byte_update_exprt &expr)
 {
   // if we update (from) an unbounded array, lower the expression as the array
@@ -23,7 +21,7 @@ bvt boolbvt::convert_byte_update(const byte_update_exprt &expr)
     is_unbounded_array(expr.op().type()) ||
     is_unbounded_array(expr.value().type()))
   {
-    return convert_bv(lower_byte_update(expr, ns));
+    return convert_bv(byte_operator_lowering(expr));
   }
 
   const exprt &op = expr.op();
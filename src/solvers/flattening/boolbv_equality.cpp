@@ -30,7 +30,7 @@ literalt boolbvt::convert_equality(const equal_exprt &expr)
     if(has_byte_operator(expr))
     {
       return record_array_equality(
-        to_equal_expr(lower_byte_operators(expr, ns)));
+        to_equal_expr(byte_operator_lowering.lower_byte_operators(expr)));
     }
 
     return record_array_equality(expr);
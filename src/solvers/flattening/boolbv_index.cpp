@@ -47,7 +47,7 @@ bvt boolbvt::convert_index(const index_exprt &expr)
       if(has_byte_operator(expr))
       {
         const index_exprt final_expr =
-          to_index_expr(lower_byte_operators(expr, ns));
+          to_index_expr(byte_operator_lowering.lower_byte_operators(expr));
         CHECK_RETURN(final_expr != expr);
         bv = convert_bv(final_expr);
 
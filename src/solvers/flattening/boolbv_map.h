@@ -11,6 +11,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_SOLVERS_FLATTENING_BOOLBV_MAP_H
 
 #include <iosfwd>
+#include <unordered_map>
 #include <vector>
 
 #include <util/type.h>
@@ -129,23 +129,9 @@ literalt bv_pointerst::convert_rest(const exprt &expr)
       if(!bv.empty())
       {
         const pointer_typet &type = to_pointer_type(operands[0].type());
-        bvt object_bv = object_literals(bv, type);
 
-        bvt invalid_bv = object_literals(
-          encode(pointer_logic.get_invalid_object(), type), type);
-
-        const std::size_t object_bits =
-          bv_pointers_width.get_object_width(type);
-
-        bvt equal_invalid_bv;
-        equal_invalid_bv.reserve(object_bits);
-
-        for(std::size_t i=0; i<object_bits; i++)
-        {
-          equal_invalid_bv.push_back(prop.lequal(object_bv[i], invalid_bv[i]));
-        }
-
-        return prop.land(equal_invalid_bv);
+        return object_equal(
+          object_literals(bv, type), pointer_logic.get_invalid_object());
       }
     }
   }
@@ -865,6 +851,24 @@ bvt bv_pointerst::add_addr(const exprt &expr)
   return encode(a, type);
 }
 
+literalt bv_pointerst::object_equal(const bvt &object_bv, std::size_t number)
+{
+  auto entry =
+    object_equalities.emplace(std::make_pair(object_bv, number), literalt());
+
+  if(entry.second)
+  {
+    bvt number_bv;
+    number_bv.reserve(object_bv.size());
+    for(std::size_t i = 0; i < object_bv.size(); i++)
+      number_bv.push_back(const_literal((number & (std::size_t(1) << i)) != 0));
+
+    entry.first->second = bv_utils.equal(object_bv, number_bv);
+  }
+
+  return entry.first->second;
+}
+
 void bv_pointerst::do_postponed(
   const postponedt &postponed)
 {
@@ -881,16 +885,10 @@ void bv_pointerst::do_postponed(
 
       bool is_dynamic=pointer_logic.is_dynamic_object(expr);
 
-      // only compare object part
-      pointer_typet pt = pointer_type(expr.type());
-      bvt bv = object_literals(encode(number, pt), type);
-
-      bvt saved_bv = object_literals(postponed.op, type);
-
-      POSTCONDITION(bv.size()==saved_bv.size());
       PRECONDITION(postponed.bv.size()==1);
 
-      literalt l1=bv_utils.equal(bv, saved_bv);
+      // only compare object part
+      literalt l1 = object_equal(object_literals(postponed.op, type), number);
       literalt l2=postponed.bv.front();
 
       if(!is_dynamic)
@@ -921,19 +919,13 @@ void bv_pointerst::do_postponed(
       const exprt object_size = typecast_exprt::conditional_cast(
         size_expr.value(), postponed.expr.type());
 
-      // only compare object part
-      pointer_typet pt = pointer_type(expr.type());
-      bvt bv = object_literals(encode(number, pt), type);
-
-      bvt saved_bv = object_literals(postponed.op, type);
-
       bvt size_bv = convert_bv(object_size);
 
-      POSTCONDITION(bv.size()==saved_bv.size());
       PRECONDITION(postponed.bv.size()>=1);
       PRECONDITION(size_bv.size() == postponed.bv.size());
 
-      literalt l1=bv_utils.equal(bv, saved_bv);
+      // only compare object part
+      literalt l1 = object_equal(object_literals(postponed.op, type), number);
       literalt l2=bv_utils.equal(postponed.bv, size_bv);
 
       prop.l_set_to_true(prop.limplies(l1, l2));
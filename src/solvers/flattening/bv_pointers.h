@@ -105,6 +105,15 @@ protected:
 
   void do_postponed(const postponedt &postponed);
 
+  /// Literal that is true iff \p object_bv, the object part of an encoded
+  /// pointer, identifies the object with number \p number
+  literalt object_equal(const bvt &object_bv, std::size_t number);
+
+  /// The literals built by \ref object_equal, so that all checks of the
+  /// object a pointer points to share them rather than each comparing the
+  /// object literals with every object again
+  std::map<std::pair<bvt, std::size_t>, literalt> object_equalities;
+
   /// Given a pointer encoded in \p bv, extract the literals identifying the
   /// object that the pointer points to.
   /// \param bv: Encoded pointer
@@ -0,0 +1,143 @@
+/*******************************************************************\
+
+Module: Cache of Byte Operator Lowerings
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Cache of Byte Operator Lowerings
+
+#include "byte_operator_lowering.h"
+
+#include <util/byte_operators.h>
+#include <util/expr_iterator.h>
+#include <util/replace_symbol.h>
+#include <util/std_expr.h>
+
+#include "expr_lowering.h"
+
+#include <ostream>
+
+/// Give each array comprehension in \p expr a bound variable of its own, as
+/// \ref lower_byte_extract does for each lowering
+static void rename_bound_variables(exprt &expr)
+{
+  Forall_operands(it, expr)
+    rename_bound_variables(*it);
+
+  if(expr.id() == ID_array_comprehension)
+  {
+    array_comprehension_exprt &comprehension =
+      to_array_comprehension_expr(expr);
+
+    static std::size_t bound_variable_counter = 0;
+    ++bound_variable_counter;
+    const symbol_exprt bound_variable(
+      "$array_comprehension_index_l" + std::to_string(bound_variable_counter),
+      comprehension.arg().type());
+
+    replace_symbolt rename;
+    rename.insert(comprehension.arg(), bound_variable);
+    rename(comprehension.body());
+    comprehension.arg() = bound_variable;
+  }
+}
+
+exprt byte_operator_loweringt::operator()(const byte_extract_exprt &src)
+{
+  return lower(src);
+}
+
+exprt byte_operator_loweringt::operator()(const byte_update_exprt &src)
+{
+  return lower(src);
+}
+
+exprt byte_operator_loweringt::lower_byte_operators(const exprt &src)
+{
+  exprt tmp = src;
+
+  Forall_operands(it, tmp)
+    *it = lower_byte_operators(*it);
+
+  if(
+    src.id() == ID_byte_update_little_endian ||
+    src.id() == ID_byte_update_big_endian ||
+    src.id() == ID_byte_extract_little_endian ||
+    src.id() == ID_byte_extract_big_endian)
+  {
+    return lower(tmp);
+  }
+  else
+    return tmp;
+}
+
+exprt byte_operator_loweringt::lower(const exprt &src)
+{
+  ++number_of_lowerings;
+
+  // Only operands that are symbols are replaced: the lowering may make use
+  // of the structure of other operands, and substituting symbols cannot
+  // capture any variables bound in the lowering.
+  exprt shape = src;
+  replace_symbolt instantiate;
+  std::size_t operand_number = 0;
+
+  for(auto &op : shape.operands())
+  {
+    if(op.id() == ID_symbol)
+    {
+      const symbol_exprt placeholder(
+        "byte_operator_lowering::operand" + std::to_string(operand_number),
+        op.type());
+      instantiate.insert(placeholder, op);
+      op = placeholder;
+    }
+
+    ++operand_number;
+  }
+
+  const auto entry = lowerings.find(shape);
+
+  if(entry != lowerings.end())
+  {
+    ++number_of_cache_hits;
+
+    exprt result = entry->second.expr;
+    if(entry->second.binds_variables)
+      rename_bound_variables(result);
+    instantiate(result);
+    return result;
+  }
+
+  exprt lowered = shape.id() == ID_byte_extract_little_endian ||
+                      shape.id() == ID_byte_extract_big_endian
+                    ? lower_byte_extract(to_byte_extract_expr(shape), ns)
+                    : lower_byte_update(to_byte_update_expr(shape), ns);
+
+  bool binds_variables = false;
+  for(auto it = lowered.depth_cbegin(); it != lowered.depth_cend(); ++it)
+  {
+    ++lowered_size;
+    if(it->id() == ID_array_comprehension)
+      binds_variables = true;
+  }
+
+  // the first instance may use the bound variables of the lowering
+  exprt result = lowered;
+  instantiate(result);
+
+  lowerings.emplace(
+    std::move(shape), loweringt{std::move(lowered), binds_variables});
+
+  return result;
+}
+
+void byte_operator_loweringt::output_statistics(std::ostream &out) const
+{
+  out << "Byte operator lowerings: " << number_of_lowerings << ", "
+      << number_of_cache_hits << " from the cache, " << lowered_size
+      << " expression nodes lowered";
+}
@@ -0,0 +1,76 @@
+/*******************************************************************\
+
+Module: Cache of Byte Operator Lowerings
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Cache of Byte Operator Lowerings
+
+#ifndef CPROVER_SOLVERS_LOWERING_BYTE_OPERATOR_LOWERING_H
+#define CPROVER_SOLVERS_LOWERING_BYTE_OPERATOR_LOWERING_H
+
+#include <util/expr.h>
+
+#include <cstddef>
+#include <iosfwd>
+#include <unordered_map>
+
+class byte_extract_exprt;
+class byte_update_exprt;
+class namespacet;
+
+/// Lowers byte operators as \ref lower_byte_extract and
+/// \ref lower_byte_update do, but lowers each shape of byte operator only
+/// once.  The shape of a byte operator is the expression with its operands
+/// that are symbols replaced by placeholders, so that, e.g., all byte
+/// extracts of the same type at the same offset from objects of the same
+/// type share a lowering.  This lowering is kept, and instantiated with the
+/// actual symbols for further byte operators of the same shape.
+class byte_operator_loweringt
+{
+public:
+  explicit byte_operator_loweringt(const namespacet &_ns) : ns(_ns)
+  {
+  }
+
+  exprt operator()(const byte_extract_exprt &src);
+  exprt operator()(const byte_update_exprt &src);
+
+  /// Rewrite all byte operators in \p src, lowering operands first as
+  /// \ref lower_byte_operators does
+  exprt lower_byte_operators(const exprt &src);
+
+  /// \return true if no byte operator has been lowered
+  bool empty() const
+  {
+    return number_of_lowerings == 0;
+  }
+
+  void output_statistics(std::ostream &out) const;
+
+protected:
+  const namespacet &ns;
+
+  struct loweringt
+  {
+    exprt expr;
+    /// whether \ref expr contains array comprehensions, whose bound
+    /// variables need to be renamed for each instance
+    bool binds_variables;
+  };
+
+  /// lowered shapes of byte operators
+  std::unordered_map<exprt, loweringt, irep_hash> lowerings;
+
+  std::size_t number_of_lowerings = 0;
+  std::size_t number_of_cache_hits = 0;
+  /// number of expression nodes of the lowerings built
+  std::size_t lowered_size = 0;
+
+  exprt lower(const exprt &src);
+};
+
+#endif // CPROVER_SOLVERS_LOWERING_BYTE_OPERATOR_LOWERING_H
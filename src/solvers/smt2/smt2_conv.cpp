@@ -63,6 +63,7 @@ smt2_convt::smt2_convt(
     logic(_logic),
     solver(_solver),
     boolbv_width(_ns),
+    byte_operator_lowering(_ns),
     pointer_logic(_ns),
     no_boolean_variables(0)
 {
@@ -4275,13 +4276,13 @@ exprt smt2_convt::lower_byte_operators(const exprt &expr)
       it->id() == ID_byte_extract_little_endian ||
       it->id() == ID_byte_extract_big_endian)
     {
-      it.mutate() = lower_byte_extract(to_byte_extract_expr(*it), ns);
+      it.mutate() = byte_operator_lowering(to_byte_extract_expr(*it));
     }
     else if(
       it->id() == ID_byte_update_little_endian ||
       it->id() == ID_byte_update_big_endian)
     {
-      it.mutate() = lower_byte_update(to_byte_update_expr(*it), ns);
+      it.mutate() = byte_operator_lowering(to_byte_update_expr(*it));
     }
   }
 
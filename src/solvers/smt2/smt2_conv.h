@@ -24,6 +24,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <solvers/prop/prop_conv.h>
 #include <solvers/flattening/boolbv_width.h>
 #include <solvers/flattening/pointer_logic.h>
+#include <solvers/lowering/byte_operator_lowering.h>
 
 #include "letify.h"
 
@@ -87,6 +88,7 @@ protected:
 
   std::vector<exprt> assumptions;
   boolbv_widtht boolbv_width;
+  byte_operator_loweringt byte_operator_lowering;
 
   std::size_t number_of_solver_calls = 0;
 
@@ -140,6 +140,41 @@ unsigned long long irep_cmp_cnt=0;
 unsigned long long irep_cmp_ne_cnt=0;
 #endif
 
+/// Ireps whose hash codes have been computed already, and differ, are
+/// different. As hash codes ignore comments, this holds for both
+/// \ref irept::operator== and \ref irept::full_eq.
+static bool hash_codes_differ(const irept &i1, const irept &i2)
+{
+#if HASH_CODE
+  const std::size_t hash1 = i1.read().hash_code;
+  const std::size_t hash2 = i2.read().hash_code;
+  return hash1 != 0 && hash2 != 0 && hash1 != hash2;
+#else
+  (void)i1; // unused parameter
+  (void)i2; // unused parameter
+  return false;
+#endif
+}
+
+/// Compare the (unnamed) children of two nodes using \p equal. Children
+/// shared by both nodes, which is common when comparing related expressions,
+/// are skipped without a call to \p equal.
+template <typename equalt>
+static bool
+equal_subs(const irept::subt &sub1, const irept::subt &sub2, equalt equal)
+{
+  if(sub1.size() != sub2.size())
+    return false;
+
+  for(std::size_t i = 0; i < sub1.size(); i++)
+  {
+    if(&sub1[i].read() != &sub2[i].read() && !equal(sub1[i], sub2[i]))
+      return false;
+  }
+
+  return true;
+}
+
 bool irept::operator==(const irept &other) const
 {
   #ifdef IREP_HASH_STATS
@@ -150,7 +185,12 @@ bool irept::operator==(const irept &other) const
     return true;
   #endif
 
-  if(id() != other.id() || get_sub() != other.get_sub()) // recursive call
+  if(
+    hash_codes_differ(*this, other) || id() != other.id() ||
+    !equal_subs(
+      get_sub(),
+      other.get_sub(),
+      [](const irept &i1, const irept &i2) { return i1 == i2; }))
   {
     #ifdef IREP_HASH_STATS
     ++irep_cmp_ne_cnt;
@@ -206,13 +246,7 @@ bool irept::full_eq(const irept &other) const
     return true;
   #endif
 
-  if(id()!=other.id())
-    return false;
-
-  const irept::subt &i1_sub=get_sub();
-  const irept::subt &i2_sub=other.get_sub();
-
-  if(i1_sub.size() != i2_sub.size())
+  if(hash_codes_differ(*this, other) || id() != other.id())
     return false;
 
   const irept::named_subt &i1_named_sub=get_named_sub();
@@ -221,9 +255,13 @@ bool irept::full_eq(const irept &other) const
   if(i1_named_sub.size() != i2_named_sub.size())
     return false;
 
-  for(std::size_t i=0; i<i1_sub.size(); i++)
-    if(!i1_sub[i].full_eq(i2_sub[i]))
-      return false;
+  if(!equal_subs(
+       get_sub(), other.get_sub(), [](const irept &i1, const irept &i2) {
+         return i1.full_eq(i2);
+       }))
+  {
+    return false;
+  }
 
   {
     irept::named_subt::const_iterator i1_it=i1_named_sub.begin();
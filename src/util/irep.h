@@ -33,6 +33,18 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <map>
 #endif
 
+// Reference counts and cached hash codes are plain integers unless
+// IREP_THREAD_SAFE is set, which makes it safe to copy, destroy and hash
+// ireps that share nodes from several threads at once (at the cost of atomic
+// operations for each copy).
+#ifndef IREP_THREAD_SAFE
+#  define IREP_THREAD_SAFE 0
+#endif
+
+#if IREP_THREAD_SAFE
+#  include <atomic>
+#endif
+
 #ifdef USE_DSTRING
 typedef dstringt irep_idt;
 typedef dstringt irep_namet;
@@ -82,8 +94,58 @@ struct ref_count_ift
 template <>
 struct ref_count_ift<true>
 {
+#if IREP_THREAD_SAFE
+  ref_count_ift() = default;
+
+  // a copy of a node is referenced once
+  ref_count_ift(const ref_count_ift &)
+  {
+  }
+
+  ref_count_ift &operator=(const ref_count_ift &)
+  {
+    return *this;
+  }
+
+  std::atomic<unsigned> ref_count{1};
+#else
   unsigned ref_count = 1;
+#endif
+};
+
+#if IREP_THREAD_SAFE
+/// Hash code cached in a tree node. Concurrent readers of a node may compute
+/// and store its hash at the same time, which is benign as they all store the
+/// same value, hence relaxed ordering suffices.
+class irep_hash_codet
+{
+public:
+  irep_hash_codet() = default;
+
+  irep_hash_codet(const irep_hash_codet &other) : value(other)
+  {
+  }
+
+  irep_hash_codet &operator=(const irep_hash_codet &other)
+  {
+    return *this = static_cast<std::size_t>(other);
+  }
+
+  irep_hash_codet &operator=(std::size_t new_value)
+  {
+    value.store(new_value, std::memory_order_relaxed);
+    return *this;
+  }
+
+  operator std::size_t() const
+  {
+    return value.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<std::size_t> value{0};
 };
+#endif
 
 /// A node with data in a tree, it contains:
 ///
@@ -125,7 +187,11 @@ public:
   subt sub;
 
 #if HASH_CODE
+#  if IREP_THREAD_SAFE
+  mutable irep_hash_codet hash_code;
+#  else
   mutable std::size_t hash_code = 0;
+#  endif
 #endif
 
   void clear()
@@ -575,8 +641,7 @@ void sharing_treet<derivedt, named_subtreest>::remove_ref(dt *old_data)
   std::cout << "R: " << old_data << " " << old_data->ref_count << '\n';
 #endif
 
-  old_data->ref_count--;
-  if(old_data->ref_count == 0)
+  if(--old_data->ref_count == 0)
   {
 #ifdef IREP_DEBUG
     std::cout << "D: " << pretty() << '\n';
@@ -611,9 +676,7 @@ void sharing_treet<derivedt, named_subtreest>::nonrecursive_destructor(
       continue;
 
     INVARIANT(d->ref_count != 0, "All contents of the stack must be in use");
-    d->ref_count--;
-
-    if(d->ref_count == 0)
+    if(--d->ref_count == 0)
     {
       stack.reserve(
         stack.size() + std::distance(d->named_sub.begin(), d->named_sub.end()) +
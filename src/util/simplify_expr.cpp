@@ -26,6 +26,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "range.h"
 #include "rational.h"
 #include "rational_tools.h"
+#include "simplify_expr_cache.h"
 #include "simplify_utils.h"
 #include "std_expr.h"
 #include "string_expr.h"
@@ -39,30 +40,6 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "simplify_expr_class.h"
 
-// #define USE_CACHE
-
-#ifdef USE_CACHE
-struct simplify_expr_cachet
-{
-public:
-  #if 1
-  typedef std::unordered_map<
-    exprt, exprt, irep_full_hash, irep_full_eq> containert;
-  #else
-  typedef std::unordered_map<exprt, exprt, irep_hash> containert;
-  #endif
-
-  containert container_normal;
-
-  containert &container()
-  {
-    return container_normal;
-  }
-};
-
-simplify_expr_cachet simplify_expr_cache;
-#endif
-
 simplify_exprt::resultt<> simplify_exprt::simplify_abs(const abs_exprt &expr)
 {
   if(expr.op().is_constant())
@@ -2312,25 +2289,37 @@ simplify_exprt::resultt<> simplify_exprt::simplify_node(exprt node)
 
 simplify_exprt::resultt<> simplify_exprt::simplify_rec(const exprt &expr)
 {
-  // look up in cache
-
-  #ifdef USE_CACHE
-  std::pair<simplify_expr_cachet::containert::iterator, bool>
-    cache_result=simplify_expr_cache.container().
-      insert(std::pair<exprt, exprt>(expr, exprt()));
+  // expressions without operands are not simplified, and substitutions of the
+  // local replace map depend on the context
+  const bool use_cache = cache != nullptr && expr.has_operands()
+#ifdef USE_LOCAL_REPLACE_MAP
+                         && local_replace_map.empty()
+#endif
+    ;
 
-  if(!cache_result.second) // found!
+  if(use_cache)
   {
-    const exprt &new_expr=cache_result.first->second;
-
-    if(new_expr.id().empty())
-      return true; // no change
+    auto cached = cache->find(expr, cache_settings());
+    if(cached.has_value())
+    {
+      if(!cached->changed)
+        return unchanged(expr);
 
-    expr=new_expr;
-    return false;
+      return std::move(cached->expr);
+    }
   }
-  #endif
 
+  auto result = simplify_rec_uncached(expr);
+
+  if(use_cache)
+    cache->insert(expr, cache_settings(), {result.has_changed(), result.expr});
+
+  return result;
+}
+
+simplify_exprt::resultt<>
+simplify_exprt::simplify_rec_uncached(const exprt &expr)
+{
   // We work on a copy to prevent unnecessary destruction of sharing.
   exprt tmp=expr;
   bool no_change = simplify_node_preorder(tmp);
@@ -2369,11 +2358,6 @@ simplify_exprt::resultt<> simplify_exprt::simplify_rec(const exprt &expr)
   {
     POSTCONDITION(as_const(tmp).type() == expr.type());
 
-#ifdef USE_CACHE
-    // save in cache
-    cache_result.first->second = tmp;
-#endif
-
     return std::move(tmp);
   }
 }
@@ -2390,6 +2374,7 @@ bool simplify_exprt::simplify(exprt &expr)
   if(debug_on)
     std::cout << "FULLSIMP " << format(result.expr) << "\n";
 #endif
+
   if(result.has_changed())
   {
     expr = result.expr;
@@ -2405,8 +2390,26 @@ bool simplify(exprt &expr, const namespacet &ns)
   return simplify_exprt(ns).simplify(expr);
 }
 
+bool simplify(exprt &expr, const namespacet &ns, simplify_expr_cachet &cache)
+{
+  simplify_exprt simplifier(ns);
+  simplifier.set_cache(cache);
+  return simplifier.simplify(expr);
+}
+
 exprt simplify_expr(exprt src, const namespacet &ns)
 {
   simplify_exprt(ns).simplify(src);
   return src;
 }
+
+exprt simplify_expr(
+  exprt src,
+  const namespacet &ns,
+  simplify_expr_cachet &cache)
+{
+  simplify_exprt simplifier(ns);
+  simplifier.set_cache(cache);
+  simplifier.simplify(src);
+  return src;
+}
@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 class exprt;
 class namespacet;
+class simplify_expr_cachet;
 
 //
 // simplify an expression
@@ -24,7 +25,17 @@ bool simplify(
   exprt &expr,
   const namespacet &ns);
 
+/// Simplify \p expr, consulting and updating \p cache
+/// \return true if \p expr was not changed
+bool simplify(exprt &expr, const namespacet &ns, simplify_expr_cachet &cache);
+
 // this is the preferred interface
 exprt simplify_expr(exprt src, const namespacet &ns);
 
+/// Simplify \p src, consulting and updating \p cache
+exprt simplify_expr(
+  exprt src,
+  const namespacet &ns,
+  simplify_expr_cachet &cache);
+
 #endif // CPROVER_UTIL_SIMPLIFY_EXPR_H
@@ -0,0 +1,125 @@
+/*******************************************************************\
+
+Module: Cache of Simplification Results
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// Cache of Simplification Results
+
+#include "simplify_expr_cache.h"
+
+#include "irep_hash.h"
+
+#include <ostream>
+
+simplify_expr_cachet::keyt::keyt(exprt _expr, std::size_t _settings)
+  : expr(std::move(_expr)),
+    settings(_settings),
+    hash(hash_combine(expr.hash(), settings))
+{
+}
+
+simplify_expr_cachet::simplify_expr_cachet(std::size_t capacity)
+  : shard_count(
+      capacity == 0 ? 1 : capacity < max_shards ? capacity : max_shards),
+    shard_capacity(capacity / shard_count),
+    hits(0),
+    misses(0),
+    evictions(0)
+{
+}
+
+optionalt<simplify_expr_cachet::resultt>
+simplify_expr_cachet::find(const exprt &expr, std::size_t settings)
+{
+  const keyt key(expr, settings);
+  shardt &shard = shard_of(key.hash);
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto entry_it = shard.map.find(key);
+  if(entry_it == shard.map.end())
+  {
+    ++misses;
+    return {};
+  }
+
+  ++hits;
+  shard.lru.splice(
+    shard.lru.begin(), shard.lru, entry_it->second.lru_position);
+  return entry_it->second.result;
+}
+
+void simplify_expr_cachet::insert(
+  const exprt &expr,
+  std::size_t settings,
+  const resultt &result)
+{
+  if(shard_capacity == 0)
+    return;
+
+  keyt key(expr, settings);
+  shardt &shard = shard_of(key.hash);
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto entry_it = shard.map.find(key);
+  if(entry_it != shard.map.end())
+  {
+    // another thread may have simplified the same expression meanwhile
+    entry_it->second.result = result;
+    shard.lru.splice(
+      shard.lru.begin(), shard.lru, entry_it->second.lru_position);
+    return;
+  }
+
+  if(shard.map.size() >= shard_capacity)
+  {
+    shard.map.erase(shard.lru.back());
+    shard.lru.pop_back();
+    ++evictions;
+  }
+
+  shard.lru.push_front(key);
+  shard.map.emplace(std::move(key), entryt{result, shard.lru.begin()});
+}
+
+void simplify_expr_cachet::clear()
+{
+  for(auto &shard : shards)
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.map.clear();
+    shard.lru.clear();
+  }
+}
+
+simplify_expr_cache_statisticst simplify_expr_cachet::get_statistics() const
+{
+  simplify_expr_cache_statisticst result;
+  result.hits = hits;
+  result.misses = misses;
+  result.evictions = evictions;
+  result.size = 0;
+
+  for(const auto &shard : shards)
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    result.size += shard.map.size();
+  }
+
+  return result;
+}
+
+void simplify_expr_cache_statisticst::dump_on_stream(std::ostream &out) const
+{
+  const std::size_t lookups = hits + misses;
+  out << "Simplifier cache statistics:"
+      << "\n  lookups:   " << lookups << "\n  hits:      " << hits;
+  if(lookups != 0)
+    out << " (" << (100 * hits) / lookups << "%)";
+  out << "\n  evictions: " << evictions << "\n  size:      " << size << '\n';
+}
@@ -0,0 +1,142 @@
+/*******************************************************************\
+
+Module: Cache of Simplification Results
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+/// \file
+/// Cache of Simplification Results
+
+#ifndef CPROVER_UTIL_SIMPLIFY_EXPR_CACHE_H
+#define CPROVER_UTIL_SIMPLIFY_EXPR_CACHE_H
+
+#include "expr.h"
+#include "optional.h"
+
+#include <array>
+#include <atomic>
+#include <iosfwd>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+/// Statistics of a \ref simplify_expr_cachet
+struct simplify_expr_cache_statisticst
+{
+  std::size_t hits;
+  std::size_t misses;
+  std::size_t evictions;
+  std::size_t size;
+
+  void dump_on_stream(std::ostream &out) const;
+};
+
+/// Bounded cache of simplification results, which evicts the least recently
+/// used entries once full.
+///
+/// Expressions are compared including their comments (such as source
+/// locations), as the result of simplification may retain those. Results are
+/// also keyed on the settings of the simplifier that produced them (see
+/// simplify_exprt::cache_settings). As results depend on the symbols in scope,
+/// a cache must only be shared by simplifiers working on the same namespace.
+///
+/// The cache is split into shards, each guarded by its own mutex, so that it
+/// may be shared by several threads. Note that this requires ireps to be built
+/// with `IREP_THREAD_SAFE` as the cached expressions share nodes with the
+/// expressions of all threads.
+class simplify_expr_cachet
+{
+public:
+  /// Capacity of the caches that goto_check, symex and constant propagation
+  /// keep for the lifetime of their instance
+  static const std::size_t default_capacity = 1 << 16;
+
+  /// \param capacity: maximum number of expressions kept in the cache
+  explicit simplify_expr_cachet(std::size_t capacity = default_capacity);
+
+  simplify_expr_cachet(const simplify_expr_cachet &) = delete;
+  simplify_expr_cachet &operator=(const simplify_expr_cachet &) = delete;
+
+  struct resultt
+  {
+    /// false if \p expr is the expression that was looked up, unchanged
+    bool changed;
+    exprt expr;
+  };
+
+  /// Look up the result of simplifying \p expr with a simplifier whose
+  /// settings are \p settings
+  optionalt<resultt> find(const exprt &expr, std::size_t settings);
+
+  /// Record that simplifying \p expr with a simplifier whose settings are
+  /// \p settings yields \p result
+  void
+  insert(const exprt &expr, std::size_t settings, const resultt &result);
+
+  /// Remove all entries, but keep the statistics
+  void clear();
+
+  simplify_expr_cache_statisticst get_statistics() const;
+
+protected:
+  /// An expression and simplifier settings, along with a hash of both.
+  /// The hash of the expression ignores comments, but is cached in its nodes;
+  /// expressions differing in comments only are told apart by full_eq.
+  struct keyt
+  {
+    keyt(exprt _expr, std::size_t _settings);
+
+    exprt expr;
+    std::size_t settings;
+    std::size_t hash;
+
+    bool operator==(const keyt &other) const
+    {
+      return hash == other.hash && settings == other.settings &&
+             expr.full_eq(other.expr);
+    }
+  };
+
+  struct key_hasht
+  {
+    std::size_t operator()(const keyt &key) const
+    {
+      return key.hash;
+    }
+  };
+
+  using lru_listt = std::list<keyt>;
+
+  struct entryt
+  {
+    resultt result;
+    lru_listt::iterator lru_position;
+  };
+
+  struct shardt
+  {
+    mutable std::mutex mutex;
+    // most recently used first
+    lru_listt lru;
+    std::unordered_map<keyt, entryt, key_hasht> map;
+  };
+
+  static const std::size_t max_shards = 16;
+  std::array<shardt, max_shards> shards;
+  // small caches use fewer shards to keep least-recently-used eviction exact
+  std::size_t shard_count;
+  std::size_t shard_capacity;
+
+  std::atomic<std::size_t> hits;
+  std::atomic<std::size_t> misses;
+  std::atomic<std::size_t> evictions;
+
+  shardt &shard_of(std::size_t hash)
+  {
+    return shards[(hash ^ (hash >> 16)) % shard_count];
+  }
+};
+
+#endif // CPROVER_UTIL_SIMPLIFY_EXPR_CACHE_H
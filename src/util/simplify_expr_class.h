@@ -59,6 +59,7 @@ class popcount_exprt;
 class refined_string_exprt;
 class shift_exprt;
 class sign_exprt;
+class simplify_expr_cachet;
 class typecast_exprt;
 class unary_exprt;
 class unary_minus_exprt;
@@ -71,7 +72,8 @@ class simplify_exprt
 public:
   explicit simplify_exprt(const namespacet &_ns):
     do_simplify_if(true),
-    ns(_ns)
+    ns(_ns),
+    cache(nullptr)
 #ifdef DEBUG_ON_DEMAND
     , debug_on(false)
 #endif
@@ -88,6 +90,20 @@ public:
 
   bool do_simplify_if;
 
+  /// Reuse and record the results of simplifying an expression and each of
+  /// its subexpressions in \p _cache
+  void set_cache(simplify_expr_cachet &_cache)
+  {
+    cache = &_cache;
+  }
+
+  /// The options that results depend on, which keep the results of
+  /// differently configured simplifiers apart in a shared cache
+  std::size_t cache_settings() const
+  {
+    return do_simplify_if ? 1 : 0;
+  }
+
   template <typename T = exprt>
   struct resultt
   {
@@ -214,6 +230,7 @@ public:
   NODISCARD resultt<> simplify_node(exprt);
   bool simplify_node_preorder(exprt &expr);
   NODISCARD resultt<> simplify_rec(const exprt &);
+  NODISCARD resultt<> simplify_rec_uncached(const exprt &);
 
   virtual bool simplify(exprt &expr);
 
@@ -226,6 +243,7 @@ public:
 
 protected:
   const namespacet &ns;
+  simplify_expr_cachet *cache;
 #ifdef DEBUG_ON_DEMAND
   bool debug_on;
 #endif
@@ -11,9 +11,10 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "string_container.h"
 
+#include "invariant.h"
+
 #include <cstring>
 #include <iostream>
-#include <numeric>
 
 string_ptrt::string_ptrt(const char *_s):s(_s), len(strlen(_s))
 {
@@ -27,85 +28,174 @@ bool string_ptrt::operator==(const string_ptrt &other) const
   return len==0 || memcmp(s, other.s, len)==0;
 }
 
-string_containert::~string_containert()
+string_containert::tablet::tablet(std::size_t capacity)
+  : mask(capacity - 1), slots(new std::atomic<std::uint64_t>[capacity])
 {
+  for(std::size_t i = 0; i < capacity; ++i)
+    slots[i].store(0, std::memory_order_relaxed);
 }
 
-unsigned string_containert::get(const char *s)
+string_containert::shardt::shardt()
 {
-  string_ptrt string_ptr(s);
-
-  hash_tablet::iterator it=hash_table.find(string_ptr);
-
-  if(it!=hash_table.end())
-    return it->second;
-
-  size_t r=hash_table.size();
-
-  // these are stable
-  string_list.push_back(std::string(s));
-  string_ptrt result(string_list.back());
-
-  hash_table[result]=r;
-
-  // these are not
-  string_vector.push_back(&string_list.back());
-
-  return r;
+  tables.emplace_back(new tablet(initial_capacity));
+  table.store(tables.back().get(), std::memory_order_release);
 }
 
-unsigned string_containert::get(const std::string &s)
+string_containert::~string_containert()
 {
-  string_ptrt string_ptr(s);
-
-  hash_tablet::iterator it=hash_table.find(string_ptr);
+  for(auto &chunk : chunks)
+    delete[] chunk.load(std::memory_order_relaxed);
+}
 
-  if(it!=hash_table.end())
-    return it->second;
+string_containert::shardt &string_containert::shard_of(std::size_t hash)
+{
+  // the low bits of hash are used to index the table of a shard, mix the
+  // others to pick the shard
+  std::size_t h = hash ^ (hash >> 16);
+  h *= 0x45d9f3b;
+  h ^= h >> 16;
+  return shards[h & ((std::size_t(1) << shard_bits) - 1)];
+}
 
-  size_t r=hash_table.size();
+unsigned string_containert::find(
+  const tablet &table,
+  const string_ptrt &s,
+  std::size_t hash) const
+{
+  const std::uint32_t tag = static_cast<std::uint32_t>(hash);
+
+  for(std::size_t i = hash & table.mask;; i = (i + 1) & table.mask)
+  {
+    const std::uint64_t v = table.slots[i].load(std::memory_order_acquire);
+    const unsigned no = static_cast<unsigned>(v);
+    if(no == 0)
+      return 0;
+
+    if(static_cast<std::uint32_t>(v >> 32) == tag)
+    {
+      const entryt &e = entry(no - 1);
+      if(e.hash == hash && string_ptrt(e.s) == s)
+        return no;
+    }
+  }
+}
 
-  // these are stable
-  string_list.push_back(s);
-  string_ptrt result(string_list.back());
+void string_containert::insert(tablet &table, unsigned no, std::size_t hash)
+{
+  std::size_t i = hash & table.mask;
+  while(table.slots[i].load(std::memory_order_relaxed) != 0)
+    i = (i + 1) & table.mask;
 
-  hash_table[result]=r;
+  const std::uint64_t tag = static_cast<std::uint32_t>(hash);
+  table.slots[i].store((tag << 32) | (no + 1), std::memory_order_release);
+}
 
-  // these are not
-  string_vector.push_back(&string_list.back());
+string_containert::entryt &string_containert::new_entry(std::size_t no)
+{
+  const std::size_t k = chunk_of(no);
+  PRECONDITION(k < max_chunks);
+
+  entryt *chunk = chunks[k].load(std::memory_order_acquire);
+
+  if(chunk == nullptr)
+  {
+    // several shards may fill the same chunk
+    std::lock_guard<std::mutex> lock(chunks_mutex);
+    chunk = chunks[k].load(std::memory_order_relaxed);
+    if(chunk == nullptr)
+    {
+      chunk = new entryt[chunk_size(k)];
+      chunks[k].store(chunk, std::memory_order_release);
+    }
+  }
+
+  return chunk[no - chunk_begin(k)];
+}
 
-  return r;
+unsigned string_containert::get(const string_ptrt &s)
+{
+  const std::size_t hash = string_ptr_hash()(s);
+  shardt &shard = shard_of(hash);
+
+  // lock-free lookup, which is all that is needed for known strings
+  const tablet &current = *shard.table.load(std::memory_order_acquire);
+  if(const unsigned v = find(current, s, hash))
+    return v - 1;
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  // the string may have been added, or the table replaced, in the meantime
+  tablet *table = shard.table.load(std::memory_order_relaxed);
+  if(const unsigned v = find(*table, s, hash))
+    return v - 1;
+
+  const unsigned no = next_number.fetch_add(1, std::memory_order_relaxed);
+
+  entryt &e = new_entry(no);
+  e.s.assign(s.s, s.len);
+  e.hash = hash;
+
+  // keep the load factor below one half
+  if(2 * (shard.size + 1) > table->mask + 1)
+  {
+    std::unique_ptr<tablet> bigger(new tablet(2 * (table->mask + 1)));
+    for(std::size_t i = 0; i <= table->mask; ++i)
+    {
+      const unsigned v =
+        static_cast<unsigned>(table->slots[i].load(std::memory_order_relaxed));
+      if(v != 0)
+        insert(*bigger, v - 1, entry(v - 1).hash);
+    }
+
+    table = bigger.get();
+    shard.tables.push_back(std::move(bigger));
+  }
+
+  insert(*table, no, hash);
+  ++shard.size;
+  shard.table.store(table, std::memory_order_release);
+
+  return no;
 }
 
 void string_container_statisticst::dump_on_stream(std::ostream &out) const
 {
-  auto total_memory_usage = strings_memory_usage + vector_memory_usage +
-                            map_memory_usage + list_memory_usage;
+  auto total_memory_usage =
+    strings_memory_usage + chunks_memory_usage + table_memory_usage;
   out << "String container statistics:"
       << "\n  string count: " << string_count
       << "\n  string memory usage: " << strings_memory_usage.to_string()
-      << "\n  vector memory usage: " << vector_memory_usage.to_string()
-      << "\n  map memory usage:    " << map_memory_usage.to_string()
-      << "\n  list memory usage:   " << list_memory_usage.to_string()
+      << "\n  chunks memory usage: " << chunks_memory_usage.to_string()
+      << "\n  table memory usage:  " << table_memory_usage.to_string()
       << "\n  total memory usage:  " << total_memory_usage.to_string() << '\n';
 }
 
 string_container_statisticst string_containert::compute_statistics() const
 {
   string_container_statisticst result;
-  result.string_count = string_vector.size();
-  result.vector_memory_usage = memory_sizet::from_bytes(
-    sizeof(string_vector) +
-    sizeof(string_vectort::value_type) * string_vector.capacity());
-  result.strings_memory_usage = memory_sizet::from_bytes(std::accumulate(
-    begin(string_vector),
-    end(string_vector),
-    std::size_t(0),
-    [](std::size_t sz, const std::string *s) { return sz + s->capacity(); }));
-  result.map_memory_usage = memory_sizet::from_bytes(
-    sizeof(hash_table) + hash_table.size() * sizeof(hash_tablet::value_type));
-
-  result.list_memory_usage = memory_sizet::from_bytes(
-    sizeof(string_list) + 2 * sizeof(void *) * string_list.size());
+  result.string_count = next_number.load(std::memory_order_acquire);
+
+  std::size_t chunk_bytes = sizeof(chunks);
+  for(std::size_t k = 0; k < max_chunks; ++k)
+  {
+    if(chunks[k].load(std::memory_order_acquire) != nullptr)
+      chunk_bytes += sizeof(entryt) * chunk_size(k);
+  }
+
+  std::size_t string_bytes = 0;
+  for(std::size_t no = 0; no < result.string_count; ++no)
+    string_bytes += get_string(no).capacity();
+
+  // tables that have been replaced by larger ones are not accounted for
+  std::size_t table_bytes = sizeof(shards);
+  for(const auto &shard : shards)
+  {
+    const tablet *table = shard.table.load(std::memory_order_acquire);
+    table_bytes += sizeof(tablet) + sizeof(std::uint64_t) * (table->mask + 1);
+  }
+
+  result.chunks_memory_usage = memory_sizet::from_bytes(chunk_bytes);
+  result.strings_memory_usage = memory_sizet::from_bytes(string_bytes);
+  result.table_memory_usage = memory_sizet::from_bytes(table_bytes);
   return result;
 }
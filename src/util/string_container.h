@@ -12,8 +12,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_STRING_CONTAINER_H
 #define CPROVER_UTIL_STRING_CONTAINER_H
 
-#include <list>
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include "memory_units.h"
@@ -53,58 +57,141 @@ struct string_container_statisticst
 {
   std::size_t string_count;
   memory_sizet strings_memory_usage;
-  memory_sizet vector_memory_usage;
-  memory_sizet map_memory_usage;
-  memory_sizet list_memory_usage;
+  memory_sizet chunks_memory_usage;
+  memory_sizet table_memory_usage;
 
   void dump_on_stream(std::ostream &out) const;
 };
 
+/// Interning table mapping strings to consecutive numbers, and back.
+///
+/// The container may be used from several threads at once:
+/// - strings are stored in append-only chunks of geometrically growing size,
+///   hence a string, once inserted, never moves and retrieving it by number
+///   (\ref get_string, \ref c_str) takes no lock;
+/// - the string-to-number table is split into shards selected by the hash of
+///   the string. Each shard is an open-addressing table of numbers that is
+///   probed without locking; only inserting a new string (or growing the
+///   table of a shard) takes the mutex of that one shard.
 class string_containert
 {
 public:
   unsigned operator[](const char *s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   unsigned operator[](const std::string &s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   // constructor and destructor
   string_containert();
   ~string_containert();
 
+  string_containert(const string_containert &) = delete;
+  string_containert &operator=(const string_containert &) = delete;
+
   // the pointer is guaranteed to be stable
   const char *c_str(size_t no) const
   {
-    return string_vector[no]->c_str();
+    return get_string(no).c_str();
   }
 
   // the reference is guaranteed to be stable
   const std::string &get_string(size_t no) const
   {
-    return *string_vector[no];
+    return entry(no).s;
   }
 
   string_container_statisticst compute_statistics() const;
 
 protected:
-  // the 'unsigned' ought to be size_t
-  typedef std::unordered_map<string_ptrt, unsigned, string_ptr_hash>
-    hash_tablet;
-  hash_tablet hash_table;
+  struct entryt
+  {
+    std::string s;
+    std::size_t hash;
+  };
+
+  // Chunk k holds (1 << (chunk_base_bits + k)) entries, which suffices to
+  // store any number that fits in an unsigned.
+  static const std::size_t chunk_base_bits = 10;
+  static const std::size_t max_chunks = 32;
+  std::array<std::atomic<entryt *>, max_chunks> chunks;
+  std::mutex chunks_mutex;
+  std::atomic<unsigned> next_number;
+
+  static std::size_t chunk_of(std::size_t no)
+  {
+    std::size_t v = (no >> chunk_base_bits) + 1;
+#ifdef __GNUC__
+    return sizeof(unsigned long long) * 8 - 1 -
+           static_cast<std::size_t>(__builtin_clzll(v));
+#else
+    std::size_t k = 0;
+    while(v >>= 1)
+      ++k;
+    return k;
+#endif
+  }
+
+  static std::size_t chunk_begin(std::size_t k)
+  {
+    return ((std::size_t(1) << k) - 1) << chunk_base_bits;
+  }
+
+  static std::size_t chunk_size(std::size_t k)
+  {
+    return std::size_t(1) << (chunk_base_bits + k);
+  }
+
+  const entryt &entry(std::size_t no) const
+  {
+    const std::size_t k = chunk_of(no);
+    return chunks[k].load(std::memory_order_acquire)[no - chunk_begin(k)];
+  }
+
+  entryt &new_entry(std::size_t no);
+
+  /// Open-addressing table. Each slot holds the string number plus one in
+  /// its lower half (zero marks an empty slot), and the lower bits of the
+  /// hash of the string in its upper half to skip most mismatching entries
+  /// without touching them.
+  struct tablet
+  {
+    explicit tablet(std::size_t capacity);
+
+    std::size_t mask;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> slots;
+  };
+
+  struct shardt
+  {
+    shardt();
+
+    static const std::size_t initial_capacity = 64;
+
+    std::mutex mutex;
+    std::atomic<tablet *> table;
+    // the following are guarded by mutex
+    std::size_t size = 0;
+    // tables that were replaced by a larger one may still be read from by
+    // concurrent lookups, hence they are only freed with the container
+    std::vector<std::unique_ptr<tablet>> tables;
+  };
+
+  static const std::size_t shard_bits = 6;
+  std::array<shardt, std::size_t(1) << shard_bits> shards;
 
-  unsigned get(const char *s);
-  unsigned get(const std::string &s);
+  shardt &shard_of(std::size_t hash);
 
-  typedef std::list<std::string> string_listt;
-  string_listt string_list;
+  /// \return the number of \p s plus one, or zero if not in \p table
+  unsigned find(const tablet &table, const string_ptrt &s, std::size_t hash)
+    const;
+  void insert(tablet &table, unsigned no, std::size_t hash);
 
-  typedef std::vector<std::string *> string_vectort;
-  string_vectort string_vector;
+  unsigned get(const string_ptrt &s);
 };
 
 /// Get a reference to the global string container.
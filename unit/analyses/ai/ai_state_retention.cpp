@@ -0,0 +1,134 @@
+/*******************************************************************\
+
+Module: Unit tests for discarding transient abstract states
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for ai_baset::state_retentiont
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/ai.h>
+#include <analyses/constant_propagator.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/config.h>
+#include <util/make_unique.h>
+
+#include <sstream>
+
+/// Location sensitive storage that reports how many domains it holds
+class counting_storaget : public location_sensitive_storaget
+{
+public:
+  std::size_t size() const
+  {
+    return state_map.size();
+  }
+};
+
+SCENARIO(
+  "Discarding the abstract states between join points",
+  "[core][analyses][ai][state_retentiont]")
+{
+  // main() {
+  //   x = 0;
+  //   while(x != 10) { x = x + 1; y = x; z = y; }
+  //   y = 1;
+  //   z = 2;
+  // }
+  config.ansi_c.set_LP64();
+
+  goto_modelt goto_model;
+  symbol_tablet &symbol_table = goto_model.symbol_table;
+
+  symbolt main;
+  main.name = "main";
+  main.base_name = "main";
+  main.mode = ID_C;
+  main.type = code_typet({}, empty_typet());
+  symbol_table.add(main);
+
+  std::vector<symbol_exprt> variables;
+  for(const char *name : {"x", "y", "z"})
+  {
+    symbolt variable;
+    variable.name = name;
+    variable.base_name = name;
+    variable.mode = ID_C;
+    variable.type = signed_int_type();
+    variable.is_lvalue = true;
+    variable.is_static_lifetime = true;
+    symbol_table.add(variable);
+    variables.push_back(variable.symbol_expr());
+  }
+  const symbol_exprt &x = variables[0];
+  const symbol_exprt &y = variables[1];
+  const symbol_exprt &z = variables[2];
+  auto constant = [](int value) {
+    return from_integer(value, signed_int_type());
+  };
+
+  goto_programt &body = goto_model.goto_functions.function_map["main"].body;
+  body.add(goto_programt::make_assignment(x, constant(0)));
+  const auto loop_head = body.add(
+    goto_programt::make_incomplete_goto(equal_exprt(x, constant(10))));
+  body.add(goto_programt::make_assignment(x, plus_exprt(x, constant(1))));
+  body.add(goto_programt::make_assignment(y, x));
+  body.add(goto_programt::make_assignment(z, y));
+  const auto back_edge = body.add(goto_programt::make_incomplete_goto());
+  back_edge->complete_goto(loop_head);
+  const auto after_loop =
+    body.add(goto_programt::make_assignment(y, constant(1)));
+  loop_head->complete_goto(after_loop);
+  body.add(goto_programt::make_assignment(z, constant(2)));
+  body.add(goto_programt::make_end_function());
+  goto_model.goto_functions.update();
+
+  const namespacet ns(symbol_table);
+
+  auto analyse = [&](
+                   ai_baset::state_retentiont retention, std::size_t &size) {
+    auto storage = util_make_unique<counting_storaget>();
+    const counting_storaget &counting_storage = *storage;
+    auto analysis = util_make_unique<ai_recursive_interproceduralt>(
+      util_make_unique<ai_history_factory_default_constructort<ahistoricalt>>(),
+      util_make_unique<
+        ai_domain_factory_default_constructort<constant_propagator_domaint>>(),
+      std::move(storage));
+    analysis->set_state_retention(retention);
+    (*analysis)("main", goto_model.goto_functions.function_map["main"], ns);
+    size = counting_storage.size();
+    return analysis;
+  };
+
+  std::size_t all_size;
+  const auto all = analyse(ai_baset::state_retentiont::ALL, all_size);
+  std::size_t join_points_size;
+  const auto join_points =
+    analyse(ai_baset::state_retentiont::JOIN_POINTS, join_points_size);
+
+  THEN("Only the states at the join points are stored")
+  {
+    REQUIRE(all_size == body.instructions.size());
+    // The entry, the loop head and the end of the function
+    REQUIRE(join_points_size == 3);
+  }
+
+  THEN("The discarded states are recomputed")
+  {
+    forall_goto_program_instructions(it, body)
+    {
+      std::ostringstream expected;
+      all->abstract_state_before(it)->output(expected, *all, ns);
+      std::ostringstream recomputed;
+      join_points->abstract_state_before(it)->output(
+        recomputed, *join_points, ns);
+      REQUIRE(recomputed.str() == expected.str());
+    }
+  }
+}
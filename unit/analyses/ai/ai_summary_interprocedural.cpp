@@ -0,0 +1,141 @@
+/*******************************************************************\
+
+Module: Unit tests for ai_summary_interproceduralt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for ai_summary_interproceduralt
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/ai_summary_interprocedural.h>
+#include <analyses/constant_propagator.h>
+
+#include <goto-programs/goto_model.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/config.h>
+#include <util/make_unique.h>
+
+static symbolt make_function_symbol(const irep_idt &name)
+{
+  symbolt function;
+  function.name = name;
+  function.base_name = name;
+  function.mode = ID_C;
+  function.type = code_typet({}, empty_typet());
+  return function;
+}
+
+static symbolt make_global_symbol(const irep_idt &name)
+{
+  symbolt global;
+  global.name = name;
+  global.base_name = name;
+  global.mode = ID_C;
+  global.type = signed_int_type();
+  global.is_lvalue = true;
+  global.is_static_lifetime = true;
+  return global;
+}
+
+SCENARIO(
+  "ai_summary_interproceduralt analyses each calling context separately",
+  "[core][analyses][ai][ai_summary_interproceduralt]")
+{
+  // __CPROVER__start() { main(); }
+  //
+  // main() {
+  //   g = 1; copy();
+  //   g = 2; copy();
+  //   g = 1; copy();
+  // }
+  //
+  // copy() { r = g; }
+
+  config.ansi_c.set_LP64();
+
+  goto_modelt goto_model;
+
+  const symbolt g = make_global_symbol("g");
+  const symbolt r = make_global_symbol("r");
+  const symbolt copy = make_function_symbol("copy");
+  const symbolt main = make_function_symbol("main");
+  const symbolt start =
+    make_function_symbol(goto_functionst::entry_point());
+  for(const auto &symbol : {g, r, copy, main, start})
+    goto_model.symbol_table.add(symbol);
+
+  goto_programt &copy_body =
+    goto_model.goto_functions.function_map["copy"].body;
+  copy_body.add(
+    goto_programt::make_assignment(r.symbol_expr(), g.symbol_expr()));
+  copy_body.add(goto_programt::make_end_function());
+
+  goto_programt &main_body =
+    goto_model.goto_functions.function_map["main"].body;
+  std::vector<goto_programt::const_targett> return_sites;
+  for(int value : {1, 2, 1})
+  {
+    main_body.add(goto_programt::make_assignment(
+      g.symbol_expr(), from_integer(value, signed_int_type())));
+    main_body.add(goto_programt::make_function_call(
+      code_function_callt(copy.symbol_expr())));
+    return_sites.push_back(main_body.add(goto_programt::make_skip()));
+  }
+  main_body.add(goto_programt::make_end_function());
+
+  goto_programt &start_body =
+    goto_model.goto_functions.function_map[start.name].body;
+  start_body.add(goto_programt::make_function_call(
+    code_function_callt(main.symbol_expr())));
+  start_body.add(goto_programt::make_end_function());
+
+  goto_model.goto_functions.update();
+
+  ai_summary_interproceduralt analysis(
+    util_make_unique<ai_history_factory_default_constructort<ahistoricalt>>(),
+    util_make_unique<
+      ai_domain_factory_default_constructort<constant_propagator_domaint>>(),
+    util_make_unique<location_sensitive_storaget>());
+
+  WHEN("The program is analysed")
+  {
+    analysis(goto_model);
+
+    const namespacet ns(goto_model.symbol_table);
+    auto value_of_r_is = [&](goto_programt::const_targett l, int value) {
+      exprt condition =
+        equal_exprt(r.symbol_expr(), from_integer(value, signed_int_type()));
+      analysis.abstract_state_before(l)->ai_simplify(condition, ns);
+      return condition.is_true();
+    };
+
+    THEN("The value of r after each call is known")
+    {
+      REQUIRE(value_of_r_is(return_sites[0], 1));
+      REQUIRE(value_of_r_is(return_sites[1], 2));
+      REQUIRE(value_of_r_is(return_sites[2], 1));
+    }
+
+    THEN("The state in copy is the join over all calling contexts")
+    {
+      REQUIRE_FALSE(value_of_r_is(std::prev(copy_body.instructions.end()), 1));
+      REQUIRE_FALSE(value_of_r_is(std::prev(copy_body.instructions.end()), 2));
+      REQUIRE_FALSE(
+        analysis.abstract_state_before(copy_body.instructions.begin())
+          ->is_bottom());
+    }
+
+    THEN("The summary of the first call is reused for the third")
+    {
+      // main, and the first two calls of copy
+      REQUIRE(analysis.get_summaries_computed() == 3);
+      REQUIRE(analysis.get_summaries_reused() == 1);
+    }
+  }
+}
@@ -0,0 +1,127 @@
+/*******************************************************************\
+
+Module: Unit tests for instruction_dependenciest
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for instruction_dependenciest
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/json.h>
+#include <util/namespace.h>
+#include <util/std_code.h>
+#include <util/std_types.h>
+#include <util/symbol_table.h>
+
+#include <analyses/dependence_graph.h>
+#include <analyses/instruction_dependencies.h>
+
+static void add_program(goto_functionst &goto_functions, int value)
+{
+  const symbol_exprt x("x", signedbv_typet(32));
+  const symbol_exprt y("y", signedbv_typet(32));
+
+  // __CPROVER__start() { x = value; y = x; assert(y == value); }
+  goto_programt &start =
+    goto_functions.function_map[goto_functionst::entry_point()].body;
+  start.add(goto_programt::make_assignment(x, from_integer(value, x.type())));
+  start.add(goto_programt::make_assignment(y, x));
+  start.add(goto_programt::make_assertion(
+    equal_exprt(y, from_integer(value, y.type()))));
+  start.add(goto_programt::make_end_function());
+  goto_functions.update();
+}
+
+SCENARIO(
+  "Dependencies between instructions can be stored and reused",
+  "[core][analyses][instruction_dependencies]")
+{
+  symbol_tablet symbol_table;
+  for(const irep_idt name : {"x", "y"})
+  {
+    symbolt symbol;
+    symbol.name = name;
+    symbol.base_name = name;
+    symbol.type = signedbv_typet(32);
+    symbol.is_lvalue = true;
+    symbol.is_static_lifetime = true;
+    symbol_table.add(symbol);
+  }
+  const namespacet ns(symbol_table);
+
+  goto_functionst goto_functions;
+  add_program(goto_functions, 1);
+
+  dependence_grapht dependence_graph(ns);
+  dependence_graph(goto_functions, ns);
+  const instruction_dependenciest dependencies(
+    goto_functions, dependence_graph);
+
+  const goto_programt &start =
+    goto_functions.function_map.at(goto_functionst::entry_point()).body;
+  const auto assign_x = start.instructions.begin();
+  const auto assign_y = std::next(assign_x);
+  const auto assertion = std::next(assign_y);
+
+  THEN("The data dependencies are extracted from the dependence graph")
+  {
+    REQUIRE(
+      dependencies.dependencies(assign_y) ==
+      instruction_dependenciest::locationst{assign_x});
+    REQUIRE(
+      dependencies.dependencies(assertion) ==
+      instruction_dependenciest::locationst{assign_y});
+    REQUIRE(dependencies.dependencies(assign_x).empty());
+  }
+
+  const jsont json = dependencies.output_json(symbol_table);
+
+  WHEN("Reading them back for the same program loaded again")
+  {
+    goto_functionst reloaded;
+    add_program(reloaded, 1);
+    // source locations do not matter
+    goto_programt &reloaded_start =
+      reloaded.function_map.at(goto_functionst::entry_point()).body;
+    reloaded_start.instructions.front().source_location.set_line(42);
+
+    std::vector<irep_idt> changed_functions;
+    const auto result = instruction_dependenciest::from_json(
+      json, reloaded, symbol_table, changed_functions);
+
+    THEN("The same dependencies are found for the new instructions")
+    {
+      REQUIRE(result.has_value());
+      REQUIRE(changed_functions.empty());
+
+      const auto reloaded_assign_x = reloaded_start.instructions.begin();
+      const auto reloaded_assign_y = std::next(reloaded_assign_x);
+      REQUIRE(
+        result->dependencies(reloaded_assign_y) ==
+        instruction_dependenciest::locationst{reloaded_assign_x});
+      REQUIRE(result->output_json(symbol_table) == json);
+    }
+  }
+
+  WHEN("Reading them back for a changed program")
+  {
+    goto_functionst changed;
+    add_program(changed, 2);
+
+    std::vector<irep_idt> changed_functions;
+    const auto result = instruction_dependenciest::from_json(
+      json, changed, symbol_table, changed_functions);
+
+    THEN("The dependencies are not reused")
+    {
+      REQUIRE_FALSE(result.has_value());
+      REQUIRE(changed_functions.size() == 1);
+      REQUIRE(changed_functions.front() == goto_functionst::entry_point());
+    }
+  }
+}
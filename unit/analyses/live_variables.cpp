@@ -0,0 +1,86 @@
+/*******************************************************************\
+
+Module: Unit tests for live_variablest
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for live_variablest
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/live_variables.h>
+
+#include <util/pointer_expr.h>
+#include <util/std_code.h>
+
+SCENARIO(
+  "Live variables of a function",
+  "[core][analyses][live_variablest]")
+{
+  // f(a) {
+  // 0: DECL x
+  // 1: x = 1
+  // 2: DECL y
+  // 3: y = x
+  // 4: DECL z
+  // 5: p = &z
+  // 6: ASSERT y
+  // 7: END_FUNCTION
+  // }
+  const symbol_exprt a("a", bool_typet());
+  const symbol_exprt x("x", bool_typet());
+  const symbol_exprt y("y", bool_typet());
+  const symbol_exprt z("z", bool_typet());
+  const symbol_exprt p("p", pointer_typet(bool_typet(), 64));
+
+  goto_functionst goto_functions;
+  goto_functiont &f = goto_functions.function_map["f"];
+  f.parameter_identifiers.push_back(a.get_identifier());
+
+  goto_programt &body = f.body;
+  std::vector<goto_programt::const_targett> instructions;
+  instructions.push_back(body.add(goto_programt::make_decl(x)));
+  instructions.push_back(
+    body.add(goto_programt::make_assignment(x, true_exprt())));
+  instructions.push_back(body.add(goto_programt::make_decl(y)));
+  instructions.push_back(body.add(goto_programt::make_assignment(y, x)));
+  instructions.push_back(body.add(goto_programt::make_decl(z)));
+  instructions.push_back(body.add(goto_programt::make_assignment(
+    p, address_of_exprt(z, to_pointer_type(p.type())))));
+  instructions.push_back(body.add(goto_programt::make_assertion(y)));
+  instructions.push_back(body.add(goto_programt::make_end_function()));
+  goto_functions.update();
+
+  const live_variablest live_variables(goto_functions);
+  auto dying_at = [&](std::size_t i) {
+    const auto &dying = live_variables.dying_at(instructions[i]);
+    return std::set<irep_idt>(dying.begin(), dying.end());
+  };
+
+  THEN("Unused parameters are dead on entry")
+  {
+    REQUIRE(dying_at(0) == std::set<irep_idt>{"a"});
+  }
+
+  THEN("Variables die after their last use")
+  {
+    REQUIRE(dying_at(2).empty());
+    REQUIRE(dying_at(4) == std::set<irep_idt>{"x"});
+    REQUIRE(dying_at(7) == std::set<irep_idt>{"y"});
+  }
+
+  THEN("Declarations followed by a definition are dead")
+  {
+    REQUIRE(dying_at(1) == std::set<irep_idt>{"x"});
+    REQUIRE(dying_at(3) == std::set<irep_idt>{"y"});
+  }
+
+  THEN("Variables whose address is taken are never considered dead")
+  {
+    for(std::size_t i = 0; i < instructions.size(); ++i)
+      REQUIRE(dying_at(i).count("z") == 0);
+  }
+}
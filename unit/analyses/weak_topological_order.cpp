@@ -0,0 +1,270 @@
+/*******************************************************************\
+
+Module: Unit tests for weak_topological_ordert
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for weak_topological_ordert and its use as the worklist order
+/// of the abstract interpreter
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/ai.h>
+#include <analyses/weak_topological_order.h>
+
+#include <util/optional.h>
+#include <util/symbol_table.h>
+
+#include <sstream>
+
+static std::string output(const weak_topological_ordert &order)
+{
+  std::ostringstream out;
+  order.output(out);
+  return out.str();
+}
+
+static symbol_exprt nondet_bool(const irep_idt &name)
+{
+  return symbol_exprt(name, bool_typet());
+}
+
+/// Adds a jump, which is completed by \ref resolve_targets
+static goto_programt::targett
+add_goto(goto_programt &goto_program, bool conditional = true)
+{
+  if(!conditional)
+    return goto_program.add(goto_programt::make_incomplete_goto());
+
+  return goto_program.add(goto_programt::make_incomplete_goto(
+    nondet_bool("c" + std::to_string(goto_program.instructions.size()))));
+}
+
+/// Sets the targets of the jumps to the instructions with the given indices
+static void resolve_targets(
+  goto_programt &goto_program,
+  const std::vector<std::pair<goto_programt::targett, std::size_t>> &jumps)
+{
+  std::vector<goto_programt::targett> instructions;
+  for(auto it = goto_program.instructions.begin();
+      it != goto_program.instructions.end();
+      ++it)
+  {
+    instructions.push_back(it);
+  }
+
+  for(const auto &jump : jumps)
+    jump.first->complete_goto(instructions.at(jump.second));
+
+  goto_program.update();
+}
+
+SCENARIO(
+  "Weak topological order of goto programs",
+  "[core][analyses][weak_topological_ordert]")
+{
+  goto_programt goto_program;
+
+  GIVEN("Nested loops laid out in order")
+  {
+    // 0: SKIP
+    // 1: IF c GOTO 7
+    // 2: IF c GOTO 5
+    // 3: SKIP
+    // 4: GOTO 2
+    // 5: SKIP
+    // 6: GOTO 1
+    // 7: END_FUNCTION
+    goto_program.add(goto_programt::make_skip());
+    const auto outer_exit = add_goto(goto_program);
+    const auto inner_exit = add_goto(goto_program);
+    goto_program.add(goto_programt::make_skip());
+    const auto inner_back = add_goto(goto_program, false);
+    goto_program.add(goto_programt::make_skip());
+    const auto outer_back = add_goto(goto_program, false);
+    goto_program.add(goto_programt::make_end_function());
+    resolve_targets(
+      goto_program,
+      {{outer_exit, 7}, {inner_exit, 5}, {inner_back, 2}, {outer_back, 1}});
+
+    THEN("The loops are nested components")
+    {
+      const weak_topological_ordert order(goto_program);
+      REQUIRE(output(order) == "0 (1 (2 3 4) 5 6) 7");
+      REQUIRE(order.is_head(std::next(goto_program.instructions.begin(), 1)));
+      REQUIRE(order.is_head(std::next(goto_program.instructions.begin(), 2)));
+      REQUIRE(!order.is_head(std::next(goto_program.instructions.begin(), 3)));
+      REQUIRE(
+        order.depth(std::next(goto_program.instructions.begin(), 3)) == 2);
+      REQUIRE(order.depth(std::prev(goto_program.instructions.end())) == 0);
+    }
+  }
+
+  GIVEN("A loop whose body is laid out after its exit")
+  {
+    // 0: SKIP
+    // 1: IF c GOTO 5
+    // 2: SKIP
+    // 3: SKIP
+    // 4: GOTO 7
+    // 5: SKIP
+    // 6: GOTO 1
+    // 7: END_FUNCTION
+    goto_program.add(goto_programt::make_skip());
+    const auto into_body = add_goto(goto_program);
+    goto_program.add(goto_programt::make_skip());
+    goto_program.add(goto_programt::make_skip());
+    const auto to_end = add_goto(goto_program, false);
+    goto_program.add(goto_programt::make_skip());
+    const auto back = add_goto(goto_program, false);
+    goto_program.add(goto_programt::make_end_function());
+    resolve_targets(goto_program, {{into_body, 5}, {to_end, 7}, {back, 1}});
+
+    THEN("The body follows the head")
+    {
+      REQUIRE(
+        output(weak_topological_ordert(goto_program)) == "0 (1 5 6) 2 3 4 7");
+    }
+  }
+
+  GIVEN("A cycle that is not a natural loop")
+  {
+    // 0: IF c GOTO 2
+    // 1: SKIP
+    // 2: SKIP
+    // 3: IF c GOTO 1
+    // 4: END_FUNCTION
+    const auto into_cycle = add_goto(goto_program);
+    goto_program.add(goto_programt::make_skip());
+    goto_program.add(goto_programt::make_skip());
+    const auto back = add_goto(goto_program);
+    goto_program.add(goto_programt::make_end_function());
+    resolve_targets(goto_program, {{into_cycle, 2}, {back, 1}});
+
+    THEN("The cycle is broken at its first instruction")
+    {
+      REQUIRE(output(weak_topological_ordert(goto_program)) == "0 1 2 3 4");
+    }
+  }
+}
+
+/// Counts the instructions on the longest path, saturating at 100
+class path_length_domaint : public ai_domain_baset
+{
+public:
+  optionalt<unsigned> path_length;
+
+  void transform(
+    const irep_idt &,
+    trace_ptrt,
+    const irep_idt &,
+    trace_ptrt,
+    ai_baset &,
+    const namespacet &) override
+  {
+    if(*path_length < 100)
+      ++*path_length;
+  }
+
+  void make_bottom() override
+  {
+    path_length = {};
+  }
+  void make_top() override
+  {
+    path_length = 100;
+  }
+  void make_entry() override
+  {
+    path_length = 0;
+  }
+  bool is_bottom() const override
+  {
+    return !path_length.has_value();
+  }
+  bool is_top() const override
+  {
+    return path_length == 100u;
+  }
+
+  bool merge(const path_length_domaint &b, locationt, locationt)
+  {
+    if(b.is_bottom() || (!is_bottom() && *path_length >= *b.path_length))
+      return false;
+
+    path_length = b.path_length;
+    return true;
+  }
+};
+
+SCENARIO(
+  "Processing the working set in weak topological order",
+  "[core][analyses][ai][weak_topological_ordert]")
+{
+  // A loop whose body is laid out after its exit, as above, so that ordering
+  // by location revisits the exit on every iteration of the loop
+  goto_programt goto_program;
+  goto_program.add(goto_programt::make_skip());
+  const auto into_body = add_goto(goto_program);
+  for(int i = 0; i < 10; ++i)
+    goto_program.add(goto_programt::make_skip());
+  const auto to_end = add_goto(goto_program, false);
+  const std::size_t body = goto_program.instructions.size();
+  goto_program.add(goto_programt::make_skip());
+  const auto back = add_goto(goto_program, false);
+  goto_program.add(goto_programt::make_end_function());
+  resolve_targets(
+    goto_program,
+    {{into_body, body}, {to_end, body + 2}, {back, 1}});
+
+  const symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  ait<path_length_domaint> by_location;
+  by_location("f", goto_program, ns);
+
+  ait<path_length_domaint> by_wto;
+  by_wto.set_worklist_order(ai_baset::worklist_ordert::WEAK_TOPOLOGICAL);
+  by_wto("f", goto_program, ns);
+
+  THEN("Both orders reach the same fixed point")
+  {
+    for(auto it = goto_program.instructions.begin();
+        it != goto_program.instructions.end();
+        ++it)
+    {
+      REQUIRE(by_location[it].path_length == by_wto[it].path_length);
+    }
+  }
+
+  THEN("The weak topological order does less work")
+  {
+    const auto &location_statistics = by_location.get_statistics();
+    const auto &wto_statistics = by_wto.get_statistics();
+    INFO(
+      "transformers: " << location_statistics.transformers << " vs "
+                       << wto_statistics.transformers);
+    INFO(
+      "merges: " << location_statistics.merges << " vs "
+                 << wto_statistics.merges);
+    REQUIRE(
+      wto_statistics.transformers * 2 < location_statistics.transformers);
+    REQUIRE(wto_statistics.merges * 2 < location_statistics.merges);
+  }
+
+  THEN("The loop head is the only widening point")
+  {
+    for(auto it = goto_program.instructions.begin();
+        it != goto_program.instructions.end();
+        ++it)
+    {
+      REQUIRE(
+        by_wto.is_widening_point(it) ==
+        (it == std::next(goto_program.instructions.begin())));
+      REQUIRE(!by_location.is_widening_point(it));
+    }
+  }
+}
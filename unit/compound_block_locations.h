@@ -8,7 +8,9 @@
 #include <util/irep.h>
 #include <util/std_expr.h>
 
+#include <list>
 #include <string>
+#include <unordered_map>
 
 class compound_block_locationst
 {
@@ -0,0 +1,181 @@
+/*******************************************************************\
+
+Module: Unit tests for writing and reading goto binaries
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/exception_utils.h>
+#include <util/message.h>
+#include <util/std_code.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
+
+#include <sstream>
+
+static goto_modelt make_goto_model(std::size_t assignments)
+{
+  goto_modelt goto_model;
+
+  const signedbv_typet int_type(32);
+
+  symbolt x;
+  x.name = "x";
+  x.base_name = "x";
+  x.mode = ID_C;
+  x.type = int_type;
+  x.is_lvalue = true;
+  x.is_static_lifetime = true;
+  goto_model.symbol_table.add(x);
+
+  symbolt main;
+  main.name = "main";
+  main.base_name = "main";
+  main.mode = ID_C;
+  main.type = code_typet({}, empty_typet());
+  goto_model.symbol_table.add(main);
+
+  goto_programt &body = goto_model.goto_functions.function_map["main"].body;
+
+  source_locationt loop_location;
+  loop_location.set_file("main.c");
+  loop_location.set_line(1);
+  const auto loop_head = body.add(goto_programt::make_skip(loop_location));
+  loop_head->labels.push_back("loop");
+
+  for(std::size_t i = 0; i < assignments; ++i)
+  {
+    source_locationt location;
+    location.set_file("main.c");
+    location.set_line(i + 2);
+    location.set_comment("assignment " + std::to_string(i));
+    body.add(goto_programt::make_assignment(
+      x.symbol_expr(), from_integer(i, int_type), location));
+  }
+
+  body.add(goto_programt::make_goto(
+    loop_head,
+    binary_relation_exprt(x.symbol_expr(), ID_lt, from_integer(0, int_type)),
+    loop_location));
+  body.add(goto_programt::make_end_function());
+  body.update();
+
+  return goto_model;
+}
+
+static void require_same_goto_model(const goto_modelt &a, const goto_modelt &b)
+{
+  REQUIRE(a.symbol_table.symbols.size() == b.symbol_table.symbols.size());
+  for(const auto &symbol_pair : a.symbol_table.symbols)
+  {
+    const symbolt *other = b.symbol_table.lookup(symbol_pair.first);
+    REQUIRE(other != nullptr);
+    REQUIRE(symbol_pair.second.type.full_eq(other->type));
+    REQUIRE(symbol_pair.second.value.full_eq(other->value));
+    REQUIRE(symbol_pair.second.base_name == other->base_name);
+    REQUIRE(symbol_pair.second.mode == other->mode);
+    REQUIRE(symbol_pair.second.is_lvalue == other->is_lvalue);
+    REQUIRE(
+      symbol_pair.second.is_static_lifetime == other->is_static_lifetime);
+  }
+
+  const goto_programt &body_a =
+    a.goto_functions.function_map.at("main").body;
+  const goto_programt &body_b =
+    b.goto_functions.function_map.at("main").body;
+  REQUIRE(body_a.instructions.size() == body_b.instructions.size());
+
+  auto it_b = body_b.instructions.begin();
+  for(const auto &instruction : body_a.instructions)
+  {
+    REQUIRE(instruction.type == it_b->type);
+    REQUIRE(instruction.code.full_eq(it_b->code));
+    REQUIRE(instruction.guard.full_eq(it_b->guard));
+    REQUIRE(instruction.source_location.full_eq(it_b->source_location));
+    REQUIRE(instruction.labels == it_b->labels);
+    REQUIRE(instruction.targets.size() == it_b->targets.size());
+    if(!instruction.targets.empty())
+    {
+      REQUIRE(
+        instruction.get_target()->target_number ==
+        it_b->get_target()->target_number);
+    }
+    ++it_b;
+  }
+}
+
+static goto_modelt read_goto_model(std::istream &in)
+{
+  goto_modelt goto_model;
+  null_message_handlert message_handler;
+  REQUIRE_FALSE(read_bin_goto_object(
+    in,
+    "test.gb",
+    goto_model.symbol_table,
+    goto_model.goto_functions,
+    message_handler));
+  return goto_model;
+}
+
+TEST_CASE(
+  "Writing and reading goto binaries",
+  "[core][goto-programs][write_goto_binary]")
+{
+  const goto_modelt goto_model = make_goto_model(200);
+
+  std::ostringstream uncompressed;
+  REQUIRE_FALSE(
+    write_goto_binary(uncompressed, goto_model, GOTO_BINARY_VERSION));
+
+  std::ostringstream compressed;
+  REQUIRE_FALSE(write_goto_binary(
+    compressed, goto_model, GOTO_BINARY_COMPRESSED_VERSION));
+
+  SECTION("The uncompressed format round-trips")
+  {
+    std::istringstream in(uncompressed.str());
+    require_same_goto_model(goto_model, read_goto_model(in));
+  }
+
+  SECTION("The compressed format round-trips")
+  {
+    std::istringstream in(compressed.str());
+    require_same_goto_model(goto_model, read_goto_model(in));
+  }
+
+  SECTION("The compressed format is smaller")
+  {
+    REQUIRE(compressed.str().size() < uncompressed.str().size() / 2);
+  }
+
+  SECTION("Truncated compressed input is rejected")
+  {
+    const std::string data = compressed.str();
+    std::istringstream in(data.substr(0, data.size() / 2));
+    goto_modelt goto_model_read;
+    null_message_handlert message_handler;
+    REQUIRE_THROWS_AS(
+      read_bin_goto_object(
+        in,
+        "test.gb",
+        goto_model_read.symbol_table,
+        goto_model_read.goto_functions,
+        message_handler),
+      deserialization_exceptiont);
+  }
+
+  SECTION("Unknown versions are rejected")
+  {
+    std::ostringstream out;
+    REQUIRE_THROWS_AS(
+      write_goto_binary(out, goto_model, GOTO_BINARY_COMPRESSED_VERSION + 1),
+      invalid_command_line_argument_exceptiont);
+  }
+}
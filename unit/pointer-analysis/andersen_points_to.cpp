@@ -0,0 +1,121 @@
+/*******************************************************************\
+
+Module: Unit tests for andersen_points_tot
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for andersen_points_tot
+
+#include <testing-utils/use_catch.h>
+
+#include <pointer-analysis/andersen_points_to.h>
+
+#include <util/namespace.h>
+#include <util/pointer_expr.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+
+static std::set<exprt> objects(const std::vector<exprt> &values)
+{
+  std::set<exprt> result;
+  for(const auto &value : values)
+    result.insert(to_object_descriptor_expr(value).object());
+  return result;
+}
+
+SCENARIO(
+  "Inclusion-based points-to analysis",
+  "[core][pointer-analysis][andersen_points_to]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  code_typet f_type({code_typet::parametert(empty_typet())}, empty_typet());
+  f_type.parameters().front().set_identifier("f::p");
+  const pointer_typet fp_type(f_type, 64);
+  const struct_typet s_type({{"a", fp_type}, {"b", fp_type}});
+
+  const symbol_exprt f("f", f_type);
+  const symbol_exprt g("g", f_type);
+  const symbol_exprt p("f::p", fp_type);
+  const symbol_exprt fp("fp", fp_type);
+  const symbol_exprt q("q", pointer_typet(fp_type, 64));
+  const symbol_exprt r("r", fp_type);
+  const symbol_exprt s("s", s_type);
+  const symbol_exprt x("x", fp_type);
+  const symbol_exprt y("y", fp_type);
+
+  symbolt p_symbol;
+  p_symbol.name = p.get_identifier();
+  p_symbol.type = p.type();
+  symbol_table.add(p_symbol);
+
+  const address_of_exprt address_of_f(f, fp_type);
+  const address_of_exprt address_of_g(g, fp_type);
+
+  // main() {
+  //   fp = &f; q = &fp; r = *q;
+  //   s.a = &f; s.b = &g;
+  //   x = y; y = x; x = &g;
+  //   (*r)(&g);
+  // }
+  goto_functionst goto_functions;
+  goto_programt &main = goto_functions.function_map["main"].body;
+  main.add(goto_programt::make_assignment(fp, address_of_f));
+  main.add(goto_programt::make_assignment(
+    q, address_of_exprt(fp, to_pointer_type(q.type()))));
+  main.add(goto_programt::make_assignment(r, dereference_exprt(q)));
+  main.add(goto_programt::make_assignment(
+    member_exprt(s, "a", fp_type), address_of_f));
+  main.add(goto_programt::make_assignment(
+    member_exprt(s, "b", fp_type), address_of_g));
+  main.add(goto_programt::make_assignment(x, y));
+  main.add(goto_programt::make_assignment(y, x));
+  main.add(goto_programt::make_assignment(x, address_of_g));
+  const auto call = main.add(goto_programt::make_function_call(
+    code_function_callt(dereference_exprt(r), {address_of_g})));
+  main.add(goto_programt::make_end_function());
+
+  goto_functiont &f_function = goto_functions.function_map["f"];
+  f_function.parameter_identifiers.push_back(p.get_identifier());
+  f_function.body.add(goto_programt::make_end_function());
+  goto_functions.update();
+
+  andersen_points_tot points_to(ns);
+  points_to(goto_functions);
+
+  THEN("Values flow through loads and stores")
+  {
+    REQUIRE(
+      objects(points_to.get_values("main", call, r)) == std::set<exprt>{f});
+    REQUIRE(
+      objects(points_to.get_values("main", call, dereference_exprt(q))) ==
+      std::set<exprt>{f});
+  }
+
+  THEN("Struct members are distinct locations")
+  {
+    REQUIRE(
+      objects(points_to.get_values(
+        "main", call, member_exprt(s, "a", fp_type))) == std::set<exprt>{f});
+    REQUIRE(
+      objects(points_to.get_values(
+        "main", call, member_exprt(s, "b", fp_type))) == std::set<exprt>{g});
+  }
+
+  THEN("Variables on a cycle are merged")
+  {
+    REQUIRE(
+      objects(points_to.get_values("main", call, y)) == std::set<exprt>{g});
+    REQUIRE(points_to.get_statistics().collapsed == 1);
+  }
+
+  THEN("Calls through function pointers are resolved while solving")
+  {
+    REQUIRE(
+      objects(points_to.get_values("f", call, p)) == std::set<exprt>{g});
+  }
+}
@@ -0,0 +1,136 @@
+/*******************************************************************\
+
+Module: Unit tests for value_set_object_mapt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for value_set_object_mapt
+
+#include <testing-utils/use_catch.h>
+
+#include <pointer-analysis/value_set_object_map.h>
+
+#include <map>
+#include <random>
+
+typedef std::map<std::size_t, value_set_object_mapt::mapped_type> referencet;
+
+static referencet to_reference(const value_set_object_mapt &map)
+{
+  referencet result;
+  for(const auto &element : map)
+    result.emplace(element.first, element.second);
+  return result;
+}
+
+/// What value_sett::make_union did with a std::map
+static bool make_union(referencet &dest, const referencet &src)
+{
+  bool changed = false;
+  for(const auto &element : src)
+  {
+    const auto entry = dest.find(element.first);
+    if(entry == dest.end())
+    {
+      dest.insert(element);
+      changed = true;
+    }
+    else if(entry->second.has_value() && entry->second != element.second)
+    {
+      entry->second.reset();
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+SCENARIO(
+  "value_set_object_mapt behaves like an ordered map",
+  "[core][pointer-analysis][value_set_object_map]")
+{
+  GIVEN("A map with fewer keys than fit inline")
+  {
+    value_set_object_mapt map;
+    map.set(5, mp_integer(0));
+    map.set(3, {});
+    map.set(5, mp_integer(4));
+
+    THEN("Keys are iterated in order with their offsets")
+    {
+      REQUIRE(map.size() == 2);
+      REQUIRE(
+        to_reference(map) == referencet{{3, {}}, {5, mp_integer(4)}});
+      REQUIRE(map.find(5)->second == mp_integer(4));
+      REQUIRE(map.find(4) == map.end());
+    }
+  }
+
+  GIVEN("A map with keys far apart")
+  {
+    value_set_object_mapt map;
+    for(std::size_t key = 0; key < 1000000; key += 1000)
+      map.set(key, mp_integer(key % 3));
+
+    THEN("All keys are found")
+    {
+      REQUIRE(map.size() == 1000);
+      REQUIRE(map.contains(999000));
+      REQUIRE(!map.contains(999001));
+      REQUIRE(map.find(500000)->second == mp_integer(2));
+      REQUIRE(std::next(map.find(500000))->first == 501000);
+    }
+
+    THEN("Erasing keeps the others")
+    {
+      REQUIRE(map.erase(500000) == 1);
+      REQUIRE(map.erase(500000) == 0);
+      REQUIRE(map.size() == 999);
+      REQUIRE(std::next(map.find(499000))->first == 501000);
+    }
+  }
+
+  GIVEN("Random sequences of operations")
+  {
+    std::mt19937 random(42);
+
+    auto random_map = [&](std::size_t max_size, std::size_t max_key) {
+      value_set_object_mapt result;
+      const std::size_t size = random() % max_size;
+      for(std::size_t i = 0; i < size; ++i)
+      {
+        const std::size_t key = random() % max_key;
+        if(random() % 2 == 0)
+          result.set(key, {});
+        else
+          result.set(key, mp_integer(random() % 3));
+      }
+      return result;
+    };
+
+    THEN("Unions agree with those on std::map")
+    {
+      for(std::size_t i = 0; i < 1000; ++i)
+      {
+        const std::size_t max_key = i % 2 == 0 ? 64 : 5000;
+        value_set_object_mapt dest = random_map(40, max_key);
+        const value_set_object_mapt src = random_map(40, max_key);
+
+        referencet expected = to_reference(dest);
+        const bool expected_change = make_union(expected, to_reference(src));
+
+        REQUIRE(dest.includes(src) == !expected_change);
+        REQUIRE(dest.make_union(src) == expected_change);
+        REQUIRE(to_reference(dest) == expected);
+        REQUIRE(dest.size() == expected.size());
+        REQUIRE(dest.includes(src));
+
+        value_set_object_mapt copy;
+        copy.insert(dest.begin(), dest.end());
+        REQUIRE(copy == dest);
+      }
+    }
+  }
+}
@@ -0,0 +1,126 @@
+/*******************************************************************\
+
+ Module: Unit tests for bv_pointerst
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <solvers/flattening/bv_pointers.h>
+#include <solvers/sat/cnf_clause_list.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/cmdline.h>
+#include <util/config.h>
+#include <util/namespace.h>
+#include <util/pointer_expr.h>
+#include <util/pointer_predicates.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+/// Records the clauses only, the encoding is never solved
+class clause_countt : public cnf_clause_listt
+{
+public:
+  clause_countt() : cnf_clause_listt(null_message_handler)
+  {
+  }
+
+  void set_assignment(literalt, bool) override
+  {
+  }
+
+  bool is_in_conflict(literalt) const override
+  {
+    return false;
+  }
+};
+
+class bv_pointers_testt : public bv_pointerst
+{
+public:
+  bv_pointers_testt(const namespacet &_ns, propt &_prop)
+    : bv_pointerst(_ns, _prop, null_message_handler)
+  {
+  }
+
+  std::size_t number_of_object_equalities() const
+  {
+    return object_equalities.size();
+  }
+};
+
+/// Flatten a pointer that may point to any of \p objects arrays, and
+/// \p checks guarded is_dynamic_object, object_size and is_invalid_pointer
+/// checks on offsets of it
+static void add_pointer_checks(
+  bv_pointerst &solver,
+  std::size_t objects,
+  std::size_t checks)
+{
+  const typet int_type = signed_int_type();
+  const pointer_typet pointer = pointer_type(int_type);
+  const array_typet array_type(int_type, from_integer(16, size_type()));
+
+  exprt target = typecast_exprt(
+    address_of_exprt(symbol_exprt("o0", array_type)), pointer);
+  for(std::size_t o = 1; o < objects; ++o)
+  {
+    target = if_exprt(
+      symbol_exprt("c" + std::to_string(o), bool_typet()),
+      typecast_exprt(
+        address_of_exprt(symbol_exprt("o" + std::to_string(o), array_type)),
+        pointer),
+      target);
+  }
+  const symbol_exprt p("p", pointer);
+  solver.set_to_true(equal_exprt(p, target));
+
+  for(std::size_t j = 0; j < checks; ++j)
+  {
+    const plus_exprt q(p, from_integer(j, signed_int_type()));
+    solver.set_to_true(implies_exprt(
+      symbol_exprt("g" + std::to_string(j), bool_typet()),
+      and_exprt(
+        not_exprt(is_dynamic_object_exprt(q)),
+        binary_relation_exprt(
+          object_size(q), ID_ge, from_integer(4 * (j + 1), size_type())),
+        not_exprt(is_invalid_pointer_exprt(q)))));
+  }
+
+  solver.post_process();
+}
+
+SCENARIO(
+  "bv_pointers_object_equal",
+  "[core][solvers][flattening][bv_pointers]")
+{
+  cmdlinet cmdline;
+  config.set(cmdline);
+
+  const symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  GIVEN("Several checks of the objects a pointer may point to")
+  {
+    clause_countt one_check_cnf;
+    bv_pointers_testt one_check(ns, one_check_cnf);
+    add_pointer_checks(one_check, 8, 1);
+
+    clause_countt many_checks_cnf;
+    bv_pointers_testt many_checks(ns, many_checks_cnf);
+    add_pointer_checks(many_checks, 8, 4);
+
+    THEN("All checks share one comparison per object")
+    {
+      REQUIRE(one_check.number_of_object_equalities() > 0);
+      REQUIRE(
+        many_checks.number_of_object_equalities() ==
+        one_check.number_of_object_equalities());
+    }
+  }
+}
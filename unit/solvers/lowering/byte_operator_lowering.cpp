@@ -0,0 +1,151 @@
+/*******************************************************************\
+
+ Module: Unit tests for byte_operator_loweringt
+
+ Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <solvers/lowering/byte_operator_lowering.h>
+#include <solvers/lowering/expr_lowering.h>
+
+#include <util/arith_tools.h>
+#include <util/byte_operators.h>
+#include <util/c_types.h>
+#include <util/cmdline.h>
+#include <util/config.h>
+#include <util/expr_util.h>
+#include <util/find_symbols.h>
+#include <util/namespace.h>
+#include <util/replace_symbol.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+#include <sstream>
+
+SCENARIO(
+  "byte_operator_lowering",
+  "[core][solvers][lowering][byte_operator_lowering]")
+{
+  cmdlinet cmdline;
+  config.set(cmdline);
+
+  const symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  const array_typet array_type(
+    unsignedbv_typet(8), from_integer(8, size_type()));
+  const symbol_exprt a("a", array_type);
+  const symbol_exprt b("b", array_type);
+
+  GIVEN("Byte extracts of the same shape from different symbols")
+  {
+    const byte_extract_exprt extract_a(
+      ID_byte_extract_little_endian,
+      a,
+      from_integer(2, index_type()),
+      unsignedbv_typet(32));
+    byte_extract_exprt extract_b = extract_a;
+    extract_b.op() = b;
+
+    byte_operator_loweringt lowering(ns);
+    const exprt lowered_a = lowering(extract_a);
+    const exprt lowered_b = lowering(extract_b);
+
+    THEN("The lowerings are those of lower_byte_extract")
+    {
+      REQUIRE(lowered_a == lower_byte_extract(extract_a, ns));
+      REQUIRE(lowered_b == lower_byte_extract(extract_b, ns));
+      REQUIRE(!has_subexpr(lowered_b, ID_byte_extract_little_endian));
+
+      const auto symbols = find_symbol_identifiers(lowered_b);
+      REQUIRE(symbols.size() == 1);
+      REQUIRE(symbols.count("b") == 1);
+    }
+
+    THEN("The second one is instantiated from the first")
+    {
+      std::ostringstream statistics;
+      lowering.output_statistics(statistics);
+      REQUIRE(
+        statistics.str().find("Byte operator lowerings: 2, 1 from the cache") ==
+        0);
+    }
+  }
+
+  GIVEN("Byte extracts of unbounded arrays from different symbols")
+  {
+    const array_typet unbounded_type(
+      unsignedbv_typet(8), exprt(ID_infinity, size_type()));
+    const symbol_exprt c("c", unbounded_type);
+    const symbol_exprt d("d", unbounded_type);
+
+    const byte_extract_exprt extract_c(
+      ID_byte_extract_little_endian,
+      c,
+      from_integer(1, index_type()),
+      array_typet(unsignedbv_typet(16), exprt(ID_infinity, size_type())));
+    byte_extract_exprt extract_d = extract_c;
+    extract_d.op() = d;
+
+    byte_operator_loweringt lowering(ns);
+    const exprt lowered_c = lowering(extract_c);
+    const exprt lowered_d = lowering(extract_d);
+
+    THEN("Each instance has a bound variable of its own")
+    {
+      REQUIRE(lowered_c.id() == ID_array_comprehension);
+      REQUIRE(lowered_d.id() == ID_array_comprehension);
+
+      const symbol_exprt &arg_c = to_array_comprehension_expr(lowered_c).arg();
+      const symbol_exprt &arg_d = to_array_comprehension_expr(lowered_d).arg();
+      REQUIRE(arg_c != arg_d);
+
+      const auto symbols = find_symbol_identifiers(lowered_d);
+      REQUIRE(symbols.size() == 2);
+      REQUIRE(symbols.count("d") == 1);
+      REQUIRE(symbols.count(arg_d.get_identifier()) == 1);
+    }
+
+    THEN("The instance is the lowering up to the name of the bound variable")
+    {
+      array_comprehension_exprt expected =
+        to_array_comprehension_expr(lower_byte_extract(extract_d, ns));
+      replace_symbolt rename;
+      rename.insert(
+        expected.arg(), to_array_comprehension_expr(lowered_d).arg());
+      rename(expected.body());
+      expected.arg() = to_array_comprehension_expr(lowered_d).arg();
+
+      REQUIRE(lowered_d == expected);
+    }
+  }
+
+  GIVEN("Byte updates at different offsets")
+  {
+    const byte_update_exprt update_a(
+      ID_byte_update_big_endian,
+      a,
+      from_integer(1, index_type()),
+      from_integer(42, unsignedbv_typet(16)));
+    byte_update_exprt update_b = update_a;
+    update_b.set_op(b);
+    update_b.set_offset(from_integer(3, index_type()));
+
+    byte_operator_loweringt lowering(ns);
+
+    THEN("Each has a lowering of its own")
+    {
+      REQUIRE(lowering(update_a) == lower_byte_update(update_a, ns));
+      REQUIRE(lowering(update_b) == lower_byte_update(update_b, ns));
+
+      std::ostringstream statistics;
+      lowering.output_statistics(statistics);
+      REQUIRE(
+        statistics.str().find("Byte operator lowerings: 2, 0 from the cache") ==
+        0);
+    }
+  }
+}
@@ -5,6 +5,10 @@
 #include <testing-utils/use_catch.h>
 #include <util/irep.h>
 
+#include <chrono>
+#include <iostream>
+#include <unordered_map>
+
 SCENARIO("irept_memory", "[core][utils][irept]")
 {
   GIVEN("Always")
@@ -300,5 +304,134 @@ SCENARIO("irept_memory", "[core][utils][irept]")
       REQUIRE(irep1 == irep2);
       REQUIRE(!irep1.full_eq(irep2));
     }
+
+    THEN("Comparison of unshared ireps works once hashed")
+    {
+      irep1 = irept("id", {{"#a_comment", irept("1")}}, {irept("op")});
+      irep2 = irept("id", {{"#a_comment", irept("2")}}, {irept("op")});
+
+      REQUIRE(irep1.hash() == irep2.hash());
+      REQUIRE(irep1 == irep2);
+      REQUIRE(!irep1.full_eq(irep2));
+
+      irep2.get_sub().push_back(irept("another_op"));
+      REQUIRE(irep1.hash() != irep2.hash());
+      REQUIRE(irep1 != irep2);
+      REQUIRE(!irep1.full_eq(irep2));
+    }
+
+    THEN("Comparison of partially shared children works")
+    {
+      const irept shared("shared");
+      irep1 = irept("id", {}, {shared, irept("op"), shared});
+      irep2 = irept("id", {}, {shared, irept("op"), shared});
+      REQUIRE(irep1 == irep2);
+      REQUIRE(irep1.full_eq(irep2));
+
+      irep2.get_sub()[1].id("other_op");
+      REQUIRE(irep1 != irep2);
+      REQUIRE(!irep1.full_eq(irep2));
+    }
+  }
+}
+
+/// Build a copy of \p irep that shares no nodes with it
+static irept unshared_copy(const irept &irep)
+{
+  irept::subt sub;
+  for(const auto &op : irep.get_sub())
+    sub.push_back(unshared_copy(op));
+
+  irept::named_subt named_sub;
+  for(const auto &entry : irep.get_named_sub())
+    named_sub[entry.first] = unshared_copy(entry.second);
+
+  return irept(irep.id(), named_sub, sub);
+}
+
+TEST_CASE("irept hashing and comparison benchmark", "[.][benchmark][irept]")
+{
+  // expressions of the shape of guarded SSA assignments, as found in the
+  // solver's cache of converted expressions: many are alike, differing only
+  // in a leaf deep down
+  std::vector<irept> exprs;
+  irept type("signedbv");
+  type.set("width", 32);
+  for(std::size_t i = 0; i < 200000; ++i)
+  {
+    irept symbol("symbol");
+    symbol.set("identifier", "x!0@1#" + std::to_string(i % 1000));
+    symbol.set("type", type);
+
+    irept sum("+");
+    sum.set("type", type);
+    sum.get_sub() = {symbol, irept("constant")};
+
+    irept expr("if");
+    expr.set("#source_location", i);
+    expr.get_sub() = {
+      irept("=", {}, {sum, symbol}),
+      sum,
+      irept("symbol_" + std::to_string(i / 1000))};
+    exprs.push_back(expr);
+  }
+
+  std::vector<irept> lookups;
+  std::vector<irept> modified;
+  for(const auto &expr : exprs)
+  {
+    lookups.push_back(unshared_copy(expr));
+    // shares all but the path to the modified leaf
+    modified.push_back(expr);
+    modified.back().get_sub()[2].id("other_symbol");
+  }
+
+  using millisecondst = std::chrono::milliseconds;
+  auto start = std::chrono::steady_clock::now();
+  auto elapsed = [&start]() {
+    const auto now = std::chrono::steady_clock::now();
+    const auto result =
+      std::chrono::duration_cast<millisecondst>(now - start).count();
+    start = now;
+    return result;
+  };
+
+  std::unordered_map<irept, std::size_t, irep_hash> map;
+  for(std::size_t i = 0; i < exprs.size(); ++i)
+    map.emplace(exprs[i], i);
+
+  std::size_t found = 0;
+  for(const auto &expr : lookups)
+    found += map.count(expr);
+  REQUIRE(found == lookups.size());
+  std::cout << "irep_hash map of " << map.size() << " entries, "
+            << lookups.size() << " unshared lookups: " << elapsed() << "ms\n";
+
+  std::size_t equal = 0;
+  for(int round = 0; round < 10; ++round)
+  {
+    for(std::size_t i = 0; i < exprs.size(); ++i)
+      equal += exprs[i] == lookups[i];
+  }
+  REQUIRE(equal == 10 * exprs.size());
+  std::cout << "comparing unshared equal ireps: " << elapsed() << "ms\n";
+
+  for(int round = 0; round < 10; ++round)
+  {
+    for(std::size_t i = 0; i < exprs.size(); ++i)
+      equal += exprs[i] == modified[i];
+  }
+  REQUIRE(equal == 10 * exprs.size());
+  std::cout << "comparing partially shared ireps: " << elapsed() << "ms\n";
+
+  for(std::size_t i = 0; i < exprs.size(); ++i)
+    modified[i].hash();
+  for(int round = 0; round < 10; ++round)
+  {
+    for(std::size_t i = 0; i < exprs.size(); ++i)
+      equal += exprs[i] == modified[i];
   }
+  REQUIRE(equal == 10 * exprs.size());
+  std::cout << "comparing partially shared, hashed ireps: " << elapsed()
+            << "ms\n";
 }
@@ -18,6 +18,8 @@ Author: Michael Tautschnig
 #include <util/pointer_expr.h>
 #include <util/pointer_predicates.h>
 #include <util/simplify_expr.h>
+#include <util/simplify_expr_cache.h>
+#include <util/simplify_expr_class.h>
 #include <util/simplify_utils.h>
 #include <util/std_expr.h>
 #include <util/symbol_table.h>
@@ -501,3 +503,86 @@ TEST_CASE("Simplifying cast expressions", "[core][util]")
     REQUIRE(simplified_expr == expr);
   }
 }
+
+TEST_CASE("Simplifying with a cache", "[core][util]")
+{
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+  const signedbv_typet int_type(32);
+  const symbol_exprt x("x", int_type);
+  const std::size_t settings = simplify_exprt(ns).cache_settings();
+
+  // (x + 1) - 1 ~> x
+  const minus_exprt changing{plus_exprt{x, from_integer(1, int_type)},
+                             from_integer(1, int_type)};
+  // x + 2 is as simple as it gets
+  const plus_exprt unchanging{x, from_integer(2, int_type)};
+
+  simplify_expr_cachet cache(100);
+
+  REQUIRE(simplify_expr(changing, ns, cache) == x);
+  REQUIRE(simplify_expr(unchanging, ns, cache) == unchanging);
+
+  // expressions without operands are not cached
+  const auto statistics = cache.get_statistics();
+  REQUIRE(statistics.hits == 0);
+  REQUIRE(statistics.misses == 3);
+  REQUIRE(statistics.size == 3);
+
+  SECTION("Repeated simplifications are looked up once")
+  {
+    REQUIRE(simplify_expr(changing, ns, cache) == x);
+    REQUIRE(cache.get_statistics().hits == statistics.hits + 1);
+    REQUIRE(cache.get_statistics().misses == statistics.misses);
+  }
+
+  SECTION("Results for subexpressions are reused")
+  {
+    const mult_exprt product{changing, from_integer(3, int_type)};
+    REQUIRE(
+      simplify_expr(product, ns, cache) ==
+      mult_exprt{x, from_integer(3, int_type)});
+    REQUIRE(cache.get_statistics().hits == statistics.hits + 1);
+    REQUIRE(cache.get_statistics().misses == statistics.misses + 1);
+  }
+
+  SECTION("Cached results carry the change status")
+  {
+    const auto cached_changing = cache.find(changing, settings);
+    REQUIRE(cached_changing.has_value());
+    REQUIRE(cached_changing->changed);
+    REQUIRE(cached_changing->expr == x);
+
+    exprt expr = unchanging;
+    simplify_exprt simplifier(ns);
+    simplifier.set_cache(cache);
+    REQUIRE(simplifier.simplify(expr));
+  }
+
+  SECTION("Expressions differing in comments only are cached separately")
+  {
+    minus_exprt located = changing;
+    located.add_source_location().set_line(42);
+    REQUIRE_FALSE(cache.find(located, settings).has_value());
+  }
+
+  SECTION("Results of differently configured simplifiers are kept apart")
+  {
+    simplify_exprt simplifier(ns);
+    simplifier.do_simplify_if = false;
+    REQUIRE(simplifier.cache_settings() != settings);
+    REQUIRE_FALSE(
+      cache.find(changing, simplifier.cache_settings()).has_value());
+  }
+
+  SECTION("Least recently used entries are evicted")
+  {
+    simplify_expr_cachet small_cache(1);
+    simplify_expr(changing, ns, small_cache);
+    simplify_expr(unchanging, ns, small_cache);
+
+    REQUIRE_FALSE(small_cache.find(changing, settings).has_value());
+    REQUIRE(small_cache.find(unchanging, settings).has_value());
+    REQUIRE(small_cache.get_statistics().evictions == 2);
+  }
+}
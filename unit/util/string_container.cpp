@@ -0,0 +1,133 @@
+/*******************************************************************\
+
+Module: Unit tests for string_containert
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/string_container.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+static std::vector<std::string> make_strings(std::size_t count)
+{
+  std::vector<std::string> result;
+  result.reserve(count);
+  for(std::size_t i = 0; i < count; ++i)
+    result.push_back("string_container_test_" + std::to_string(i));
+  return result;
+}
+
+/// Intern \p strings from \p thread_count threads, each thread starting at a
+/// different position, and return the numbers each thread obtained.
+static std::vector<std::vector<unsigned>> intern_concurrently(
+  string_containert &container,
+  const std::vector<std::string> &strings,
+  std::size_t thread_count)
+{
+  std::vector<std::vector<unsigned>> numbers(
+    thread_count, std::vector<unsigned>(strings.size()));
+  std::vector<std::thread> threads;
+
+  for(std::size_t t = 0; t < thread_count; ++t)
+  {
+    threads.emplace_back([&container, &strings, &numbers, t, thread_count]() {
+      const std::size_t start = t * strings.size() / thread_count;
+      for(std::size_t i = 0; i < strings.size(); ++i)
+      {
+        const std::size_t index = (start + i) % strings.size();
+        numbers[t][index] = container[strings[index]];
+      }
+    });
+  }
+
+  for(auto &thread : threads)
+    thread.join();
+
+  return numbers;
+}
+
+TEST_CASE("Interning strings", "[core][util][string_container]")
+{
+  string_containert container;
+
+  const unsigned empty = container[""];
+  REQUIRE(empty == 0);
+  REQUIRE(container.get_string(empty).empty());
+
+  const unsigned foo = container["foo"];
+  REQUIRE(container[std::string("foo")] == foo);
+  REQUIRE(container.get_string(foo) == "foo");
+  REQUIRE(std::string(container.c_str(foo)) == "foo");
+
+  const std::string with_nul("foo\0bar", 7);
+  const unsigned foo_nul_bar = container[with_nul];
+  REQUIRE(foo_nul_bar != foo);
+  REQUIRE(container.get_string(foo_nul_bar) == with_nul);
+
+  SECTION("References remain stable as the container grows")
+  {
+    const std::string *foo_string = &container.get_string(foo);
+    const auto strings = make_strings(100000);
+    for(const auto &s : strings)
+      container[s];
+
+    REQUIRE(&container.get_string(foo) == foo_string);
+    REQUIRE(container.compute_statistics().string_count >= strings.size());
+
+    for(const auto &s : strings)
+      REQUIRE(container.get_string(container[s]) == s);
+  }
+}
+
+TEST_CASE("Interning strings concurrently", "[core][util][string_container]")
+{
+  string_containert container;
+  const auto strings = make_strings(50000);
+  const auto numbers = intern_concurrently(container, strings, 4);
+
+  for(std::size_t i = 0; i < strings.size(); ++i)
+  {
+    REQUIRE(container.get_string(numbers[0][i]) == strings[i]);
+    for(std::size_t t = 1; t < numbers.size(); ++t)
+      REQUIRE(numbers[t][i] == numbers[0][i]);
+  }
+
+  std::vector<unsigned> sorted = numbers[0];
+  std::sort(sorted.begin(), sorted.end());
+  REQUIRE(
+    std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+}
+
+TEST_CASE(
+  "string_containert contention benchmark",
+  "[.][benchmark][util][string_container]")
+{
+  const auto strings = make_strings(1000000);
+
+  for(std::size_t thread_count : {1, 2, 4, 8})
+  {
+    string_containert container;
+
+    const auto start = std::chrono::steady_clock::now();
+    // first round inserts, second round only looks up
+    intern_concurrently(container, strings, thread_count);
+    const auto inserted = std::chrono::steady_clock::now();
+    intern_concurrently(container, strings, thread_count);
+    const auto looked_up = std::chrono::steady_clock::now();
+
+    using msecst = std::chrono::milliseconds;
+    std::cout << thread_count << " thread(s): insert "
+              << std::chrono::duration_cast<msecst>(inserted - start).count()
+              << "ms, lookup "
+              << std::chrono::duration_cast<msecst>(looked_up - inserted)
+                   .count()
+              << "ms\n";
+  }
+}